@@ -0,0 +1,83 @@
+#include "benchmark/benchmark.h"
+
+#include "gl.h"
+#include "gl/mesh.h"
+#include "gl/renderState.h"
+
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+extern size_t glMockGenBuffers;
+extern size_t glMockDeleteBuffers;
+extern size_t glMockBufferData;
+}
+
+using namespace Tangram;
+
+struct BenchVertex {
+    float x, y, z;
+    uint32_t color;
+};
+
+static std::shared_ptr<VertexLayout> benchLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+    {"a_position", 3, GL_FLOAT, false, 0},
+    {"a_color", 4, GL_UNSIGNED_BYTE, true, 0},
+}));
+
+struct BenchMesh : public Mesh<BenchVertex> {
+    using Base = Mesh<BenchVertex>;
+    using Base::Base;
+    void upload(RenderState& rs) { MeshBase::upload(rs); }
+};
+
+static const int NUM_TILES = 128;
+static const int NUM_STYLES = 10;
+static const int TILES_PER_FRAME = 8;
+
+static std::unique_ptr<BenchMesh> newBenchMesh(const MeshData<BenchVertex>& _data) {
+    auto mesh = std::make_unique<BenchMesh>(benchLayout, GL_TRIANGLES);
+    mesh->compile(_data);
+    return mesh;
+}
+
+// Simulate panning: each frame the meshes of TILES_PER_FRAME tiles are replaced by new ones
+static void BM_Tangram_MeshBufferChurn(benchmark::State& state) {
+    RenderState rs;
+    rs.bufferPool.setEnabled(state.range(0) != 0);
+
+    MeshData<BenchVertex> data;
+    data.vertices.resize(2000);
+    data.indices.resize(3000);
+    data.offsets.emplace_back(3000, 2000);
+
+    std::vector<std::unique_ptr<BenchMesh>> meshes;
+    for (int i = 0; i < NUM_TILES * NUM_STYLES; i++) {
+        meshes.push_back(newBenchMesh(data));
+        meshes.back()->upload(rs);
+    }
+    rs.flushResourceDeletion();
+
+    glMockGenBuffers = 0;
+    glMockDeleteBuffers = 0;
+    glMockBufferData = 0;
+
+    size_t next = 0, frames = 0;
+    while (state.KeepRunning()) {
+        for (int i = 0; i < TILES_PER_FRAME * NUM_STYLES; i++) {
+            meshes[next] = newBenchMesh(data);
+            meshes[next]->upload(rs);
+            next = (next + 1) % meshes.size();
+        }
+        rs.flushResourceDeletion();
+        frames++;
+    }
+
+    state.counters["genBuffers/frame"] = double(glMockGenBuffers) / frames;
+    state.counters["deleteBuffers/frame"] = double(glMockDeleteBuffers) / frames;
+    state.counters["bufferData/frame"] = double(glMockBufferData) / frames;
+    state.counters["poolBlocks"] = rs.bufferPool.stats().blocks;
+}
+BENCHMARK(BM_Tangram_MeshBufferChurn)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,48 @@
+#include "benchmark/benchmark.h"
+
+#include "data/contourSource.h"
+#include "data/tileData.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Tangram;
+
+// size x size DEM tile of rugged terrain spanning about 2000 m, as for mountains at z12 - z14
+static std::vector<float> benchDem(int _size) {
+    std::vector<float> elev(_size*_size);
+    for (int y = 0; y < _size; y++) {
+        for (int x = 0; x < _size; x++) {
+            float u = x/float(_size), v = y/float(_size);
+            elev[y*_size + x] = 1500 + 600*std::sin(5*u)*std::cos(4*v) + 250*std::sin(17*u + 11*v)
+                + 80*std::cos(41*u - 37*v);
+        }
+    }
+    return elev;
+}
+
+static void BM_Tangram_ContourTile(benchmark::State& state) {
+    int size = state.range(0);
+    float interval = state.range(1);
+    auto elev = benchDem(size);
+
+    size_t numPoints = 0, numLines = 0;
+    while (state.KeepRunning()) {
+        Layer layer("");
+        ContourSource::buildContours(elev.data(), size, size, interval, 5, 0, layer);
+        benchmark::DoNotOptimize(layer.features.data());
+        numPoints = numLines = 0;
+        for (auto& feature : layer.features) {
+            numLines += feature.lines.size();
+            for (auto& line : feature.lines) { numPoints += line.size(); }
+        }
+    }
+    state.counters["lines"] = double(numLines);
+    state.counters["points"] = double(numPoints);
+    state.SetItemsProcessed(state.iterations());
+}
+// 256 and 512 px DEM tiles at 100, 20 and 10 m intervals
+BENCHMARK(BM_Tangram_ContourTile)->Args({256, 100})->Args({256, 20})->Args({256, 10})
+    ->Args({512, 20})->Args({512, 10});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,73 @@
+#include "benchmark/benchmark.h"
+
+#include "util/elevationManager.h"
+#include "gl/texture.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Tangram;
+
+static const int NUM_POINTS = 50000;
+
+// 256x256 terrarium DEM tile and points along a winding path across it, like a route or elevation profile
+struct ElevationQueryData {
+    TileID tileId = TileID(2620, 6332, 14);
+    Texture texture = Texture(TextureOptions(), false);
+    std::vector<ProjectedMeters> meters;
+    std::vector<glm::vec2> texPos;
+
+    ElevationQueryData() {
+        std::vector<GLubyte> data(256*256*4, 255);
+        for (int i = 0; i < 256*256; i++) {
+            int v = 32768 + 1000 + int(500*std::sin(0.01f*i));
+            data[4*i] = GLubyte(v/256);
+            data[4*i+1] = GLubyte(v%256);
+            data[4*i+2] = GLubyte(i%256);
+        }
+        texture.setPixelData(256, 256, 4, data.data(), data.size());
+
+        double scale = MapProjection::metersPerTileAtZoom(tileId.z);
+        ProjectedMeters origin = MapProjection::tileSouthWestCorner(tileId);
+        for (int i = 0; i < NUM_POINTS; i++) {
+            float t = float(i)/NUM_POINTS;
+            glm::vec2 p(0.5f + 0.45f*std::sin(7*t), t);
+            texPos.push_back(p);
+            meters.push_back(origin + glm::dvec2(p)*scale);
+        }
+    }
+};
+
+static ElevationQueryData& queryData() {
+    static ElevationQueryData data;
+    return data;
+}
+
+static void BM_Tangram_ElevationScalar(benchmark::State& state) {
+    auto& data = queryData();
+    std::vector<double> elev(NUM_POINTS);
+    while (state.KeepRunning()) {
+        for (int i = 0; i < NUM_POINTS; i++) {
+            elev[i] = ElevationManager::elevationLerp(data.texture, data.tileId, data.meters[i]);
+        }
+        benchmark::DoNotOptimize(elev.data());
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_POINTS);
+}
+BENCHMARK(BM_Tangram_ElevationScalar);
+
+static void BM_Tangram_ElevationBatch(benchmark::State& state) {
+    auto& data = queryData();
+    bool withGradient = state.range(0) != 0;
+    std::vector<float> elev(NUM_POINTS);
+    std::vector<glm::vec2> grad(NUM_POINTS);
+    while (state.KeepRunning()) {
+        ElevationManager::elevationLerp(data.texture, data.texPos.data(), NUM_POINTS, elev.data(),
+                                        withGradient ? grad.data() : nullptr);
+        benchmark::DoNotOptimize(elev.data());
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_POINTS);
+}
+BENCHMARK(BM_Tangram_ElevationBatch)->Arg(0)->Arg(1);
+
+BENCHMARK_MAIN();
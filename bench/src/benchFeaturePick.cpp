@@ -0,0 +1,68 @@
+#include "benchmark/benchmark.h"
+
+#include "data/propertyItem.h"
+#include "selection/featureIndex.h"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace Tangram;
+
+static const int NUM_QUERIES = 1000;
+
+static float rnd() { return float(std::rand()) / RAND_MAX; }
+
+// Interactive features of a dense tile: buildings, roads and POIs
+static FeatureIndex buildIndex(int _numFeatures) {
+    FeatureIndex index;
+    for (int i = 0; i < _numFeatures; i++) {
+        glm::vec2 p(rnd(), rnd());
+        Feature feature;
+        switch (i % 3) {
+        case 0: {
+            feature.geometryType = GeometryType::points;
+            feature.points.push_back(p);
+        } break;
+        case 1: {
+            feature.geometryType = GeometryType::lines;
+            Line line;
+            for (int j = 0; j < 8; j++) { line.push_back(p + glm::vec2(j * .01f, rnd() * .02f)); }
+            feature.lines.push_back(line);
+        } break;
+        default: {
+            feature.geometryType = GeometryType::polygons;
+            float s = rnd() * .02f;
+            feature.polygons.push_back({{ p, p + glm::vec2(s, 0), p + glm::vec2(s, s), p + glm::vec2(0, s) }});
+        } break;
+        }
+        index.add(feature, i + 1, i % 10, 0, 2.f);
+    }
+    index.build();
+    return index;
+}
+
+// Latency of NUM_QUERIES random picks against one tile with state.range(0) interactive features
+static void BM_Tangram_FeaturePick(benchmark::State& state) {
+    std::srand(0);
+    FeatureIndex index = buildIndex(state.range(0));
+
+    std::vector<glm::vec2> queries(NUM_QUERIES);
+    for (auto& q : queries) { q = glm::vec2(rnd(), rnd()); }
+
+    // 0.5 pixel pick radius on a 256 pixel tile
+    const float tileUnitsPerPixel = 1.f / 256;
+    size_t hits = 0;
+
+    while (state.KeepRunning()) {
+        for (auto& q : queries) {
+            hits += index.pick(q, .5f * tileUnitsPerPixel, tileUnitsPerPixel) != 0;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * NUM_QUERIES);
+    state.counters["hitRate"] = double(hits) / (state.iterations() * NUM_QUERIES);
+    state.counters["indexKB"] = index.memoryUsage() / 1024;
+}
+BENCHMARK(BM_Tangram_FeaturePick)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
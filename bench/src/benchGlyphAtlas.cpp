@@ -0,0 +1,112 @@
+#include "benchmark/benchmark.h"
+
+#include "mockPlatform.h"
+#include "text/fontContext.h"
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace Tangram;
+
+static MockPlatform platform;
+
+static const int VIEW_COLS = 5, VIEW_ROWS = 4;
+static const int LABELS_PER_TILE = 60;
+static const int PAN_STEPS = 200;
+
+// The bench font has no CJK, so Latin, Greek and Cyrillic ranges stand in for a glyph-rich script; each
+//  tile column draws from a different range as when panning between CJK and Latin regions, so the set of
+//  glyphs in view keeps changing and filled glyph textures must be reused or the atlas rebuilt.
+static const unsigned int scriptRanges[][2] = {
+    {0x0021, 0x007F}, {0x0100, 0x0180}, {0x0180, 0x0250}, {0x0391, 0x03CA}, {0x0400, 0x0480},
+    {0x0490, 0x0530}, {0x1E00, 0x1F00}, {0x1F00, 0x1FFF},
+};
+
+static std::string utf8(unsigned int cp) {
+    std::string s;
+    if (cp < 0x80) {
+        s += char(cp);
+    } else if (cp < 0x800) {
+        s += char(0xC0 | (cp >> 6));
+        s += char(0x80 | (cp & 0x3F));
+    } else {
+        s += char(0xE0 | (cp >> 12));
+        s += char(0x80 | ((cp >> 6) & 0x3F));
+        s += char(0x80 | (cp & 0x3F));
+    }
+    return s;
+}
+
+struct BenchTile {
+    int col;
+    std::bitset<FontContext::max_textures> refs;
+};
+
+// lay out all labels of a tile, accumulating texture refs as TextStyleBuilder does
+static void buildTile(FontContext& _ctx, TextStyle::Parameters& _params, BenchTile& _tile, int _row) {
+    const auto& range = scriptRanges[unsigned(_tile.col) % (sizeof(scriptRanges)/sizeof(scriptRanges[0]))];
+    unsigned int span = range[1] - range[0];
+    std::vector<GlyphQuad> quads;
+    glm::vec2 bbox;
+    TextRange textRanges;
+    for (int ii = 0; ii < LABELS_PER_TILE; ii++) {
+        std::string text;
+        for (int jj = 0; jj < 8; jj++) {
+            text += utf8(range[0] + (unsigned(_tile.col*7919 + _row*LABELS_PER_TILE + ii*13 + jj*31) % span));
+        }
+        quads.clear();
+        _ctx.layoutText(_params, text, quads, _tile.refs, bbox, textRanges);
+    }
+}
+
+// Pan right one tile column at a time, building the new column and releasing the column that scrolled
+//  out of view; a rebuild is counted whenever Map::render() would clear the glyph atlas and all tiles
+static void BM_Tangram_GlyphAtlasPan(benchmark::State& state) {
+    int rebuilds = 0;
+    size_t textures = 0;
+    double tileMs = 0;
+    while (state.KeepRunning()) {
+        FontContext ctx(platform);
+        ctx.loadFonts(platform.systemFontFallbacksHandle());
+        TextStyle::Parameters params;
+        params.font = ctx.getFont("default", "regular", "400", 16);
+        params.wordWrap = false;
+
+        std::deque<BenchTile> tiles;
+        rebuilds = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (int col = 0; col < PAN_STEPS + VIEW_COLS; col++) {
+            if (col >= VIEW_COLS) {
+                for (int row = 0; row < VIEW_ROWS; row++) {
+                    ctx.releaseAtlas(tiles.front().refs);
+                    tiles.pop_front();
+                }
+            }
+            for (int row = 0; row < VIEW_ROWS; row++) {
+                tiles.push_back({col, {}});
+                buildTile(ctx, params, tiles.back(), row);
+            }
+            if (ctx.glyphTextureCount() > FontContext::max_textures - 2) {
+                rebuilds++;
+                ctx.releaseFonts();
+                for (size_t ii = 0; ii < tiles.size(); ii++) {
+                    tiles[ii].refs.reset();
+                    buildTile(ctx, params, tiles[ii], ii % VIEW_ROWS);
+                }
+            }
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        tileMs = std::chrono::duration<double, std::milli>(t1 - t0).count()/((PAN_STEPS + VIEW_COLS)*VIEW_ROWS);
+        textures = ctx.glyphTextureCount();
+    }
+    // with reuse of unreferenced glyph textures, rebuilds should stay at 0 and textures near the number
+    //  needed for the tiles in view
+    state.counters["rebuilds"] = rebuilds;
+    state.counters["textures"] = double(textures);
+    state.counters["tile_ms"] = tileMs;
+}
+BENCHMARK(BM_Tangram_GlyphAtlasPan)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,82 @@
+#include "benchmark/benchmark.h"
+
+#include "gl/pixelBufferPool.h"
+#include "gl/texture.h"
+
+#include "miniz.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using namespace Tangram;
+
+// size x size terrarium encoded DEM, which compresses about like real elevation tiles
+static std::vector<uint8_t> benchPng(int _size) {
+    std::vector<uint8_t> rgba(_size*_size*4, 255);
+    for (int y = 0; y < _size; y++) {
+        for (int x = 0; x < _size; x++) {
+            float elev = 1500 + 600*std::sin(5.0f*x/_size)*std::cos(4.0f*y/_size) + 80*std::cos(0.3f*(x - y));
+            float v = elev + 32768;
+            uint8_t* p = &rgba[4*(y*_size + x)];
+            p[0] = uint8_t(int(v)/256);
+            p[1] = uint8_t(int(v)%256);
+            p[2] = uint8_t((v - int(v))*256);
+        }
+    }
+    size_t len = 0;
+    void* png = tdefl_write_image_to_png_file_in_memory(rgba.data(), _size, _size, 4, &len);
+    std::vector<uint8_t> result((uint8_t*)png, (uint8_t*)png + len);
+    mz_free(png);
+    return result;
+}
+
+// minimal uncompressed single strip TIFF of int16 elevation, converted to float on decode
+static std::vector<uint8_t> benchTiff(int _size) {
+    std::vector<uint8_t> tiff;
+    auto put16 = [&](uint16_t v) { tiff.push_back(v & 0xFF); tiff.push_back(v >> 8); };
+    auto put32 = [&](uint32_t v) { put16(v & 0xFFFF); put16(v >> 16); };
+    const uint32_t size = _size, dataOffset = 148;
+    tiff.insert(tiff.end(), {'I', 'I', 42, 0});
+    put32(8);
+    // tag, type (3 = short, 4 = long), value
+    const uint32_t entries[][3] = { {256, 4, size}, {257, 4, size}, {258, 3, 16}, {259, 3, 1}, {262, 3, 1},
+        {273, 4, dataOffset}, {277, 3, 1}, {278, 4, size}, {279, 4, size*size*2}, {284, 3, 1}, {339, 3, 2} };
+    put16(11);
+    for (auto& e : entries) { put16(e[0]); put16(e[1]); put32(1); put32(e[2]); }
+    put32(0);
+    tiff.resize(dataOffset);
+    for (uint32_t i = 0; i < size*size; i++) { put16(uint16_t(int16_t(1500 + int(600*std::sin(0.01f*i))))); }
+    return tiff;
+}
+
+static void runDecode(benchmark::State& state, const std::vector<uint8_t>& _data) {
+    // pool disabled for comparison with plain allocation
+    bool pooled = state.range(1) != 0;
+    PixelBufferPool::shared().setMaxBytes(pooled ? PixelBufferPool::DEFAULT_MAX_BYTES : 0);
+
+    size_t decodedBytes = 0;
+    while (state.KeepRunning()) {
+        Texture texture(TextureOptions(), false);
+        if (!texture.loadImageFromMemory(_data.data(), _data.size())) {
+            state.SkipWithError("decode failed");
+            break;
+        }
+        decodedBytes = texture.bufferSize();
+        benchmark::DoNotOptimize(texture.bufferData());
+    }
+    state.SetBytesProcessed(state.iterations() * decodedBytes);
+    PixelBufferPool::shared().setMaxBytes(PixelBufferPool::DEFAULT_MAX_BYTES);
+}
+
+static void BM_Tangram_DecodePng(benchmark::State& state) {
+    runDecode(state, benchPng(state.range(0)));
+}
+BENCHMARK(BM_Tangram_DecodePng)->Args({256, 0})->Args({256, 1})->Args({512, 0})->Args({512, 1});
+
+static void BM_Tangram_DecodeTiffInt16(benchmark::State& state) {
+    runDecode(state, benchTiff(state.range(0)));
+}
+BENCHMARK(BM_Tangram_DecodeTiffInt16)->Args({256, 0})->Args({256, 1})->Args({512, 0})->Args({512, 1});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,110 @@
+#include "benchmark/benchmark.h"
+
+#include "data/tileSource.h"
+#include "labels/labelManager.h"
+#include "log.h"
+#include "marker/marker.h"
+#include "mockPlatform.h"
+#include "scene/scene.h"
+#include "style/style.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileTask.h"
+#include "view/view.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace Tangram;
+
+const char scene_file[] = "res/scene.yaml";
+const char tile_file[] = "res/tile.mvt";
+
+static MockPlatform platform;
+static std::shared_ptr<Scene> scene;
+static std::vector<std::shared_ptr<Tile>> tiles;
+
+// 3x3 tiles around the benchmark tile, all built from the same data, for a few thousand labels
+static void globalSetup() {
+    if (scene) { return; }
+
+    SceneOptions sceneOptions{platform.resolveUrl(Url(scene_file))};
+    sceneOptions.numTileWorkers = 0;
+    sceneOptions.prefetchTiles = false;
+
+    scene = std::make_shared<Scene>(platform, std::move(sceneOptions));
+    if (!scene->load()) { exit(-1); }
+
+    std::shared_ptr<TileSource> source;
+    for (auto& s : scene->tileSources()) {
+        source = s;
+        if (source->generateGeometry()) { break; }
+    }
+
+    auto task = source->createTask({301, 384, 10});
+    auto& t = dynamic_cast<BinaryTileTask&>(*task);
+    t.rawTileData = std::make_shared<std::vector<char>>(MockPlatform::getBytesFromFile(tile_file));
+    auto tileData = source->parse(*task);
+    if (!tileData) {
+        LOGE("Invalid tile file '%s'", tile_file);
+        exit(-1);
+    }
+
+    TileBuilder builder(*scene);
+    builder.init();
+    for (int y = 383; y <= 385; y++) {
+        for (int x = 300; x <= 302; x++) {
+            auto tile = std::make_shared<Tile>(TileID(x, y, 10), source->id(), source->generation());
+            builder.build(*tile, *tileData, *source);
+            tiles.push_back(tile);
+        }
+    }
+}
+
+// Main thread time of label updates for a replayed pan; state.range(0) enables async placement. With async
+//  placement, collision runs while the frame renders, so waiting for it is not counted here.
+static void BM_Tangram_LabelPlacementPan(benchmark::State& state) {
+    globalSetup();
+
+    auto* labelManager = scene->labelManager();
+    labelManager->setAsyncPlacement(state.range(0) != 0);
+
+    View view(1024, 768);
+    view.setZoom(10.5f);
+    const Tile& center = *tiles[4];
+    glm::dvec2 centerPos = center.getOrigin() + glm::dvec2(center.getScale() / 2);
+    view.setPosition(centerPos);
+
+    std::vector<std::unique_ptr<Marker>> markers;
+    std::vector<double> frameMs;
+    // pan about 4 pixels per frame along a circle
+    double radius = center.getScale() / 2, step = 4 * center.getScale() / 256 / radius;
+    int frame = 0;
+
+    while (state.KeepRunning()) {
+        double angle = step * frame++;
+        view.setPosition(centerPos + radius * glm::dvec2(std::cos(angle), std::sin(angle)));
+        view.update();
+        for (auto& style : scene->styles()) { style->onBeginUpdate(); }
+        for (auto& tile : tiles) { tile->update(view, 1/60.f); }
+
+        auto t0 = std::chrono::steady_clock::now();
+        labelManager->updateLabelSet(view, 1/60.f, *scene, tiles, markers, false);
+        auto t1 = std::chrono::steady_clock::now();
+        frameMs.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+
+        labelManager->waitForPlacement();
+    }
+    labelManager->setAsyncPlacement(false);
+
+    std::sort(frameMs.begin(), frameMs.end());
+    auto percentile = [&](double p) { return frameMs[std::min(size_t(p * frameMs.size()), frameMs.size() - 1)]; };
+    state.counters["p50_ms"] = percentile(.5);
+    state.counters["p95_ms"] = percentile(.95);
+    state.counters["p99_ms"] = percentile(.99);
+}
+BENCHMARK(BM_Tangram_LabelPlacementPan)->Arg(0)->Arg(1)->Iterations(600);
+
+BENCHMARK_MAIN();
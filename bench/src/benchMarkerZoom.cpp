@@ -0,0 +1,86 @@
+#include "benchmark/benchmark.h"
+
+#include "marker/markerManager.h"
+#include "mockPlatform.h"
+#include "scene/scene.h"
+#include "util/mapProjection.h"
+#include "view/view.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+using namespace Tangram;
+
+const char scene_file[] = "res/scene.yaml";
+
+static const int NUM_MARKERS = 10000;
+
+static MockPlatform platform;
+static std::shared_ptr<Scene> scene;
+static View view(1024, 768);
+
+static void globalSetup() {
+    if (scene) { return; }
+
+    SceneOptions sceneOptions{platform.resolveUrl(Url(scene_file))};
+    sceneOptions.numTileWorkers = 0;
+    sceneOptions.prefetchTiles = false;
+
+    scene = std::make_shared<Scene>(platform, std::move(sceneOptions));
+    if (!scene->load() || !scene->completeScene(view)) { exit(-1); }
+
+    // POI overlay: zoom dependent size, so every marker is rebuilt on zoom change
+    auto* markers = scene->markerManager();
+    std::srand(0);
+    for (int i = 0; i < NUM_MARKERS; i++) {
+        MarkerID id = markers->add();
+        markers->setStylingFromString(id, "{ style: points, color: '#f80', size: [[12, 6px], [18, 16px]], "
+                                          "collide: false, interactive: true }");
+        markers->setPoint(id, LngLat(-74.05 + .1 * std::rand() / RAND_MAX, 40.65 + .1 * std::rand() / RAND_MAX));
+    }
+    view.setPosition(MapProjection::lngLatToProjectedMeters(LngLat(-74, 40.7)));
+    view.setZoom(14);
+    view.update();
+    markers->update(view, 0);
+}
+
+// Main thread time of MarkerManager::update() when integer zoom changes with NUM_MARKERS point markers;
+//  state.range(0) enables building on a worker thread, in which case waiting for the worker is not counted
+//  in p50_ms but is included in total_ms.
+static void BM_Tangram_MarkerZoomChange(benchmark::State& state) {
+    globalSetup();
+
+    auto* markers = scene->markerManager();
+    markers->setAsyncBuilds(state.range(0) != 0);
+
+    std::vector<double> frameMs;
+    double totalMs = 0;
+    int zoom = 14;
+
+    while (state.KeepRunning()) {
+        zoom = zoom == 14 ? 15 : 14;
+        view.setZoom(zoom + .5f);
+        view.update();
+
+        auto t0 = std::chrono::steady_clock::now();
+        markers->update(view, 1/60.f);
+        auto t1 = std::chrono::steady_clock::now();
+        markers->waitForBuilds();
+        auto t2 = std::chrono::steady_clock::now();
+
+        frameMs.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        totalMs += std::chrono::duration<double, std::milli>(t2 - t0).count();
+    }
+    markers->setAsyncBuilds(false);
+
+    std::sort(frameMs.begin(), frameMs.end());
+    auto percentile = [&](double p) { return frameMs[std::min(size_t(p * frameMs.size()), frameMs.size() - 1)]; };
+    state.counters["p50_ms"] = percentile(.5);
+    state.counters["p99_ms"] = percentile(.99);
+    state.counters["total_ms"] = totalMs / frameMs.size();
+}
+BENCHMARK(BM_Tangram_MarkerZoomChange)->Arg(0)->Arg(1)->Iterations(20);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,158 @@
+#include "benchmark/benchmark.h"
+
+#include "data/tileSource.h"
+#include "log.h"
+#include "map.h"
+#include "mockPlatform.h"
+#include "scene/scene.h"
+#include "style/style.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileDataCache.h"
+#include "tile/tileManager.h"
+#include "tile/tileTask.h"
+#include "util/mapProjection.h"
+#include "view/view.h"
+
+#include <deque>
+#include <vector>
+
+using namespace Tangram;
+
+const char scene_file[] = "res/scene.yaml";
+const char tile_file[] = "res/tile.mvt";
+
+// styling zooms rebuilt from z10 data tile when zooming in past source max zoom
+const int maxStyleZoom = 18;
+
+std::shared_ptr<Scene> scene;
+std::shared_ptr<TileSource> source;
+std::shared_ptr<std::vector<char>> rawTileData;
+MockPlatform platform;
+
+void globalSetup() {
+    static std::atomic<bool> initialized{false};
+    if (initialized.exchange(true)) { return; }
+
+    SceneOptions sceneOptions{platform.resolveUrl(Url(scene_file))};
+    sceneOptions.numTileWorkers = 0;
+    sceneOptions.prefetchTiles = false;
+
+    scene = std::make_shared<Scene>(platform, std::move(sceneOptions));
+    if (!scene->load()) { exit(-1); }
+
+    for (auto& s : scene->tileSources()) {
+        source = s;
+        if (source->generateGeometry()) { break; }
+    }
+    rawTileData = std::make_shared<std::vector<char>>(MockPlatform::getBytesFromFile(tile_file));
+}
+
+class OverzoomFixture : public benchmark::Fixture {
+public:
+    std::unique_ptr<TileBuilder> tileBuilder;
+    void SetUp(const ::benchmark::State& state) override {
+        globalSetup();
+        tileBuilder = std::make_unique<TileBuilder>(*scene, new StyleContext());
+        tileBuilder->init();
+    }
+
+    // build tile for each styling zoom of data tile, as TileManager does when zooming in
+    void run(bool _reuseData) {
+        auto dataCache = _reuseData ? std::make_shared<TileDataCache>(64*1024*1024) : nullptr;
+        for (int s = 10; s <= maxStyleZoom; s++) {
+            auto task = source->createTask(TileID(301, 384, 10, s));
+            auto& t = static_cast<BinaryTileTask&>(*task);
+            if (dataCache) { task->setDataCache(dataCache); }
+            if (!t.loadFromDataCache()) { t.rawTileData = rawTileData; }
+            task->process(*tileBuilder);
+            if (!task->isReady()) {
+                LOGE("Invalid tile file '%s'", tile_file);
+                exit(-1);
+            }
+        }
+    }
+};
+
+BENCHMARK_DEFINE_F(OverzoomFixture, OverzoomReparse)(benchmark::State& st) {
+    while (st.KeepRunning()) { run(false); }
+}
+BENCHMARK_REGISTER_F(OverzoomFixture, OverzoomReparse);
+
+BENCHMARK_DEFINE_F(OverzoomFixture, OverzoomReuseData)(benchmark::State& st) {
+    while (st.KeepRunning()) { run(true); }
+}
+BENCHMARK_REGISTER_F(OverzoomFixture, OverzoomReuseData);
+
+// serves the bench tile for every tile, in place of network and memory cache
+struct BenchDataSource : TileSource::DataSource {
+    int loads = 0;
+    bool loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override {
+        loads++;
+        static_cast<BinaryTileTask&>(*_task).rawTileData = rawTileData;
+        _cb.func(_task);
+        return true;
+    }
+};
+
+struct BenchTileSource : TileSource {
+    mutable int parses = 0;
+    BenchTileSource(std::unique_ptr<DataSource> _sources)
+        : TileSource(source->name(), std::move(_sources), ZoomOptions(-1, -1, 10, 0)) {
+        setFormat(Format::Mvt);
+        m_generateGeometry = true;
+    }
+    std::shared_ptr<TileData> parse(const TileTask& _task) const override {
+        parses++;
+        return TileSource::parse(_task);
+    }
+};
+
+// builds tasks on the calling thread when drained, in place of TileWorker
+struct BenchTileWorker : TileTaskQueue {
+    TileBuilder& builder;
+    std::deque<std::shared_ptr<TileTask>> tasks;
+    BenchTileWorker(TileBuilder& _builder) : builder(_builder) {}
+    void enqueue(std::shared_ptr<TileTask> task) override { tasks.push_back(std::move(task)); }
+    void drain() {
+        while (!tasks.empty()) {
+            auto task = std::move(tasks.front());
+            tasks.pop_front();
+            if (!task->isCanceled()) { task->process(builder); }
+        }
+    }
+};
+
+// Zoom in from source max zoom to maxStyleZoom through TileManager, as the map does, with TileDataCache
+//  size state.range(0); overzoomed tiles should share parsed data via the source even when that is 0
+BENCHMARK_DEFINE_F(OverzoomFixture, OverzoomTileManager)(benchmark::State& st) {
+    int loads = 0, parses = 0;
+    while (st.KeepRunning()) {
+        auto dataSource = std::make_unique<BenchDataSource>();
+        auto* benchData = dataSource.get();
+        auto benchSource = std::make_shared<BenchTileSource>(std::move(dataSource));
+        BenchTileWorker worker(*tileBuilder);
+        TileManager tileManager(platform, worker, {});
+        tileManager.setTileSources({benchSource});
+        tileManager.setTileDataCacheSize(size_t(st.range(0)));
+
+        View view(1024, 768);
+        view.setPosition(MapProjection::tileCenter(TileID(301, 384, 10)));
+        for (int z = 10; z <= maxStyleZoom; z++) {
+            view.setZoom(z);
+            view.update();
+            tileManager.updateTileSets(view);
+            while (tileManager.numLoadingTiles() > 0 && !worker.tasks.empty()) {
+                worker.drain();
+                tileManager.updateTileSets(view);
+            }
+        }
+        loads = benchData->loads;
+        parses = benchSource->parses;
+    }
+    st.counters["loads"] = loads;
+    st.counters["parses"] = parses;
+}
+BENCHMARK_REGISTER_F(OverzoomFixture, OverzoomTileManager)->Arg(0)->Arg(64*1024*1024);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,264 @@
+// End-to-end tile build throughput for a scene over a corpus of tiles
+//
+// Usage: benchSceneCorpus.out <scene.yaml> <tile directory | file.mbtiles> [workers] [repeat]
+//
+// Tiles in a directory are found recursively and named .../z/x/y.ext or z_x_y.ext (or z-x-y.ext). All tiles
+// are read into memory first, then each worker thread runs TileTask::process() (parse and build, as in
+// TileWorker) with its own TileBuilder. Results are written to stdout as JSON.
+
+#include "data/tileSource.h"
+#include "log.h"
+#include "mockPlatform.h"
+#include "scene/scene.h"
+#include "tile/tile.h"
+#include "tile/tileBuilder.h"
+#include "tile/tileTask.h"
+#include "util/zlibHelper.h"
+
+#ifdef TANGRAM_MBTILES_DATASOURCE
+#include "sqlitepp.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <regex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+using namespace Tangram;
+
+// allocation counting for per-layer and per-style breakdown
+static thread_local uint64_t t_allocs = 0;
+static thread_local uint64_t t_allocBytes = 0;
+
+void* operator new(size_t _size) {
+    t_allocs++;
+    t_allocBytes += _size;
+    if (void* p = std::malloc(_size ? _size : 1)) { return p; }
+    throw std::bad_alloc();
+}
+void operator delete(void* _p) noexcept { std::free(_p); }
+void operator delete(void* _p, size_t) noexcept { std::free(_p); }
+
+static void threadAllocCounter(uint64_t& _allocs, uint64_t& _bytes) {
+    _allocs = t_allocs;
+    _bytes = t_allocBytes;
+}
+
+struct CorpusTile {
+    TileID id;
+    std::shared_ptr<std::vector<char>> data;
+};
+
+static void inflateIfCompressed(std::vector<char>& _data) {
+    if (_data.size() > 10 && _data[0] == 0x1F && (unsigned char)_data[1] == 0x8B) {
+        std::vector<char> out;
+        if (zlib_inflate(_data.data(), _data.size(), out) == 0) { _data.swap(out); }
+    }
+}
+
+static void readTileDir(const std::string& _path, std::vector<CorpusTile>& _tiles) {
+    static const std::regex tileName(R"((\d+)[/_-](\d+)[/_-](\d+)\.\w+$)");
+
+    DIR* dir = opendir(_path.c_str());
+    if (!dir) { return; }
+    while (dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name == "." || name == "..") { continue; }
+        std::string path = _path + "/" + name;
+
+        struct stat st;
+        if (stat(path.c_str(), &st) != 0) { continue; }
+        if (S_ISDIR(st.st_mode)) {
+            readTileDir(path, _tiles);
+            continue;
+        }
+        std::smatch match;
+        if (!std::regex_search(path, match, tileName)) { continue; }
+
+        auto data = std::make_shared<std::vector<char>>(MockPlatform::getBytesFromFile(path.c_str()));
+        inflateIfCompressed(*data);
+        if (data->empty()) { continue; }
+        _tiles.push_back({TileID(std::stoi(match[2]), std::stoi(match[3]), std::stoi(match[1])), data});
+    }
+    closedir(dir);
+}
+
+static void readMBTiles(const std::string& _path, std::vector<CorpusTile>& _tiles) {
+#ifdef TANGRAM_MBTILES_DATASOURCE
+    SQLiteDB db(_path, SQLITE_OPEN_READONLY);
+    if (!db.db) { return; }
+    db.stmt("SELECT zoom_level, tile_column, tile_row, tile_data FROM tiles;").exec([&](sqlite3_stmt* stmt) {
+        int z = sqlite3_column_int(stmt, 0);
+        int x = sqlite3_column_int(stmt, 1);
+        // MBTiles rows are TMS
+        int y = (1 << z) - 1 - sqlite3_column_int(stmt, 2);
+        auto blob = (const char*)sqlite3_column_blob(stmt, 3);
+        auto data = std::make_shared<std::vector<char>>(blob, blob + sqlite3_column_bytes(stmt, 3));
+        inflateIfCompressed(*data);
+        if (!data->empty()) { _tiles.push_back({TileID(x, y, z), data}); }
+    });
+#else
+    LOGE("Built without TANGRAM_MBTILES_DATASOURCE - cannot read %s", _path.c_str());
+#endif
+}
+
+static double percentile(const std::vector<double>& _sorted, double _p) {
+    if (_sorted.empty()) { return 0; }
+    size_t idx = std::min(size_t(_p * _sorted.size()), _sorted.size() - 1);
+    return _sorted[idx];
+}
+
+static void printEntries(const char* _name, const std::map<std::string, TileBuilder::BuildStats::Entry>& _entries,
+                         size_t _numTiles) {
+    printf("  \"%s\": {", _name);
+    const char* sep = "\n";
+    for (auto& entry : _entries) {
+        auto& e = entry.second;
+        printf("%s    \"%s\": {\"ms\": %.3f, \"msPerTile\": %.4f, \"features\": %llu, \"allocs\": %llu, "
+               "\"allocBytes\": %llu", sep, entry.first.c_str(), e.seconds * 1000, e.seconds * 1000 / _numTiles,
+               (unsigned long long)e.features, (unsigned long long)e.allocs, (unsigned long long)e.allocBytes);
+        if (e.vertices > 0) {
+            // compare to meshes with the style's full vertex layout
+            uint64_t fullMeshBytes = e.meshBytes - e.vertexBytes + e.fullVertexBytes;
+            printf(", \"meshBytesPerTile\": %.0f, \"fullLayoutMeshBytesPerTile\": %.0f, \"bytesPerVertex\": %.2f, "
+                   "\"fullLayoutBytesPerVertex\": %.2f", double(e.meshBytes) / _numTiles,
+                   double(fullMeshBytes) / _numTiles, double(e.vertexBytes) / e.vertices,
+                   double(e.fullVertexBytes) / e.vertices);
+        }
+        printf("}");
+        sep = ",\n";
+    }
+    printf("\n  }");
+}
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <scene.yaml> <tile directory | file.mbtiles> [workers] [repeat]\n", argv[0]);
+        return 1;
+    }
+    std::string scenePath = argv[1];
+    std::string corpusPath = argv[2];
+    int numWorkers = argc > 3 ? std::max(1, atoi(argv[3])) : 1;
+    int repeat = argc > 4 ? std::max(1, atoi(argv[4])) : 1;
+
+    MockPlatform platform;
+    SceneOptions sceneOptions{platform.resolveUrl(Url(scenePath))};
+    sceneOptions.numTileWorkers = 0;
+    sceneOptions.prefetchTiles = false;
+
+    auto scene = std::make_shared<Scene>(platform, std::move(sceneOptions));
+    if (!scene->load()) {
+        LOGE("Failed to load scene %s", scenePath.c_str());
+        return 1;
+    }
+
+    std::shared_ptr<TileSource> source;
+    for (auto& s : scene->tileSources()) {
+        if (s->generateGeometry()) { source = s; break; }
+    }
+    if (!source) {
+        LOGE("Scene has no geometry source");
+        return 1;
+    }
+
+    std::vector<CorpusTile> corpus;
+    size_t ext = corpusPath.rfind('.');
+    if (ext != std::string::npos && corpusPath.substr(ext) == ".mbtiles") {
+        readMBTiles(corpusPath, corpus);
+    } else {
+        readTileDir(corpusPath, corpus);
+    }
+    if (corpus.empty()) {
+        LOGE("No tiles found in %s", corpusPath.c_str());
+        return 1;
+    }
+    // deterministic order for comparable runs
+    std::sort(corpus.begin(), corpus.end(), [](auto& a, auto& b) { return a.id < b.id; });
+
+    size_t numTasks = corpus.size() * repeat;
+    std::vector<double> tileMs(numTasks);
+    std::vector<TileBuilder::BuildStats> workerStats(numWorkers);
+    std::atomic<size_t> nextTask{0};
+    std::atomic<size_t> failed{0};
+
+    auto worker = [&](int _index) {
+        auto builder = std::make_unique<TileBuilder>(*scene);
+        builder->init();
+        workerStats[_index].allocCounter = threadAllocCounter;
+        builder->setStats(&workerStats[_index]);
+
+        size_t i;
+        while ((i = nextTask++) < numTasks) {
+            auto& input = corpus[i % corpus.size()];
+            auto task = source->createTask(input.id);
+            static_cast<BinaryTileTask&>(*task).rawTileData = input.data;
+
+            auto t0 = std::chrono::steady_clock::now();
+            task->process(*builder);
+            auto t1 = std::chrono::steady_clock::now();
+
+            tileMs[i] = std::chrono::duration<double, std::milli>(t1 - t0).count();
+            if (task->isCanceled()) { failed++; }
+            // tile is destroyed here, outside of measured time
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int w = 0; w < numWorkers; w++) { threads.emplace_back(worker, w); }
+    for (auto& thread : threads) { thread.join(); }
+    double totalSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    TileBuilder::BuildStats stats;
+    for (auto& ws : workerStats) {
+        for (auto& l : ws.layers) {
+            auto& e = stats.layers[l.first];
+            e.seconds += l.second.seconds; e.allocs += l.second.allocs;
+            e.allocBytes += l.second.allocBytes; e.features += l.second.features;
+        }
+        for (auto& s : ws.styles) {
+            auto& e = stats.styles[s.first];
+            e.seconds += s.second.seconds; e.allocs += s.second.allocs;
+            e.allocBytes += s.second.allocBytes; e.features += s.second.features;
+            e.meshBytes += s.second.meshBytes; e.vertices += s.second.vertices;
+            e.vertexBytes += s.second.vertexBytes; e.fullVertexBytes += s.second.fullVertexBytes;
+        }
+    }
+
+    std::vector<double> sorted = tileMs;
+    std::sort(sorted.begin(), sorted.end());
+    double sumMs = 0;
+    for (double ms : sorted) { sumMs += ms; }
+
+    uint64_t meshBytes = 0, fullMeshBytes = 0;
+    for (auto& s : stats.styles) {
+        meshBytes += s.second.meshBytes;
+        fullMeshBytes += s.second.meshBytes - s.second.vertexBytes + s.second.fullVertexBytes;
+    }
+
+    printf("{\n");
+    printf("  \"scene\": \"%s\",\n  \"corpus\": \"%s\",\n  \"source\": \"%s\",\n",
+           scenePath.c_str(), corpusPath.c_str(), source->name().c_str());
+    printf("  \"workers\": %d,\n  \"tiles\": %zu,\n  \"failed\": %zu,\n", numWorkers, numTasks, size_t(failed));
+    printf("  \"seconds\": %.4f,\n  \"tilesPerSecond\": %.2f,\n", totalSec, numTasks / totalSec);
+    printf("  \"tileMs\": {\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f},\n",
+           sumMs / numTasks, percentile(sorted, .5), percentile(sorted, .95), percentile(sorted, .99), sorted.back());
+    printf("  \"meshBytesPerTile\": {\"built\": %.0f, \"fullLayout\": %.0f},\n",
+           double(meshBytes) / numTasks, double(fullMeshBytes) / numTasks);
+    printEntries("layers", stats.layers, numTasks);
+    printf(",\n");
+    printEntries("styles", stats.styles, numTasks);
+    printf("\n}\n");
+
+    return failed == numTasks ? 1 : 0;
+}
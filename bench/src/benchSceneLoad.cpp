@@ -0,0 +1,64 @@
+#include "benchmark/benchmark.h"
+
+#include "mockPlatform.h"
+#include "scene/scene.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace Tangram;
+
+const char scene_file[] = "res/scene.yaml";
+const char compiled_file[] = "res/scene.compiled";
+
+// Time from Scene::load() to the first tile request (the prefetch callback, issued once sources are
+//  created); state.range(0) loads from a compiled scene snapshot, which is written by the first load.
+// config_ms is the part of that spent producing the scene config (reading and merging YAML, or loading
+//  the snapshot), i.e. the only part a snapshot can save.
+static void BM_Tangram_SceneLoadFirstTile(benchmark::State& state) {
+    MockPlatform platform;
+    bool compiled = state.range(0) != 0;
+    std::remove(compiled_file);
+
+    std::vector<double> loadMs;
+    std::vector<double> configMs;
+    int run = 0;
+
+    while (state.KeepRunning()) {
+        SceneOptions sceneOptions{platform.resolveUrl(Url(scene_file))};
+        sceneOptions.numTileWorkers = 0;
+        if (compiled) { sceneOptions.compiledScenePath = compiled_file; }
+
+        std::chrono::steady_clock::time_point firstTile;
+        auto scene = std::make_unique<Scene>(platform, std::move(sceneOptions),
+                                             [&](Scene*) { firstTile = std::chrono::steady_clock::now(); });
+
+        auto t0 = std::chrono::steady_clock::now();
+        if (!scene->load()) {
+            state.SkipWithError("Scene load failed");
+            break;
+        }
+        // first load with snapshot enabled only writes it
+        if (!compiled || run++ > 0) {
+            loadMs.push_back(std::chrono::duration<double, std::milli>(firstTile - t0).count());
+            for (auto& stage : scene->loadStages()) {
+                if (std::string(stage.name) == "applySources") { configMs.push_back(stage.startMs); }
+            }
+        }
+    }
+    std::remove(compiled_file);
+    if (loadMs.empty()) { return; }
+
+    std::sort(loadMs.begin(), loadMs.end());
+    state.counters["first_tile_ms"] = loadMs[loadMs.size() / 2];
+    if (!configMs.empty()) {
+        std::sort(configMs.begin(), configMs.end());
+        state.counters["config_ms"] = configMs[configMs.size() / 2];
+    }
+}
+BENCHMARK(BM_Tangram_SceneLoadFirstTile)->Arg(0)->Arg(1)->Iterations(21);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,57 @@
+#include "benchmark/benchmark.h"
+
+#include "util/terrainDepthRasterizer.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace Tangram;
+
+static const int TILES_X = 8;
+static const int TILES_Y = 8;
+static const int GRID_RES = 32;
+
+// pitched view over TILES_X x TILES_Y tiles of hilly terrain, as with 3D terrain at typical zoom
+static std::vector<TerrainDepthRasterizer::TileGrid> benchTiles(const glm::mat4& _view) {
+    std::vector<TerrainDepthRasterizer::TileGrid> tiles;
+    for (int ty = 0; ty < TILES_Y; ty++) {
+        for (int tx = 0; tx < TILES_X; tx++) {
+            TerrainDepthRasterizer::TileGrid grid;
+            grid.modelView = glm::translate(_view, glm::vec3(tx - TILES_X/2, ty, 0));
+            grid.resolution = GRID_RES;
+            for (int row = 0; row <= GRID_RES; row++) {
+                for (int col = 0; col <= GRID_RES; col++) {
+                    float x = tx + col/float(GRID_RES), y = ty + row/float(GRID_RES);
+                    grid.heights.push_back(0.1f*std::sin(3*x)*std::cos(2*y) + 0.05f*std::sin(11*x + 7*y));
+                }
+            }
+            tiles.push_back(std::move(grid));
+        }
+    }
+    return tiles;
+}
+
+static void BM_Tangram_TerrainDepthRasterize(benchmark::State& state) {
+    int width = state.range(0), height = state.range(1);
+    glm::mat4 view = glm::lookAt(glm::vec3(0, -0.5f, 1.0f), glm::vec3(0, 2, 0), glm::vec3(0, 0, 1));
+    glm::mat4 proj = glm::perspective(glm::radians(60.0f), float(width)/height, 0.05f, 100.0f);
+    auto tiles = benchTiles(view);
+
+    TerrainDepthRasterizer rasterizer;
+    std::vector<float> depth;
+    while (state.KeepRunning()) {
+        rasterizer.rasterize(depth, width, height, proj, tiles);
+        benchmark::DoNotOptimize(depth.data());
+    }
+
+    size_t covered = 0;
+    for (float d : depth) { covered += d > 0; }
+    state.counters["coverage"] = double(covered)/depth.size();
+    state.counters["triangles"] = double(tiles.size() * GRID_RES * GRID_RES * 2);
+}
+// depth buffer at half resolution (default) of 720p, 1080p and 1440p viewports
+BENCHMARK(BM_Tangram_TerrainDepthRasterize)->Args({640, 360})->Args({960, 540})->Args({1280, 720});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,50 @@
+#include "benchmark/benchmark.h"
+
+#include "gl/texture.h"
+#include "util/textureCompression.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Tangram;
+
+// size x size opaque RGBA raster resembling hillshaded imagery
+static std::vector<uint8_t> benchImage(int _size) {
+    std::vector<uint8_t> rgba(_size*_size*4, 255);
+    for (int y = 0; y < _size; y++) {
+        for (int x = 0; x < _size; x++) {
+            float shade = 0.5f + 0.3f*std::sin(0.11f*x)*std::cos(0.07f*y) + 0.1f*std::sin(0.9f*(x + y));
+            uint8_t* p = &rgba[4*(y*_size + x)];
+            p[0] = uint8_t(std::min(255.f, 255*shade));
+            p[1] = uint8_t(std::min(255.f, 230*shade));
+            p[2] = uint8_t(std::min(255.f, 200*shade));
+        }
+    }
+    return rgba;
+}
+
+static void runCompress(benchmark::State& state, PixelFormat _format) {
+    int size = state.range(0);
+    auto rgba = benchImage(size);
+    TextureOptions options;
+    options.pixelFormat = _format;
+    std::vector<uint8_t> blocks(options.imageSize(size, size));
+
+    while (state.KeepRunning()) {
+        TextureCompression::compress(_format, rgba.data(), size, size, blocks.data());
+        benchmark::DoNotOptimize(blocks.data());
+    }
+    state.SetBytesProcessed(state.iterations() * rgba.size());
+}
+
+static void BM_Tangram_CompressBC1(benchmark::State& state) {
+    runCompress(state, PixelFormat::BC1_RGB);
+}
+BENCHMARK(BM_Tangram_CompressBC1)->Arg(256)->Arg(512);
+
+static void BM_Tangram_CompressETC2(benchmark::State& state) {
+    runCompress(state, PixelFormat::ETC2_RGB);
+}
+BENCHMARK(BM_Tangram_CompressETC2)->Arg(256)->Arg(512);
+
+BENCHMARK_MAIN();
@@ -63,6 +63,19 @@ public:
 
         virtual void clear() { if (next) next->clear(); }
 
+        /* Keeps processed form of @_rawData for @_tileId (e.g. transcoded raster) beside it in memory
+         * caches, while @_rawData is the cached data for the tile */
+        virtual void cacheProcessedData(const TileID& _tileId, const std::vector<char>& _rawData,
+                                        std::shared_ptr<std::vector<char>> _processed) {
+            if (next) { next->cacheProcessedData(_tileId, _rawData, _processed); }
+        }
+
+        /* Processed data kept beside @_rawData for @_tileId, if any */
+        virtual std::shared_ptr<std::vector<char>> getProcessedData(const TileID& _tileId,
+                                                                    const std::vector<char>& _rawData) {
+            return next ? next->getProcessedData(_tileId, _rawData) : nullptr;
+        }
+
         void setNext(std::unique_ptr<DataSource> _next) {
             next = std::move(_next);
             next->level = level + 1;
@@ -116,6 +129,9 @@ public:
     /* Clears all data associated with this TileSource */
     virtual void clearData();
 
+    /* Increments generation so tiles are rebuilt, keeping cached data */
+    void invalidateTiles() { m_generation++; }
+
     const std::string& name() const { return m_name; }
 
     virtual std::shared_ptr<TileTask> createTask(TileID _tile);
@@ -184,6 +200,11 @@ protected:
     // Generation of dynamic TileSource state (incremented for each update)
     int64_t m_generation = 1;
 
+    // Parsed data tiles for overzoomed tiles when TileManager has no TileDataCache, created when the first
+    //  overzoomed tile is loaded; only needs to hold the few data tiles under the view
+    static constexpr size_t OVERZOOM_CACHE_BYTES = 8*1024*1024;
+    std::shared_ptr<TileDataCache> m_overzoomCache;
+
     Format m_format = Format::GeoJson;
 
     /* vector of raster sources (as raster samplers) referenced by this datasource */
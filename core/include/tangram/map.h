@@ -209,7 +209,8 @@ public:
     // get the View object
     View& getView();
 
-    // update global variables (only affects JS functions currently)
+    // update global variables (only affects JS functions currently); with _rebuildTiles, tiles of layers with
+    //  functions using the updated globals are rebuilt while current tiles remain visible
     void updateGlobals(const std::vector<SceneUpdate>& _sceneUpdates, bool _rebuildTiles = true);
 
     // Set listener for scene load events. The callback receives the SceneID
@@ -446,10 +447,22 @@ public:
     // efficiency, but can cause errors if your application code makes OpenGL calls (false by default)
     void useCachedGlState(bool _use);
 
+    // Set the maximum bytes of tile geometry and raster data to upload to the GPU per frame; tiles waiting
+    // for upload are drawn with proxy tiles, largest on screen uploaded first (0 = no limit, the default)
+    void setFrameUploadBudget(size_t _bytes);
+
+    // Start or stop recording trace events (frame, tile fetch, parse, build and upload); starting discards
+    // previously recorded events
+    void setTracing(bool _enabled);
+
+    // Get recorded trace events as Chrome trace JSON, for chrome://tracing or ui.perfetto.dev
+    std::string getTraceJson();
+
     // Set the radius in logical pixels to use when picking features on the map (default is 0.5).
     void setPickRadius(float _radius);
 
-    // Create a query to select a feature marked as 'interactive'. The query runs on the next frame.
+    // Create a query to select a feature marked as 'interactive'. The query runs on the next frame, with
+    // the selection buffer or, if SceneOptions::cpuFeaturePicking is set, with the tiles' feature index.
     // Calls _onFeaturePickCallback once the query has completed, and returns the FeaturePickResult
     // with its associated properties or null if no feature was found.
     void pickFeatureAt(float _x, float _y, FeaturePickCallback _onFeaturePickCallback);
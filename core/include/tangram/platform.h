@@ -33,6 +33,9 @@ struct HttpOptions {
     HttpOptions(const char* hdrs = "", const char* post = "") : headers(hdrs), payload(post) {}
     std::string headers;  // put all headers in single string separated by newlines for now
     std::string payload;  // implies POST if not empty
+    // optional dispatch priority queried while request is pending; lower value is more urgent (see
+    //  TileTask::getPriority()); requests without priority are dispatched after prioritized ones
+    std::function<double()> priority;
 
     void addHeader(const std::string& hdr, const std::string& val) {
         assert(hdr.size() && hdr.back() != ':' && hdr.back() != ' ' && val.size());
@@ -56,6 +56,29 @@ public:
     /// Preserve markers from previous scene?
     bool preserveMarkers = false;
 
+    /// Index interactive feature geometry per tile so pickFeatureAt() is resolved on the CPU
+    /// immediately, without rendering the selection buffer
+    bool cpuFeaturePicking = false;
+
+    /// Run label collision on a worker thread while the frame renders; placement is applied one frame
+    /// later. Map::render() must follow each Map::update().
+    bool asyncLabelPlacement = false;
+
+    /// Reuse the collision result of labels which moved at most this many pixels since last tested and
+    /// whose neighbors did not change; 0 gives the same placement as a full pass. < 0 disables.
+    float labelCollisionThreshold = -1;
+
+    /// Rasterize terrain depth (used for label and marker occlusion with 3D terrain) on a CPU worker
+    /// from the DEM tiles instead of rendering it with a shared GL context and reading it back
+    bool cpuTerrainDepth = false;
+
+    /// Size of terrain depth buffer relative to viewport
+    float terrainDepthResolution = 0.5f;
+
+    /// Build decimated index buffers for polygon and line meshes, drawn instead of full geometry for
+    /// tiles shown smaller than their styling zoom and for proxy tiles
+    bool tileGeometryLod = false;
+
     /// Metric or Imperial?
     bool metricUnits = true;
 
@@ -65,6 +88,13 @@ public:
     /// 16MB default in-memory DataSource cache
     size_t memoryTileCacheSize = CACHE_SIZE;
 
+    /// in-memory cache of parsed tile data, so rebuilt tiles skip parsing; 0 disables (a source still
+    ///  keeps a few data tiles for its overzoomed tiles once zoomed in past its max zoom)
+    size_t tileDataCacheSize = 0;
+
+    /// per raster source, decoded textures kept after tiles using them are released; 0 disables
+    size_t rasterCacheSize = 0;
+
     /// persistent MBTiles DataSource cache
     size_t diskTileCacheSize = 0;
 
@@ -74,6 +104,12 @@ public:
     /// cache directory for tiles, fonts, etc
     std::string diskCacheDir;
 
+    /// File for snapshot of the merged scene config; loaded instead of importing and merging the scene
+    /// files if local files have not changed, otherwise written after loading. Remote imports are not
+    /// rechecked; remove the file to pick up changes to them. Layers and styles are still parsed from
+    /// the config on each load. Empty to disable.
+    std::string compiledScenePath;
+
     /// global fallback fonts
     std::vector<FontSourceHandle> fallbackFonts;
 
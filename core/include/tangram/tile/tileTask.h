@@ -16,6 +16,7 @@ class TileSource;
 class Tile;
 class MapProjection;
 class ScenePrana;
+class TileDataCache;
 struct TileData;
 
 
@@ -44,6 +45,10 @@ public:
     TileSource* source() { return m_source; }
     std::shared_ptr<ScenePrana> prana() { return m_scenePrana.lock(); }
     void setScenePrana(std::weak_ptr<ScenePrana> _prana);
+
+    // parsed data is taken from and added to _cache (if supported by task)
+    void setDataCache(std::shared_ptr<TileDataCache> _cache) { m_dataCache = std::move(_cache); }
+    bool hasDataCache() const { return bool(m_dataCache); }
     int64_t sourceId() { return m_sourceId; }
     int64_t sourceGeneration() const { return m_sourceGeneration; }
 
@@ -89,6 +94,9 @@ public:
 
 protected:
 
+    // called by process() on worker thread
+    virtual std::shared_ptr<TileData> parseTileData();
+
     const TileID m_tileId;
 
     TileSource* m_source;
@@ -111,6 +119,8 @@ protected:
 
     std::atomic<float> m_priority;
     std::atomic<bool> m_proxyState;
+
+    std::shared_ptr<TileDataCache> m_dataCache;
 };
 
 class BinaryTileTask : public TileTask {
@@ -119,13 +129,22 @@ public:
         : TileTask(_tileId, _source) {}
 
     virtual bool hasData() const override {
-        return rawTileData && !rawTileData->empty();
+        return (rawTileData && !rawTileData->empty()) || bool(tileData);
     }
     // Raw tile data that will be processed by TileSource.
     std::shared_ptr<std::vector<char>> rawTileData;
 
+    // Parsed data shared with other tasks for the same data tile (i.e. overzoomed tiles) - no loading needed
+    std::shared_ptr<TileData> tileData;
+
+    // take parsed data for data tile from TileDataCache if available
+    bool loadFromDataCache();
+
     bool dataFromCache = false;
     UrlRequestHandle urlRequestHandle = 0;
+
+protected:
+    std::shared_ptr<TileData> parseTileData() override;
 };
 
 struct TileTaskQueue {
@@ -6,9 +6,11 @@ MODULE_SOURCES = \
   src/map.cpp                         \
   src/platform.cpp                    \
   src/data/clientDataSource.cpp       \
+  src/data/contourSource.cpp          \
   src/data/memoryCacheDataSource.cpp  \
   src/data/networkDataSource.cpp      \
   src/data/properties.cpp             \
+  src/data/rasterCache.cpp            \
   src/data/rasterSource.cpp           \
   src/data/tileSource.cpp             \
   src/data/formats/geoJson.cpp        \
@@ -16,6 +18,9 @@ MODULE_SOURCES = \
   src/data/formats/topoJson.cpp       \
   src/debug/frameInfo.cpp             \
   src/debug/textDisplay.cpp           \
+  src/debug/trace.cpp                 \
+  src/gl/bufferPool.cpp               \
+  src/gl/pixelBufferPool.cpp          \
   src/gl/framebuffer.cpp              \
   src/gl/glError.cpp                  \
   src/gl/glyphTexture.cpp             \
@@ -26,6 +31,7 @@ MODULE_SOURCES = \
   src/gl/shaderProgram.cpp            \
   src/gl/shaderSource.cpp             \
   src/gl/texture.cpp                  \
+  src/gl/uploadScheduler.cpp          \
   src/gl/vao.cpp                      \
   src/gl/vertexLayout.cpp             \
   src/labels/curvedLabel.cpp          \
@@ -49,12 +55,14 @@ MODULE_SOURCES = \
   src/scene/scene.cpp                 \
   src/scene/sceneLayer.cpp            \
   src/scene/sceneLoader.cpp           \
+  src/scene/sceneSnapshot.cpp         \
   src/scene/spotLight.cpp             \
   src/scene/spriteAtlas.cpp           \
   src/scene/stops.cpp                 \
   src/scene/styleContext.cpp          \
   src/scene/styleMixer.cpp            \
   src/scene/styleParam.cpp            \
+  src/selection/featureIndex.cpp      \
   src/selection/featureSelection.cpp  \
   src/selection/selectionQuery.cpp    \
   src/style/debugStyle.cpp            \
@@ -73,12 +81,14 @@ MODULE_SOURCES = \
   src/text/textUtil.cpp               \
   src/tile/tile.cpp                   \
   src/tile/tileBuilder.cpp            \
+  src/tile/tileDataCache.cpp          \
   src/tile/tileManager.cpp            \
   src/tile/tileTask.cpp               \
   src/tile/tileWorker.cpp             \
   src/util/builders.cpp               \
   src/util/dashArray.cpp              \
   src/util/elevationManager.cpp       \
+  src/util/elevationPyramid.cpp       \
   src/util/extrude.cpp                \
   src/util/floatFormatter.cpp         \
   src/util/geom.cpp                   \
@@ -88,6 +98,8 @@ MODULE_SOURCES = \
   src/util/mapProjection.cpp          \
   src/util/skyManager.cpp             \
   src/util/stbImage.cpp               \
+  src/util/terrainDepthRasterizer.cpp \
+  src/util/textureCompression.cpp     \
   src/util/url.cpp                    \
   src/util/util.cpp                   \
   src/util/wuffs.c                    \
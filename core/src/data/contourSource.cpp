@@ -0,0 +1,435 @@
+#include "data/contourSource.h"
+
+#include "data/rasterSource.h"
+#include "data/tileData.h"
+#include "gl/texture.h"
+#include "tile/tileDataCache.h"
+#include "tile/tileTask.h"
+#include "util/elevationPyramid.h"
+#include "util/hash.h"
+#include "log.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+
+namespace Tangram {
+
+class ContourTileTask : public BinaryTileTask {
+public:
+
+    // decoded DEM texture, if already available from elevation source when task was created
+    std::shared_ptr<Texture> texture;
+
+    ContourTileTask(const TileID& _tileId, TileSource* _source) : BinaryTileTask(_tileId, _source) {}
+
+    bool hasData() const override {
+        return BinaryTileTask::hasData() || bool(texture);
+    }
+
+protected:
+
+    std::shared_ptr<TileData> parseTileData() override {
+        // DEM data for a tile doesn't change until clearData(), which also clears the caches, so entries
+        //  are keyed by contour options instead of raw data (which is absent if texture was reused)
+        auto source = static_cast<ContourSource*>(m_source);
+        auto& cache = m_dataCache ? m_dataCache : source->m_cache;
+
+        if (auto tileData = cache->get(m_sourceId, m_tileId, source->configHash())) { return tileData; }
+
+        // tiles built without all neighbors are not cached, so they get their border when built again
+        bool complete = true;
+        auto tileData = source->parse(*this, complete);
+        if (tileData && complete) {
+            cache->put(m_sourceId, m_tileId, source->configHash(), tileData, m_sourceGeneration);
+        }
+        return tileData;
+    }
+};
+
+ContourSource::ContourSource(const std::string& _name, std::shared_ptr<RasterSource> _demSource,
+                             Intervals _intervals, int _indexInterval, ZoomOptions _zoomOptions)
+    : TileSource(_name, nullptr, _zoomOptions),
+      m_demSource(std::move(_demSource)),
+      m_intervals(std::move(_intervals)),
+      m_indexInterval(std::max(_indexInterval, 1)) {
+
+    // tiles are the DEM tiles, so they are overzoomed past the same zoom
+    m_zoomOptions.maxZoom = m_demSource->maxZoom();
+    m_zoomOptions.zoomBias = m_demSource->zoomBias();
+    // elevation values are read on tile worker
+    m_demSource->m_keepTextureData = true;
+
+    std::sort(m_intervals.begin(), m_intervals.end());
+    size_t seed = 0;
+    for (auto& stop : m_intervals) {
+        hash_combine(seed, stop.first);
+        hash_combine(seed, stop.second);
+    }
+    hash_combine(seed, m_indexInterval);
+    m_configHash = seed;
+
+    m_cache = std::make_shared<TileDataCache>(CACHE_BYTES);
+}
+
+void ContourSource::clearData() {
+    m_cache->clear();
+    TileSource::clearData();
+}
+
+float ContourSource::intervalForZoom(int _zoom) const {
+    float interval = 0;
+    for (auto& stop : m_intervals) {
+        if (stop.first > _zoom) { break; }
+        interval = stop.second;
+    }
+    return interval;
+}
+
+std::shared_ptr<TileTask> ContourSource::createTask(TileID _tileId) {
+    auto task = std::make_shared<ContourTileTask>(_tileId, this);
+
+    // reuse DEM texture if elevation source has it (and it still has CPU data)
+    auto texture = m_demSource->getTexture(TileID(_tileId.x, _tileId.y, _tileId.z));
+    if (texture && texture->bufferData()) {
+        task->texture = std::move(texture);
+        task->startedLoading();
+    }
+
+    addRasterTasks(*task);
+
+    return task;
+}
+
+void ContourSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) {
+    // raw DEM tiles come from (and are cached by) data sources of elevation source
+    m_demSource->loadTileData(_task, _cb);
+}
+
+void ContourSource::cancelLoadingTile(TileTask& _task) {
+    m_demSource->cancelLoadingTile(_task);
+}
+
+// elevation of sample (_x, _y), row 0 at south edge, of DEM texture with CPU data
+static float demSample(const Texture& _texture, int _x, int _y) {
+    size_t i = size_t(_y)*_texture.width() + _x;
+    if (_texture.getOptions().pixelFormat == PixelFormat::FLOAT) {
+        return reinterpret_cast<const float*>(_texture.bufferData())[i];
+    }
+    // Terrarium RGB encoded elevation
+    const GLubyte* rgba = _texture.bufferData() + 4*i;
+    return (rgba[0]*256.0f + rgba[1] + rgba[2]/256.0f) - 32768.0f;
+}
+
+std::shared_ptr<TileData> ContourSource::parse(const TileTask& _task) const {
+    bool complete = true;
+    return parse(_task, complete);
+}
+
+std::shared_ptr<TileData> ContourSource::parse(const TileTask& _task, bool& _complete) const {
+    auto& task = static_cast<const ContourTileTask&>(_task);
+    TileID tileId = task.tileId();
+
+    auto texture = task.texture;
+    if (!texture && task.rawTileData) {
+        // decoded texture is shared with elevation source
+        texture = m_demSource->decodeTexture(TileID(tileId.x, tileId.y, tileId.z), *task.rawTileData);
+    }
+    if (!texture || !texture->bufferData()) {
+        LOGW("No elevation data for contour tile %s", tileId.toString().c_str());
+        return nullptr;
+    }
+
+    auto tileData = std::make_shared<TileData>();
+    tileData->layers.emplace_back("");
+
+    float interval = intervalForZoom(tileId.s);
+    if (!(interval > 0)) { return tileData; }
+
+    const int w = texture->width(), h = texture->height();
+
+    // adjacent DEM tiles by offset; tile y increases to the south, texture rows to the north
+    std::shared_ptr<Texture> neighbors[3][3];
+    const int n = 1 << tileId.z;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int y = tileId.y - dy;
+            if ((dx == 0 && dy == 0) || y < 0 || y >= n) { continue; }
+            // only read for borders, so not marked as recently used
+            auto neighbor = m_demSource->peekTexture(TileID((tileId.x + dx + n) % n, y, tileId.z));
+            if (neighbor && neighbor->bufferData() && neighbor->width() == w && neighbor->height() == h &&
+                neighbor->getOptions().pixelFormat == texture->getOptions().pixelFormat) {
+                neighbors[dy + 1][dx + 1] = std::move(neighbor);
+            } else {
+                _complete = false;
+            }
+        }
+    }
+
+    // sample (_x, _y) of padded grid from this tile or a neighbor; missing neighbors extend edge samples
+    auto sample = [&](int _x, int _y) {
+        int dx = _x < 0 ? -1 : (_x >= w ? 1 : 0), dy = _y < 0 ? -1 : (_y >= h ? 1 : 0);
+        if ((dx || dy) && neighbors[dy + 1][dx + 1]) {
+            return demSample(*neighbors[dy + 1][dx + 1], _x - dx*w, _y - dy*h);
+        }
+        return demSample(*texture, std::min(std::max(_x, 0), w - 1), std::min(std::max(_y, 0), h - 1));
+    };
+
+    const int W = w + 2, H = h + 2;
+    std::vector<float> grid(size_t(W)*H);
+    for (int j = 0; j < H; j += H - 1) {
+        for (int i = 0; i < W; i++) { grid[size_t(j)*W + i] = sample(i - 1, j - 1); }
+    }
+    for (int j = 1; j < H - 1; j++) {
+        grid[size_t(j)*W] = sample(-1, j - 1);
+        grid[size_t(j)*W + W - 1] = sample(w, j - 1);
+    }
+
+    // skip flat tiles (e.g. ocean) using min/max pyramid and border
+    if (auto pyramid = static_cast<ElevationPyramid*>(texture->userData.get())) {
+        glm::vec2 range = pyramid->minMax();
+        for (int j = 0; j < H; j++) {
+            for (int i = 0; i < W; i += (j == 0 || j == H - 1) ? 1 : W - 1) {
+                float v = grid[size_t(j)*W + i];
+                range = glm::vec2(std::min(range.x, v), std::max(range.y, v));
+            }
+        }
+        if (std::floor(range.x/interval) == std::floor(range.y/interval)) { return tileData; }
+    }
+
+    if (texture->getOptions().pixelFormat == PixelFormat::FLOAT) {
+        auto elev = reinterpret_cast<const float*>(texture->bufferData());
+        for (int j = 0; j < h; j++) {
+            std::copy(elev + size_t(j)*w, elev + size_t(j + 1)*w, &grid[size_t(j + 1)*W + 1]);
+        }
+    } else {
+        for (int j = 0; j < h; j++) {
+            for (int i = 0; i < w; i++) { grid[size_t(j + 1)*W + i + 1] = demSample(*texture, i, j); }
+        }
+    }
+
+    buildContoursBordered(grid.data(), w, h, interval, m_indexInterval, m_id, tileData->layers.back());
+    return tileData;
+}
+
+namespace {
+
+struct ContourSegment {
+    int level;
+    // grid edges crossed at start and end; higher ground is on the left
+    int start, end;
+    glm::vec2 p0, p1;
+};
+
+}
+
+// append parts of _line within tile bounds to _lines
+static void clipLine(Line&& _line, std::vector<Line>& _lines) {
+    auto inside = [](glm::vec2 p) { return p.x >= 0 && p.x <= 1 && p.y >= 0 && p.y <= 1; };
+    if (std::all_of(_line.begin(), _line.end(), inside)) {
+        _lines.push_back(std::move(_line));
+        return;
+    }
+
+    Line part;
+    for (size_t n = 0; n + 1 < _line.size(); n++) {
+        // Liang-Barsky
+        glm::vec2 a = _line[n], d = _line[n+1] - a;
+        float t0 = 0, t1 = 1;
+        bool visible = true;
+        auto clip = [&](float p, float q) {
+            if (p == 0) {
+                visible &= q >= 0;
+            } else if (p < 0) {
+                t0 = std::max(t0, q/p);
+            } else {
+                t1 = std::min(t1, q/p);
+            }
+        };
+        clip(-d.x, a.x);
+        clip(d.x, 1 - a.x);
+        clip(-d.y, a.y);
+        clip(d.y, 1 - a.y);
+        if (!visible || t0 > t1) { continue; }
+
+        if (t0 > 0 || part.empty()) {
+            if (part.size() > 1) { _lines.push_back(std::move(part)); }
+            part.clear();
+            part.push_back(a + t0*d);
+        }
+        part.push_back(a + t1*d);
+        if (t1 < 1) {
+            if (part.size() > 1) { _lines.push_back(std::move(part)); }
+            part.clear();
+        }
+    }
+    if (part.size() > 1) { _lines.push_back(std::move(part)); }
+}
+
+void ContourSource::buildContours(const float* _elev, int _width, int _height, float _interval,
+                                  int _indexInterval, int32_t _sourceId, Layer& _layer) {
+
+    if (_width <= 0 || _height <= 0) { return; }
+
+    // pad with copies of edge samples, so lines reach tile edges
+    const int W = _width + 2, H = _height + 2;
+    std::vector<float> grid(size_t(W)*H);
+    for (int j = 0; j < H; j++) {
+        const float* row = _elev + size_t(std::min(std::max(j - 1, 0), _height - 1))*_width;
+        float* out = &grid[size_t(j)*W];
+        std::copy(row, row + _width, out + 1);
+        out[0] = out[1];
+        out[W - 1] = out[W - 2];
+    }
+    buildContoursBordered(grid.data(), _width, _height, _interval, _indexInterval, _sourceId, _layer);
+}
+
+void ContourSource::buildContoursBordered(const float* _grid, int _width, int _height, float _interval,
+                                          int _indexInterval, int32_t _sourceId, Layer& _layer) {
+
+    if (_width <= 0 || _height <= 0 || !(_interval > 0)) { return; }
+
+    // samples in units of interval at pixel centers; border samples lie outside tile bounds
+    const int W = _width + 2, H = _height + 2;
+    const float scale = 1/_interval;
+    std::vector<float> grid(size_t(W)*H), xs(W), ys(H);
+    for (size_t n = 0; n < grid.size(); n++) { grid[n] = _grid[n]*scale; }
+    for (int i = 0; i < W; i++) { xs[i] = (i - 0.5f)/_width; }
+    for (int j = 0; j < H; j++) { ys[j] = (j - 0.5f)/_height; }
+
+    // level k lies between samples with different band = floor(sample): sample >= k iff band >= k, so most
+    //  cells are rejected with integer compares and level tests can't disagree with rounding of floor()
+    std::vector<int> bands(grid.size());
+    for (size_t n = 0; n < grid.size(); n++) {
+        float v = grid[n];
+        bands[n] = v == v ? int(std::floor(v)) : INT_MIN;  // NaN (no data)
+    }
+
+    // edge ids: horizontal edges (i,j)-(i+1,j) first, then vertical edges (i,j)-(i,j+1)
+    const int numHEdges = (W - 1)*H;
+    const int numEdges = numHEdges + W*(H - 1);
+
+    // marching squares - a single pass over cells handles all levels crossing each cell
+    std::vector<ContourSegment> segments;
+    int minLevel = INT_MAX, maxLevel = INT_MIN;
+    for (int j = 0; j + 1 < H; j++) {
+        const float* row0 = &grid[size_t(j)*W];
+        const float* row1 = row0 + W;
+        const int* band0 = &bands[size_t(j)*W];
+        const int* band1 = band0 + W;
+        for (int i = 0; i + 1 < W; i++) {
+            // corners counter-clockwise from south-west; edge e goes from corner e to corner e+1
+            const int b[4] = { band0[i], band0[i+1], band1[i+1], band1[i] };
+            if (b[0] == b[1] && b[0] == b[2] && b[0] == b[3]) { continue; }
+            int lo = std::min(std::min(b[0], b[1]), std::min(b[2], b[3]));
+            int hi = std::max(std::max(b[0], b[1]), std::max(b[2], b[3]));
+            if (lo == INT_MIN) { continue; }
+
+            const float v[4] = { row0[i], row0[i+1], row1[i+1], row1[i] };
+            const glm::vec2 corner[4] = { {xs[i], ys[j]}, {xs[i+1], ys[j]}, {xs[i+1], ys[j+1]}, {xs[i], ys[j+1]} };
+            const int edges[4] = { j*(W-1) + i, numHEdges + j*W + i+1, (j+1)*(W-1) + i, numHEdges + j*W + i };
+
+            // levels with lo < level <= hi
+            for (int k = lo + 1; k <= hi; k++) {
+                bool above[4];
+                int crossed[4], numCrossed = 0;
+                for (int c = 0; c < 4; c++) { above[c] = b[c] >= k; }
+                for (int e = 0; e < 4; e++) {
+                    if (above[e] != above[(e+1) & 3]) { crossed[numCrossed++] = e; }
+                }
+
+                auto crossing = [&](int e) {
+                    int c0 = e, c1 = (e+1) & 3;
+                    float t = (k - v[c0])/(v[c1] - v[c0]);
+                    return corner[c0] + t*(corner[c1] - corner[c0]);
+                };
+                // start on the edge going from above to below level, so higher ground is on the left
+                auto addSegment = [&](int e0, int e1) {
+                    if (!above[e0]) { std::swap(e0, e1); }
+                    segments.push_back({k, edges[e0], edges[e1], crossing(e0), crossing(e1)});
+                };
+
+                if (numCrossed == 2) {
+                    addSegment(crossed[0], crossed[1]);
+                } else {
+                    // saddle: cut off the corners on the other side of level from cell center
+                    bool centerAbove = 0.25f*(v[0] + v[1] + v[2] + v[3]) >= k;
+                    for (int c = 0; c < 4; c++) {
+                        if (above[c] != centerAbove) { addSegment((c+3) & 3, c); }
+                    }
+                }
+            }
+            minLevel = std::min(minLevel, lo + 1);
+            maxLevel = std::max(maxLevel, hi);
+        }
+    }
+    if (segments.empty()) { return; }
+
+    // group segments by level
+    std::vector<int> levelStart(maxLevel - minLevel + 2, 0);
+    for (auto& seg : segments) { levelStart[seg.level - minLevel + 1]++; }
+    for (size_t l = 1; l < levelStart.size(); l++) { levelStart[l] += levelStart[l-1]; }
+    std::vector<int> order(segments.size());
+    {
+        std::vector<int> fill(levelStart.begin(), levelStart.end() - 1);
+        for (size_t s = 0; s < segments.size(); s++) { order[fill[segments[s].level - minLevel]++] = int(s); }
+    }
+
+    // stitch segments into lines: each edge starts and ends at most one segment of a level; arrays are
+    //  reset by visiting the level's segments again rather than clearing
+    std::vector<int> startSeg(numEdges, -1);
+    std::vector<uint8_t> hasPrev(numEdges, 0);
+
+    for (int l = 0; l + 1 < int(levelStart.size()); l++) {
+        int begin = levelStart[l], end = levelStart[l+1];
+        if (begin == end) { continue; }
+
+        for (int n = begin; n < end; n++) {
+            auto& seg = segments[order[n]];
+            startSeg[seg.start] = order[n];
+            hasPrev[seg.end] = 1;
+        }
+
+        Feature feature(_sourceId);
+        feature.geometryType = GeometryType::lines;
+
+        auto trace = [&](int s) {
+            Line line;
+            int first = segments[s].start;
+            while (true) {
+                auto& seg = segments[s];
+                line.push_back(seg.p0);
+                startSeg[seg.start] = -1;
+                if (seg.end == first) {
+                    line.push_back(line.front());
+                    break;
+                }
+                s = startSeg[seg.end];
+                if (s < 0) {
+                    line.push_back(seg.p1);
+                    break;
+                }
+            }
+            clipLine(std::move(line), feature.lines);
+        };
+
+        // open lines start at tile edges, then the remaining segments form closed loops
+        for (int n = begin; n < end; n++) {
+            auto& seg = segments[order[n]];
+            if (!hasPrev[seg.start] && startSeg[seg.start] == order[n]) { trace(order[n]); }
+        }
+        for (int n = begin; n < end; n++) {
+            auto& seg = segments[order[n]];
+            if (startSeg[seg.start] == order[n]) { trace(order[n]); }
+        }
+        for (int n = begin; n < end; n++) { hasPrev[segments[order[n]].end] = 0; }
+        if (feature.lines.empty()) { continue; }
+
+        int k = minLevel + l;
+        feature.props.set("elevation", double(k)*_interval);
+        if (k % _indexInterval == 0) { feature.props.set("index", 1.0); }
+        _layer.features.push_back(std::move(feature));
+    }
+}
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "data/tileSource.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Tangram {
+
+class RasterSource;
+class TileDataCache;
+struct Layer;
+
+/* Vector contour lines generated from a DEM RasterSource
+ *
+ * Tiles are traced with marching squares over the elevation grid on the tile worker, at an interval chosen
+ * by zoom, and emitted as line features with `elevation` (meters) and, for every indexInterval-th line,
+ * `index` properties. Raw DEM tiles are loaded through the elevation source (sharing its data sources and
+ * memory cache) or taken from its decoded textures. A 1 sample border is read from adjacent DEM tiles in
+ * the elevation source's raster cache so lines meet at tile edges; where a neighbor isn't loaded, edge
+ * samples are extended instead and lines may not meet exactly. Generated TileData is cached in the
+ * TileDataCache if enabled, else in a small cache of the source (only tiles built with all neighbors).
+ */
+class ContourSource : public TileSource {
+public:
+
+    // (min zoom, interval in meters), sorted by zoom
+    using Intervals = std::vector<std::pair<int, float>>;
+
+    ContourSource(const std::string& _name, std::shared_ptr<RasterSource> _demSource,
+                  Intervals _intervals, int _indexInterval, ZoomOptions _zoomOptions = {});
+
+    std::shared_ptr<TileTask> createTask(TileID _tile) override;
+
+    void loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override;
+
+    void cancelLoadingTile(TileTask& _task) override;
+
+    std::shared_ptr<TileData> parse(const TileTask& _task) const override;
+
+    // contour interval for tiles displayed at _zoom; 0 for no contours
+    float intervalForZoom(int _zoom) const;
+
+    void clearData() override;
+
+    const std::shared_ptr<RasterSource>& demSource() const { return m_demSource; }
+
+    uint64_t configHash() const { return m_configHash; }
+
+    /* Add contour features to _layer for row-major _width x _height elevation grid with row 0 at south
+     * edge. Samples are at pixel centers; edge rows and columns are extended to tile bounds. */
+    static void buildContours(const float* _elev, int _width, int _height, float _interval,
+                              int _indexInterval, int32_t _sourceId, Layer& _layer);
+
+    /* As above for a (_width + 2) x (_height + 2) grid including a 1 sample border from adjacent tiles;
+     * lines are clipped to tile bounds. */
+    static void buildContoursBordered(const float* _grid, int _width, int _height, float _interval,
+                                      int _indexInterval, int32_t _sourceId, Layer& _layer);
+
+    // used if TileManager has no TileDataCache
+    static constexpr size_t CACHE_BYTES = 8*1024*1024;
+
+private:
+
+    friend class ContourTileTask;
+
+    // _complete is cleared if a neighbor tile was missing for the border
+    std::shared_ptr<TileData> parse(const TileTask& _task, bool& _complete) const;
+
+    std::shared_ptr<RasterSource> m_demSource;
+    Intervals m_intervals;
+    int m_indexInterval;
+    uint64_t m_configHash = 0;
+    std::shared_ptr<TileDataCache> m_cache;
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "util/asyncWorker.h"
 #include "util/zlibHelper.h"
+#include "debug/trace.h"
 #include "log.h"
 #include "platform.h"
 #include "util/url.h"
@@ -164,7 +165,10 @@ bool MBTilesDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb
             // RasterTileTask::hasData() doesn't check if rawTileData is empty - it probably should, but
             //  let's not set rawTileData to empty vector, to match NetworkDataSource behavior
             int64_t createdAt = 0;
-            getTileData(tileId, *tileData, createdAt, task.offlineId);
+            {
+                TRACE_SCOPE_TILE("DB query", tileId);
+                getTileData(tileId, *tileData, createdAt, task.offlineId);
+            }
             LOGTO("<<< DB query for %s %s%s", _task->source() ? _task->source()->name().c_str() : "?",
                   tileId.toString().c_str(), tileData->empty() ? " (not found)" : "");
 
@@ -16,7 +16,14 @@ struct RawCache {
     std::mutex m_mutex;
 
     // LRU in-memory cache for raw tile data
-    using CacheEntry = std::pair<TileID, std::shared_ptr<std::vector<char>>>;
+    struct CacheEntry {
+        TileID id;
+        std::shared_ptr<std::vector<char>> data;
+        // processed form of data (e.g. transcoded raster), dropped with it
+        std::shared_ptr<std::vector<char>> processed;
+
+        int size() const { return int(data->size()) + (processed ? int(processed->size()) : 0); }
+    };
     using CacheList = std::list<CacheEntry>;
     using CacheMap = std::unordered_map<TileID, typename CacheList::iterator>;
 
@@ -37,7 +44,7 @@ struct RawCache {
         if (it != m_cacheMap.end()) {
             // Move cached entry to start of list
             m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
-            _task.rawTileData = m_cacheList.front().second;
+            _task.rawTileData = m_cacheList.front().data;
 
             return true;
         }
@@ -51,11 +58,43 @@ struct RawCache {
         std::lock_guard<std::mutex> lock(m_mutex);
         TileID id(tileID.x, tileID.y, tileID.z);
 
-        m_cacheList.push_front({id, rawDataRef});
+        m_cacheList.push_front({id, rawDataRef, nullptr});
         m_cacheMap[id] = m_cacheList.begin();
 
         m_usage += rawDataRef->size();
 
+        limitUsage();
+    }
+
+    // processed data is only kept while rawData is the cached data for tile
+    void putProcessed(const TileID& tileID, const std::vector<char>& rawData,
+                      std::shared_ptr<std::vector<char>> processed) {
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TileID id(tileID.x, tileID.y, tileID.z);
+
+        auto it = m_cacheMap.find(id);
+        if (it == m_cacheMap.end() || it->second->data.get() != &rawData) { return; }
+
+        auto& entry = *it->second;
+        m_usage -= entry.size();
+        entry.processed = processed;
+        m_usage += entry.size();
+
+        limitUsage();
+    }
+
+    std::shared_ptr<std::vector<char>> getProcessed(const TileID& tileID, const std::vector<char>& rawData) {
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        TileID id(tileID.x, tileID.y, tileID.z);
+
+        auto it = m_cacheMap.find(id);
+        if (it == m_cacheMap.end() || it->second->data.get() != &rawData) { return nullptr; }
+        return it->second->processed;
+    }
+
+    void limitUsage() {
         while (m_usage > m_maxUsage) {
             if (m_cacheList.empty()) {
                 LOGE("Error: invalid cache state!");
@@ -67,9 +106,9 @@ struct RawCache {
             //        double(m_cacheUsage) / (1024*1024));
 
             auto& entry = m_cacheList.back();
-            m_usage -= entry.second->size();
+            m_usage -= entry.size();
 
-            m_cacheMap.erase(entry.first);
+            m_cacheMap.erase(entry.id);
             m_cacheList.pop_back();
         }
     }
@@ -133,6 +172,17 @@ bool MemoryCacheDataSource::loadTileData(std::shared_ptr<TileTask> _task, TileTa
     return false;
 }
 
+void MemoryCacheDataSource::cacheProcessedData(const TileID& _tileId, const std::vector<char>& _rawData,
+                                               std::shared_ptr<std::vector<char>> _processed) {
+    // disk caches further down the chain only keep the original data
+    m_cache->putProcessed(_tileId, _rawData, _processed);
+}
+
+std::shared_ptr<std::vector<char>> MemoryCacheDataSource::getProcessedData(const TileID& _tileId,
+                                                                          const std::vector<char>& _rawData) {
+    return m_cache->getProcessed(_tileId, _rawData);
+}
+
 void MemoryCacheDataSource::clear() {
     m_cache->clear();
 
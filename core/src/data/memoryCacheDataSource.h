@@ -14,6 +14,12 @@ public:
 
     void clear() override;
 
+    void cacheProcessedData(const TileID& _tileId, const std::vector<char>& _rawData,
+                            std::shared_ptr<std::vector<char>> _processed) override;
+
+    std::shared_ptr<std::vector<char>> getProcessedData(const TileID& _tileId,
+                                                        const std::vector<char>& _rawData) override;
+
     /* @_cacheSize: Set size of in-memory cache for tile data in bytes.
      * This cache holds unprocessed tile data for fast recreation of recently used tiles.
      */
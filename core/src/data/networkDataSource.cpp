@@ -1,5 +1,6 @@
 #include "data/networkDataSource.h"
 
+#include "debug/trace.h"
 #include "log.h"
 #include "platform.h"
 #include "util/mapProjection.h"
@@ -7,6 +8,8 @@
 #include "scene/scene.h"
 #include "js/JavaScript.h"
 
+#include <limits>
+
 namespace Tangram {
 
 NetworkDataSource::NetworkDataSource(DataSourceContext& _context, std::string url, UrlOptions options) :
@@ -122,7 +125,9 @@ bool NetworkDataSource::loadTileData(std::shared_ptr<TileTask> task, TileTaskCb
 
     LOGTO(">>> Url request for %s %s",
           task->source() ? task->source()->name().c_str() : "?", task->tileId().toString().c_str());
+    TRACE_ASYNC_BEGIN("fetch", uint64_t(uintptr_t(task.get())), tileId);
     UrlCallback onRequestFinish = [task, callback, url](UrlResponse&& response) mutable {
+        TRACE_ASYNC_END("fetch", uint64_t(uintptr_t(task.get())), task->tileId());
         LOGTO("<<< Url request for %s %s%s", task->source() ? task->source()->name().c_str() : "?",
               task->tileId().toString().c_str(), task->isCanceled() ? " (canceled)" : "");
 
@@ -145,8 +150,15 @@ bool NetworkDataSource::loadTileData(std::shared_ptr<TileTask> task, TileTaskCb
         callback.func(std::move(task));
     };
 
+    // let platform dispatch pending requests by current tile priority; canceled requests go last
+    HttpOptions httpOptions = m_options.httpOptions;
+    httpOptions.priority = [weakTask = std::weak_ptr<TileTask>(task)]() {
+        auto t = weakTask.lock();
+        return t && !t->isCanceled() ? t->getPriority() : std::numeric_limits<double>::infinity();
+    };
+
     auto& dlTask = static_cast<BinaryTileTask&>(*task);
-    dlTask.urlRequestHandle = m_context.getPlatform().startUrlRequest(url, m_options.httpOptions,
+    dlTask.urlRequestHandle = m_context.getPlatform().startUrlRequest(url, httpOptions,
                                                                       std::move(onRequestFinish));
     return true;
 }
@@ -0,0 +1,183 @@
+#include "data/rasterCache.h"
+
+#include "log.h"
+
+namespace Tangram {
+
+std::shared_ptr<Texture> RasterCache::get(const TileID& _tileId) {
+    Evicted evicted;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return getLocked(key(_tileId), evicted);
+}
+
+std::shared_ptr<Texture> RasterCache::peek(const TileID& _tileId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(key(_tileId));
+    return it != m_entries.end() ? it->second.texture.lock() : nullptr;
+}
+
+std::shared_ptr<Texture> RasterCache::getOrDecode(const TileID& _tileId, const Decoder& _decode) {
+    TileID id = key(_tileId);
+    std::shared_future<std::shared_ptr<Texture>> pending;
+    std::promise<std::shared_ptr<Texture>> promise;
+    {
+        Evicted evicted;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto texture = getLocked(id, evicted)) { return texture; }
+
+        auto it = m_pending.find(id);
+        if (it != m_pending.end()) {
+            pending = it->second;
+            m_waits++;
+        } else {
+            m_pending.emplace(id, promise.get_future().share());
+            m_decodes++;
+        }
+    }
+    // another thread is decoding this tile
+    if (pending.valid()) { return pending.get(); }
+
+    auto decoded = _decode();
+
+    std::shared_ptr<Texture> texture;
+    {
+        Evicted evicted;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (decoded) { texture = addLocked(id, std::move(decoded), evicted); }
+        m_pending.erase(id);
+    }
+    promise.set_value(texture);
+    return texture;
+}
+
+std::shared_ptr<Texture> RasterCache::find(ProjectedMeters _meters, TileID& _tileIdOut) {
+    Evicted evicted;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.empty()) { return nullptr; }
+
+    // TileIDs are ordered by decreasing zoom
+    TileID tileId = MapProjection::projectedMetersTile(_meters, m_entries.begin()->first.z);
+    auto minz = m_entries.rbegin()->first.z;
+    do {
+        if (auto texture = getLocked(tileId, evicted)) {
+            _tileIdOut = tileId;
+            return texture;
+        }
+        tileId = tileId.getParent();
+    } while (tileId.z >= minz);
+
+    return nullptr;
+}
+
+std::shared_ptr<Texture> RasterCache::getLocked(const TileID& _id, Evicted& _evicted) {
+    auto it = m_entries.find(_id);
+    if (it == m_entries.end()) { return nullptr; }
+
+    auto texture = it->second.texture.lock();
+    if (texture) {
+        m_hits++;
+        retainLocked(_id, it->second, texture, _evicted);
+    }
+    return texture;
+}
+
+std::shared_ptr<Texture> RasterCache::addLocked(const TileID& _id, std::unique_ptr<Texture> _texture,
+                                                Evicted& _evicted) {
+    auto it = m_entries.find(_id);
+    if (it == m_entries.end()) {
+        it = m_entries.emplace(_id, Entry{}).first;
+    } else if (auto texture = it->second.texture.lock()) {
+        return texture;
+    } else {
+        // previous texture is being deleted; its deleter will not find it after replacement
+        m_bytes -= it->second.bytes;
+    }
+    auto& entry = it->second;
+
+    std::weak_ptr<RasterCache> cache = shared_from_this();
+    auto texture = std::shared_ptr<Texture>(_texture.release(), [cache, _id](Texture* t) {
+        if (auto c = cache.lock()) { c->remove(_id, t); }
+        delete t;
+    });
+
+    entry.texture = texture;
+    entry.ptr = texture.get();
+    entry.bytes = texture->memoryUsage();
+    entry.retained = false;
+    m_bytes += entry.bytes;
+    LOGV("%d - added %s", m_entries.size(), _id.toString().c_str());
+
+    retainLocked(_id, entry, texture, _evicted);
+    return texture;
+}
+
+void RasterCache::retainLocked(const TileID& _id, Entry& _entry, std::shared_ptr<Texture> _texture,
+                               Evicted& _evicted) {
+    if (_entry.bytes > m_maxBytes) { return; }
+
+    if (_entry.retained) {
+        m_retained.splice(m_retained.begin(), m_retained, _entry.retainedIt);
+        return;
+    }
+    m_retained.push_front({_id, std::move(_texture)});
+    _entry.retained = true;
+    _entry.retainedIt = m_retained.begin();
+    m_retainedBytes += _entry.bytes;
+
+    limitRetained(_evicted);
+}
+
+void RasterCache::limitRetained(Evicted& _evicted) {
+    // texture deleters lock m_mutex, so evicted textures are released by caller after unlocking
+    while (m_retainedBytes > m_maxBytes && !m_retained.empty()) {
+        auto& retained = m_retained.back();
+        auto& entry = m_entries[retained.id];
+        entry.retained = false;
+        m_retainedBytes -= entry.bytes;
+        _evicted.push_back(std::move(retained.texture));
+        m_retained.pop_back();
+        m_evictions++;
+    }
+}
+
+void RasterCache::remove(const TileID& _id, Texture* _texture) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(_id);
+    // entry may have been replaced by a new texture for the same tile
+    if (it == m_entries.end() || it->second.ptr != _texture) { return; }
+
+    m_bytes -= it->second.bytes;
+    m_entries.erase(it);
+    LOGV("%d - remove %s", m_entries.size(), _id.toString().c_str());
+}
+
+void RasterCache::setMaxBytes(size_t _maxBytes) {
+    Evicted evicted;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxBytes = _maxBytes;
+    limitRetained(evicted);
+}
+
+void RasterCache::clear() {
+    RetainedList retained;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& entry : m_entries) { entry.second.retained = false; }
+    m_retained.swap(retained);
+    m_retainedBytes = 0;
+}
+
+RasterCache::Stats RasterCache::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats;
+    stats.entries = m_entries.size();
+    stats.bytes = m_bytes;
+    stats.retainedBytes = m_retainedBytes;
+    stats.maxBytes = m_maxBytes;
+    stats.hits = m_hits;
+    stats.decodes = m_decodes;
+    stats.waits = m_waits;
+    stats.evictions = m_evictions;
+    return stats;
+}
+
+}
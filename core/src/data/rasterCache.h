@@ -0,0 +1,100 @@
+#pragma once
+
+#include "gl/texture.h"
+#include "tile/tileID.h"
+#include "util/mapProjection.h"
+
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Tangram {
+
+/* Thread-safe cache of decoded raster tile textures
+ *
+ * Holds weak references to all textures in use, so tile workers and main thread share a single decoded
+ * texture per tile, plus strong references to the most recently used textures up to maxBytes (GPU memory
+ * plus CPU copy if kept, e.g., for elevation) so they survive unloading of the tiles using them.
+ * Concurrent requests for the same tile wait for a single decode.
+ */
+class RasterCache : public std::enable_shared_from_this<RasterCache> {
+public:
+
+    using Decoder = std::function<std::unique_ptr<Texture>()>;
+
+    struct Stats {
+        size_t entries = 0;
+        size_t bytes = 0;
+        size_t retainedBytes = 0;
+        size_t maxBytes = 0;
+        uint64_t hits = 0;
+        uint64_t decodes = 0;
+        uint64_t waits = 0;
+        uint64_t evictions = 0;
+    };
+
+    // cached texture for tile, or nullptr
+    std::shared_ptr<Texture> get(const TileID& _tileId);
+
+    // cached texture for tile without retaining it, moving it in LRU order, or counting a hit
+    std::shared_ptr<Texture> peek(const TileID& _tileId);
+
+    // cached texture for tile, calling _decode if not cached and not being decoded by another thread
+    std::shared_ptr<Texture> getOrDecode(const TileID& _tileId, const Decoder& _decode);
+
+    // texture for closest tile containing _meters at highest cached zoom level down to lowest cached zoom
+    std::shared_ptr<Texture> find(ProjectedMeters _meters, TileID& _tileIdOut);
+
+    // limit for recently used textures kept after last external reference is released
+    void setMaxBytes(size_t _maxBytes);
+
+    void clear();
+
+    Stats stats() const;
+
+private:
+
+    struct Retained {
+        TileID id;
+        std::shared_ptr<Texture> texture;
+    };
+    using RetainedList = std::list<Retained>;
+
+    struct Entry {
+        std::weak_ptr<Texture> texture;
+        Texture* ptr = nullptr;
+        size_t bytes = 0;
+        bool retained = false;
+        RetainedList::iterator retainedIt;
+    };
+
+    using Evicted = std::vector<std::shared_ptr<Texture>>;
+
+    static TileID key(const TileID& _tileId) { return TileID(_tileId.x, _tileId.y, _tileId.z); }
+
+    std::shared_ptr<Texture> getLocked(const TileID& _id, Evicted& _evicted);
+    std::shared_ptr<Texture> addLocked(const TileID& _id, std::unique_ptr<Texture> _texture, Evicted& _evicted);
+    void retainLocked(const TileID& _id, Entry& _entry, std::shared_ptr<Texture> _texture, Evicted& _evicted);
+    void limitRetained(Evicted& _evicted);
+    void remove(const TileID& _id, Texture* _texture);
+
+    std::map<TileID, Entry> m_entries;
+    std::map<TileID, std::shared_future<std::shared_ptr<Texture>>> m_pending;
+    RetainedList m_retained;
+
+    size_t m_bytes = 0;
+    size_t m_retainedBytes = 0;
+    size_t m_maxBytes = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_decodes = 0;
+    uint64_t m_waits = 0;
+    uint64_t m_evictions = 0;
+
+    mutable std::mutex m_mutex;
+};
+
+}
@@ -4,7 +4,9 @@
 #include "tile/tile.h"
 #include "tile/tileBuilder.h"
 #include "tile/tileTask.h"
+#include "util/elevationPyramid.h"
 #include "util/mapProjection.h"
+#include "util/textureCompression.h"
 #include "log.h"
 
 namespace Tangram {
@@ -14,7 +16,6 @@ public:
 
     const bool subTask = false;
 
-    std::unique_ptr<Texture> texture;
     std::unique_ptr<Raster> raster;
 
     RasterTileTask(const TileID& _tileId, TileSource* _source, bool _subTask)
@@ -28,16 +29,16 @@ public:
 
     bool hasData() const override {
         // probably should be "return BinaryTileTask::hasData() || ..."
-        return bool(rawTileData) || bool(texture) || bool(raster);
+        return bool(rawTileData) || bool(raster);
     }
 
     void process(TileBuilder& _tileBuilder) override {
         auto source = rasterSource();
         assert(!m_ready);  // shared task previously could be erroneously added to tile worker queue twice
 
-        if (!texture && !raster) {
-            // Decode texture data
-            texture = source->createTexture(m_tileId, *rawTileData);
+        if (!raster) {
+            // Decode texture data, or share texture decoded by another task for the same tile
+            auto texture = source->decodeTexture(m_tileId, *rawTileData);
             if (!texture) {
                 // cancel on decode failure to match behavior of TileTask (and behavior for download failure)
                 //  empty texture will be set in addRaster() if no proxy available
@@ -45,16 +46,13 @@ public:
                 cancel();
                 return;
             }
+            raster = std::make_unique<Raster>(m_tileId, texture);
         }
 
         // Create tile geometries
         if (!subTask) {
-          // make raster available for tile builder; RasterSource texture cache is not thread-safe currently
-          //  so we can't add raster for good until complete() on main thread; note the empty deleter since
-          //  shared_ptr doesn't have a release() method
-          auto ptex = raster ? raster->texture : std::shared_ptr<Texture>(texture.get(), [](auto* t){});
           m_tile = std::make_unique<Tile>(m_tileId, source->id(), source->generation());
-          m_tile->rasters().emplace_back(m_tileId, ptex);
+          m_tile->rasters().emplace_back(m_tileId, raster->texture);
           _tileBuilder.build(*m_tile, *(source->m_tileData), *source);
           m_tile->rasters().pop_back();
         }
@@ -62,11 +60,6 @@ public:
     }
 
     void addRaster(Tile& _tile) {
-        auto source = rasterSource();
-        if (!raster) {
-          auto tex = source->cacheTexture(m_tileId, std::move(texture));
-          raster = std::make_unique<Raster>(m_tileId, tex);
-        }
         _tile.rasters().emplace_back(raster->tileID, raster->texture);
     }
 
@@ -97,7 +90,7 @@ RasterSource::RasterSource(const std::string& _name, std::unique_ptr<DataSource>
     : TileSource(_name, std::move(_sources), _zoomOptions),
       m_texOptions(_options) {
 
-    m_textures = std::make_shared<Cache>();
+    m_textures = std::make_shared<RasterCache>();
     m_emptyTexture = std::make_shared<Texture>(m_texOptions);
 
     GLubyte pixel[4] = { 0, 0, 0, 0 };
@@ -129,10 +122,49 @@ void RasterSource::generateGeometry(bool _generateGeometry) {
 std::unique_ptr<Texture> RasterSource::createTexture(TileID _tile, const std::vector<char>& _rawTileData) {
     if (_rawTileData.empty()) { return nullptr; }
 
+    // format is checked for each tile since compression can be toggled and GL context can change
+    PixelFormat compressFormat = PixelFormat::RGBA;
+    if (m_compressTextures && !m_keepTextureData && !m_texOptions.generateMipmaps) {
+        compressFormat = TextureCompression::formatForHardware();
+    }
+
+    TextureCompression::Header header;
+    if (compressFormat != PixelFormat::RGBA && m_sources) {
+        // compressed texture previously transcoded from this tile's data; decoded again if format differs
+        auto cached = m_sources->getProcessedData(_tile, _rawTileData);
+        auto blocks = cached ? TextureCompression::parse(*cached, header) : nullptr;
+        if (blocks && PixelFormat(header.format) == compressFormat) {
+            auto tex = std::make_unique<Texture>(m_texOptions);
+            size_t length = cached->size() - sizeof(header);
+            if (tex->setCompressedData(compressFormat, header.width, header.height, blocks, length)) {
+                return tex;
+            }
+        }
+    }
+
     auto data = reinterpret_cast<const uint8_t*>(_rawTileData.data());
     auto length = _rawTileData.size();
     auto tex = std::make_unique<Texture>(m_texOptions, !m_keepTextureData);
-    if (!tex->loadImageFromMemory(data, length)) { tex.reset(); }
+    if (!tex->loadImageFromMemory(data, length)) { return nullptr; }
+    // data is kept for elevation, so build min/max pyramid for tile bounds here on worker thread
+    if (m_keepTextureData) {
+        if (auto pyramid = ElevationPyramid::build(*tex)) {
+            tex->userDataSize = pyramid->memoryUsage();
+            tex->userData = std::move(pyramid);
+        }
+    } else if (compressFormat != PixelFormat::RGBA && tex->getOptions().pixelFormat == PixelFormat::RGBA) {
+        auto compressed = std::make_shared<std::vector<char>>(
+            TextureCompression::encode(compressFormat, tex->bufferData(), tex->width(), tex->height()));
+        // not opaque
+        if (compressed->empty()) { return tex; }
+        auto ctex = std::make_unique<Texture>(m_texOptions);
+        ctex->setCompressedData(compressFormat, tex->width(), tex->height(),
+                                reinterpret_cast<const uint8_t*>(&(*compressed)[sizeof(header)]),
+                                compressed->size() - sizeof(header));
+        // keep compressed data beside raw data in memory cache so tile is not decoded and transcoded again
+        if (m_sources) { m_sources->cacheProcessedData(_tile, _rawTileData, compressed); }
+        return ctex;
+    }
     return tex;
 }
 
@@ -166,18 +198,13 @@ std::shared_ptr<RasterTileTask> RasterSource::createRasterTask(TileID _tileId, b
     // First try existing textures cache
     TileID id(_tileId.x, _tileId.y, _tileId.z);
 
-    auto texIt = m_textures->find(id);
-    if (texIt != m_textures->end()) {
-        auto texture = texIt->second.lock();
-
-        if (texture) {
-            LOGV("%d - reuse %s", m_textures->size(), id.toString().c_str());
+    if (auto texture = m_textures->get(id)) {
+        LOGV("reuse %s", id.toString().c_str());
 
-            task->raster = std::make_unique<Raster>(id, texture);
-            // No more loading needed.
-            task->startedLoading();
-            if (subTask) { task->setReady(); }
-        }
+        task->raster = std::make_unique<Raster>(id, texture);
+        // No more loading needed.
+        task->startedLoading();
+        if (subTask) { task->setReady(); }
     }
     return task;
 }
@@ -190,50 +217,22 @@ std::shared_ptr<TileTask> RasterSource::createTask(TileID _tileId) {
     return task;
 }
 
-std::shared_ptr<Texture> RasterSource::cacheTexture(const TileID& _tileId, std::unique_ptr<Texture> _texture) {
-    assert(_texture && _texture->bufferSize() > 0 && _texture.get() != m_emptyTexture.get());
-    TileID id(_tileId.x, _tileId.y, _tileId.z);
-
-    auto& textureEntry = (*m_textures)[id];
-    auto texture = textureEntry.lock();
-    if (texture) {
-        LOGV("%d - drop duplicate %s", m_textures->size(), id.toString().c_str());
-        // The same texture has been loaded in the meantime: Reuse it and drop _texture..
-        return texture;
-    }
-
-    texture = std::shared_ptr<Texture>(_texture.release(),
-                                       [c = std::weak_ptr<Cache>(m_textures), id](auto* t) {
-                                           if (auto cache = c.lock()) {
-                                               cache->erase(id);
-                                               LOGV("%d - remove %s", cache->size(), id.toString().c_str());
-                                           }
-                                           delete t;
-                                       });
-    // Add to cache
-    textureEntry = texture;
-    LOGV("%d - added %s", m_textures->size(), id.toString().c_str());
-
-    return texture;
+std::shared_ptr<Texture> RasterSource::decodeTexture(const TileID& _tileId, const std::vector<char>& _rawTileData) {
+    return m_textures->getOrDecode(_tileId, [&]() { return createTexture(_tileId, _rawTileData); });
 }
 
 std::shared_ptr<Texture> RasterSource::getTexture(TileID _tile) {
-    auto texIt = m_textures->find(_tile);
-    return texIt != m_textures->end() ? texIt->second.lock() : nullptr;
+    return m_textures->get(_tile);
 }
 
-Raster RasterSource::getRaster(ProjectedMeters _meters) {
-    if (m_textures->empty()) { return Raster(NOT_A_TILE, nullptr); }
-
-    TileID tileId = MapProjection::projectedMetersTile(_meters, m_textures->begin()->first.z);
-    auto minz = m_textures->rbegin()->first.z;
-    do {
-        auto tex = getTexture(tileId);
-        if(tex) { return Raster(tileId, tex); }
-        tileId = tileId.getParent();
-    } while(tileId.z >= minz);
+std::shared_ptr<Texture> RasterSource::peekTexture(TileID _tile) {
+    return m_textures->peek(_tile);
+}
 
-    return Raster(NOT_A_TILE, nullptr);
+Raster RasterSource::getRaster(ProjectedMeters _meters) {
+    TileID tileId = NOT_A_TILE;
+    auto texture = m_textures->find(_meters, tileId);
+    return Raster(tileId, texture);
 }
 
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "data/rasterCache.h"
 #include "data/tileSource.h"
 #include "gl/texture.h"
 #include "tile/tileTask.h"
@@ -16,16 +17,17 @@ class RasterTileTask;
 
 class RasterSource : public TileSource {
 
-    using Cache = std::map<TileID, std::weak_ptr<Texture>>;
-    std::shared_ptr<Cache> m_textures;
+    // shared with texture deleters
+    std::shared_ptr<RasterCache> m_textures;
 
     TextureOptions m_texOptions;
 
     std::shared_ptr<Texture> m_emptyTexture;
 
     friend class RasterTileTask;
+    friend class ContourSource;
+    friend class ElevationManager;
     friend class TileSource;
-    friend class FrameInfo;
 protected:
     std::shared_ptr<TileData> m_tileData;
 
@@ -37,12 +39,16 @@ protected:
 
     std::unique_ptr<Texture> createTexture(TileID _tile, const std::vector<char>& _rawTileData);
 
-    std::shared_ptr<Texture> cacheTexture(const TileID& _tileId, std::unique_ptr<Texture> _texture);
+    // decode texture or wait for another worker decoding same tile
+    std::shared_ptr<Texture> decodeTexture(const TileID& _tileId, const std::vector<char>& _rawTileData);
 
 public:
 
     bool m_keepTextureData = false;
 
+    // transcode opaque RGBA tiles to a GPU compressed format, if supported (ignored if m_keepTextureData)
+    bool m_compressTextures = false;
+
     RasterSource(const std::string& _name, std::unique_ptr<DataSource> _sources,
                  TextureOptions _options, TileSource::ZoomOptions _zoomOptions = {});
 
@@ -51,6 +57,14 @@ public:
 
     std::shared_ptr<Texture> getTexture(TileID _tile);
 
+    // getTexture() w/o marking texture as recently used, for lookups repeated every frame
+    std::shared_ptr<Texture> peekTexture(TileID _tile);
+
+    // limit for textures kept after all tiles using them are released
+    void setCacheSize(size_t _bytes) { m_textures->setMaxBytes(_bytes); }
+
+    RasterCache::Stats cacheStats() const { return m_textures->stats(); }
+
     Raster getRaster(ProjectedMeters _meters);
 
     std::shared_ptr<TileTask> createTask(TileID _tile) override;
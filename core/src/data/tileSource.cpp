@@ -8,6 +8,7 @@
 #include "platform.h"
 #include "tile/tileID.h"
 #include "tile/tile.h"
+#include "tile/tileDataCache.h"
 #include "tile/tileTask.h"
 #include "log.h"
 #include "util/geom.h"
@@ -74,6 +75,7 @@ void TileSource::addRasterTasks(TileTask& _task) {
 void TileSource::clearData() {
 
     if (m_sources) { m_sources->clear(); }
+    if (m_overzoomCache) { m_overzoomCache->clear(); }
 
     m_generation++;
 }
@@ -82,7 +84,20 @@ void TileSource::loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) {
 
     assert(_task->tileId().z <= m_zoomOptions.maxZoom);
     if (m_sources) {
-        if (_task->needsLoading()) {
+        // overzoomed tiles reuse data parsed for another styling zoom of the same data tile w/o loading;
+        //  overzoomed TileIDs keep the x,y,z of the data tile, so the whole TileData is shared as is
+        const TileID& id = _task->tileId();
+        bool overzoomed = id.z == m_zoomOptions.maxZoom && id.s > id.z + m_zoomOptions.zoomBias;
+        auto binaryTask = dynamic_cast<BinaryTileTask*>(_task.get());
+        bool reuseData = _task->needsLoading() && overzoomed && !isRaster() && _task->source() == this
+                && binaryTask;
+        if (reuseData && !binaryTask->hasDataCache()) {
+            if (!m_overzoomCache) { m_overzoomCache = std::make_shared<TileDataCache>(OVERZOOM_CACHE_BYTES); }
+            binaryTask->setDataCache(m_overzoomCache);
+        }
+        if (reuseData && binaryTask->loadFromDataCache()) {
+            _cb.func(_task);
+        } else if (_task->needsLoading()) {
             if (m_sources->loadTileData(_task, _cb)) {
                 _task->startedLoading();
             }
@@ -3,13 +3,17 @@
 #include "debug/textDisplay.h"
 #include "gl.h"
 #include "gl/glError.h"
+#include "gl/pixelBufferPool.h"
 #include "gl/primitives.h"
+#include "gl/renderState.h"
 #include "map.h"
 #include "scene/scene.h"
 #include "marker/markerManager.h"
 #include "labels/labelManager.h"
 #include "tile/tileCache.h"
+#include "tile/tileDataCache.h"
 #include "data/rasterSource.h"
+#include "util/elevationPyramid.h"
 
 #include <deque>
 #include <ctime>
@@ -163,17 +167,10 @@ void FrameInfo::draw(RenderState& rs, const View& _view, Map& _map) {
         std::string rasterSizeStr = "Raster cache: ";
         for (const auto& source : scene.tileSources()) {
             if (!source->isRaster()) { continue; }
-            size_t ntex = 0, srcbytes = 0;
-            RasterSource::Cache* srctexs = static_cast<RasterSource*>(source.get())->m_textures.get();
-            for(auto& kv : *srctexs) {
-                auto tex = kv.second.lock();
-                if(tex) {
-                    ++ntex;
-                    srcbytes += tex->bufferSize();  // GL memory
-                    if(tex->bufferData()) { srcbytes += tex->bufferSize(); }  // heap memory
-                }
-            }
-            rasterSizeStr += source->name() + fstring(":%d (%dKB) ", int(ntex), int(srcbytes/1024));
+            auto rc = static_cast<RasterSource*>(source.get())->cacheStats();
+            rasterSizeStr += source->name() + fstring(":%d (%dKB, %dKB/tile, kept:%dKB/%dKB) decoded:%d shared:%d evicted:%d ",
+                int(rc.entries), int(rc.bytes/1024), int(rc.entries ? rc.bytes/rc.entries/1024 : 0),
+                int(rc.retainedBytes/1024), int(rc.maxBytes/1024), int(rc.decodes), int(rc.waits), int(rc.evictions));
         }
 
         debuginfos.push_back(fstring("zoom:%.3f; base:%.3f (d:%.0fm, h:%.0fm); pitch:%.2fdeg",
@@ -184,6 +181,35 @@ void FrameInfo::draw(RenderState& rs, const View& _view, Map& _map) {
         debuginfos.push_back(fstring("tile cache:%d (%dKB) (max:%dKB)", tileCache.getNumEntries(),
             tileCache.getMemoryUsage()/1024, tileCache.cacheSizeLimit()/1024));
         debuginfos.push_back(rasterSizeStr);
+        auto ep = ElevationPyramid::stats();
+        debuginfos.push_back(fstring("culled tiles:%d; elevation pyramids:%d (avg build:%.0fus)",
+            tileManager.numCulledTiles(), int(ep.builds), ep.builds ? double(ep.buildMicros)/ep.builds : 0.0));
+        if (auto& dataCache = tileManager.getTileDataCache()) {
+            auto dc = dataCache->stats();
+            uint64_t lookups = dc.hits + dc.misses;
+            debuginfos.push_back(fstring("tile data cache:%d (%dKB) (max:%dKB); hits:%d/%d (%.0f%%); evicted:%d",
+                int(dc.entries), int(dc.bytes/1024), int(dc.maxBytes/1024), int(dc.hits), int(lookups),
+                lookups ? 100.0*dc.hits/lookups : 0.0, int(dc.evictions)));
+            debuginfos.push_back(fstring("overzoom data reuse:%d; shared parses:%d", int(dc.latestHits), int(dc.waits)));
+        }
+        auto& uploads = rs.uploads;
+        debuginfos.push_back(fstring("gpu upload:%dKB/frame (max:%dKB, budget:%dKB); queued tiles:%d",
+            uploads.lastFrameBytes()/1024, uploads.maxFrameBytes()/1024, uploads.frameBudget()/1024,
+            uploads.queuedTiles()));
+        auto pool = rs.bufferPool.stats();
+        debuginfos.push_back(fstring("buffer pool:%d blocks (%dKB/%dKB); allocs:%d",
+            pool.blocks, pool.usedBytes/1024, pool.blockBytes/1024, pool.liveAllocations));
+        auto pixels = PixelBufferPool::shared().stats();
+        debuginfos.push_back(fstring("pixel buffer pool:%d (%dKB/%dKB); hits:%d/%d",
+            int(pixels.pooledBuffers), int(pixels.pooledBytes/1024), int(pixels.maxBytes/1024),
+            int(pixels.hits), int(pixels.hits + pixels.misses)));
+        auto& stats = rs.frameStats;
+        debuginfos.push_back(fstring("draw calls:%d; uniform updates:%d; texture binds:%d",
+            stats.drawCalls, stats.uniformUpdates, stats.textureBinds));
+        uint32_t fullTriangles = stats.triangles + stats.lodTrianglesSaved;
+        debuginfos.push_back(fstring("triangles:%d; LOD saved:%d (%.0f%%), on proxies:%d",
+            stats.triangles, stats.lodTrianglesSaved,
+            fullTriangles ? 100.0*stats.lodTrianglesSaved/fullTriangles : 0.0, stats.proxyLodTrianglesSaved));
 #ifdef DEBUG
 #ifdef TANGRAM_LINUX // || defined(TANGRAM_ANDROID) -- also supported on Android
         struct mallinfo2 mi;
@@ -0,0 +1,211 @@
+#include "debug/trace.h"
+
+#include "tile/tileID.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#define TRACE_BUFFER_SIZE (1 << 14)
+
+namespace Tangram {
+namespace Trace {
+
+std::atomic<bool> s_enabled{false};
+
+struct Event {
+    const char* name;
+    int64_t ts;  // nanoseconds
+    union {
+        uint64_t id;
+        double value;
+    };
+    int32_t x, y;
+    int8_t z, s;
+    char phase;
+    bool hasTile;
+};
+
+// single producer ring buffer: only the owning thread writes events and advances head
+struct ThreadBuffer {
+    Event events[TRACE_BUFFER_SIZE];
+    std::atomic<uint64_t> head{0};
+    // events before this position were cleared; written under s_mutex
+    uint64_t tail = 0;
+    uint32_t tid = 0;
+    std::string name;
+};
+
+static std::mutex s_mutex;
+static std::vector<std::shared_ptr<ThreadBuffer>> s_buffers;
+static uint32_t s_nextTid = 1;
+static const auto s_startTime = std::chrono::steady_clock::now();
+
+// buffers are allocated on first event, so threads that are never traced cost nothing
+static thread_local std::shared_ptr<ThreadBuffer> t_buffer;
+static thread_local std::string t_threadName;
+
+static ThreadBuffer& threadBuffer() {
+    if (!t_buffer) {
+        t_buffer = std::make_shared<ThreadBuffer>();
+        std::lock_guard<std::mutex> lock(s_mutex);
+        t_buffer->tid = s_nextTid++;
+        t_buffer->name = t_threadName;
+        s_buffers.push_back(t_buffer);
+    }
+    return *t_buffer;
+}
+
+static Event& record(char _phase, const char* _name) {
+    auto& buffer = threadBuffer();
+    uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    auto& event = buffer.events[head & (TRACE_BUFFER_SIZE - 1)];
+    event.phase = _phase;
+    event.name = _name;
+    event.ts = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - s_startTime).count();
+    event.hasTile = false;
+    event.id = 0;
+    return event;
+}
+
+static void commit() {
+    auto& buffer = threadBuffer();
+    buffer.head.store(buffer.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+static void setTile(Event& _event, const TileID& _tile) {
+    _event.hasTile = true;
+    _event.x = _tile.x;
+    _event.y = _tile.y;
+    _event.z = _tile.z;
+    _event.s = _tile.s;
+}
+
+void setEnabled(bool _enabled) {
+    if (_enabled && !enabled()) { clear(); }
+    s_enabled.store(_enabled, std::memory_order_relaxed);
+}
+
+void setThreadName(const char* _name) {
+    t_threadName = _name;
+    if (t_buffer) {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        t_buffer->name = _name;
+    }
+}
+
+void begin(Name _name) {
+    record('B', _name.str);
+    commit();
+}
+
+void begin(Name _name, const TileID& _tile) {
+    setTile(record('B', _name.str), _tile);
+    commit();
+}
+
+void end(Name _name) {
+    record('E', _name.str);
+    commit();
+}
+
+void counter(Name _name, double _value) {
+    record('C', _name.str).value = _value;
+    commit();
+}
+
+void asyncBegin(Name _name, uint64_t _id, const TileID& _tile) {
+    auto& event = record('b', _name.str);
+    setTile(event, _tile);
+    event.id = _id;
+    commit();
+}
+
+void asyncEnd(Name _name, uint64_t _id, const TileID& _tile) {
+    auto& event = record('e', _name.str);
+    setTile(event, _tile);
+    event.id = _id;
+    commit();
+}
+
+void clear() {
+    std::lock_guard<std::mutex> lock(s_mutex);
+    // drop buffers of exited threads
+    for (auto it = s_buffers.begin(); it != s_buffers.end();) {
+        if (it->use_count() == 1) { it = s_buffers.erase(it); }
+        else { ++it; }
+    }
+    for (auto& buffer : s_buffers) { buffer->tail = buffer->head.load(std::memory_order_acquire); }
+}
+
+static void appendEvent(std::string& _out, const Event& _event, uint32_t _tid) {
+    char buf[256];
+    int n = snprintf(buf, sizeof(buf), "{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f",
+                     _event.name, _event.phase, _tid, _event.ts / 1000.0);
+    _out.append(buf, std::min(n, int(sizeof(buf)) - 1));
+
+    if (_event.phase == 'b' || _event.phase == 'e') {
+        n = snprintf(buf, sizeof(buf), ",\"cat\":\"tile\",\"id\":\"0x%llx\"", (unsigned long long)_event.id);
+        _out.append(buf, n);
+    }
+    if (_event.phase == 'C') {
+        n = snprintf(buf, sizeof(buf), ",\"args\":{\"value\":%g}}", _event.value);
+    } else if (_event.hasTile) {
+        n = snprintf(buf, sizeof(buf), ",\"args\":{\"tile\":\"%d/%d/%d/%d\"}}", _event.z, _event.x, _event.y, _event.s);
+    } else {
+        n = snprintf(buf, sizeof(buf), "}");
+    }
+    _out.append(buf, n);
+}
+
+std::string exportJson() {
+    std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&]() { if (!first) { out += ",\n"; } first = false; };
+
+    std::lock_guard<std::mutex> lock(s_mutex);
+    std::vector<Event> events;
+
+    for (auto& buffer : s_buffers) {
+        uint64_t head = buffer->head.load(std::memory_order_acquire);
+        uint64_t start = std::max(buffer->tail, head > TRACE_BUFFER_SIZE ? head - TRACE_BUFFER_SIZE : 0);
+        events.clear();
+        for (uint64_t i = start; i < head; i++) {
+            events.push_back(buffer->events[i & (TRACE_BUFFER_SIZE - 1)]);
+        }
+        // discard events the producer overwrote while we were copying
+        uint64_t newHead = buffer->head.load(std::memory_order_acquire);
+        size_t skip = 0;
+        if (newHead > TRACE_BUFFER_SIZE && newHead - TRACE_BUFFER_SIZE > start) {
+            skip = std::min(size_t(newHead - TRACE_BUFFER_SIZE - start), events.size());
+        }
+
+        if (!buffer->name.empty()) {
+            separator();
+            out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(buffer->tid) +
+                ",\"args\":{\"name\":\"" + buffer->name + "\"}}";
+        }
+
+        // ends whose begin was lost to wraparound would unbalance the thread's slice stack
+        int depth = 0;
+        for (size_t i = skip; i < events.size(); i++) {
+            auto& event = events[i];
+            if (event.phase == 'B') { depth++; }
+            else if (event.phase == 'E') {
+                if (depth == 0) { continue; }
+                depth--;
+            }
+            separator();
+            appendEvent(out, event, buffer->tid);
+        }
+    }
+    out += "]}";
+    return out;
+}
+
+}
+}
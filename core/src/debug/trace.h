@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace Tangram {
+
+struct TileID;
+
+/* Trace - structured event tracing with Chrome trace (chrome://tracing, ui.perfetto.dev) JSON export
+ *
+ * Each thread records into its own fixed size ring buffer, so recording takes no locks; only the oldest
+ * events are lost when a buffer wraps. Event names must be string literals - they are stored by pointer.
+ * When tracing is disabled each TRACE_* site costs a single relaxed load and branch.
+ */
+namespace Trace {
+
+// interned event name - only constructible from string literals
+struct Name {
+    template<size_t N>
+    constexpr Name(const char (&_str)[N]) : str(_str) {}
+    const char* str;
+};
+
+extern std::atomic<bool> s_enabled;
+
+inline bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+// enabling clears previously recorded events
+void setEnabled(bool _enabled);
+
+// name shown for calling thread in trace viewer
+void setThreadName(const char* _name);
+
+void begin(Name _name);
+void begin(Name _name, const TileID& _tile);
+void end(Name _name);
+void counter(Name _name, double _value);
+
+// async spans may begin and end on different threads; _id pairs them
+void asyncBegin(Name _name, uint64_t _id, const TileID& _tile);
+void asyncEnd(Name _name, uint64_t _id, const TileID& _tile);
+
+// events of all threads as Chrome trace event JSON
+std::string exportJson();
+
+void clear();
+
+struct Scope {
+    Scope(Name _name) : name(_name), active(enabled()) { if (active) { begin(name); } }
+    Scope(Name _name, const TileID& _tile) : name(_name), active(enabled()) { if (active) { begin(name, _tile); } }
+    ~Scope() { if (active) { end(name); } }
+    Name name;
+    bool active;
+};
+
+}
+
+}
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+#define TRACE_SCOPE(name) Tangram::Trace::Scope TRACE_CONCAT(_traceScope, __LINE__)(name)
+#define TRACE_SCOPE_TILE(name, tile) Tangram::Trace::Scope TRACE_CONCAT(_traceScope, __LINE__)(name, tile)
+#define TRACE_COUNTER(name, value) do { if (Tangram::Trace::enabled()) { Tangram::Trace::counter(name, value); } } while (0)
+#define TRACE_ASYNC_BEGIN(name, id, tile) do { if (Tangram::Trace::enabled()) { Tangram::Trace::asyncBegin(name, id, tile); } } while (0)
+#define TRACE_ASYNC_END(name, id, tile) do { if (Tangram::Trace::enabled()) { Tangram::Trace::asyncEnd(name, id, tile); } } while (0)
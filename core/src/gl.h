@@ -146,6 +146,8 @@ typedef char            GLchar;
 #define GL_R32F                         0x822E
 #define GL_R32UI                        0x8236
 #define GL_RED_INTEGER                  0x8D94
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGB8_ETC2         0x9274
 
 #define GL_NEAREST                      0x2600
 #define GL_LINEAR                       0x2601
@@ -382,6 +384,12 @@ struct GL {
                               GLenum format, GLenum type,
                               const GLvoid *pixels);
 
+    static void compressedTexImage2D(GLenum target, GLint level,
+                                     GLenum internalFormat,
+                                     GLsizei width, GLsizei height,
+                                     GLint border, GLsizei imageSize,
+                                     const GLvoid *data);
+
     static void generateMipmap(GLenum target);
 
 
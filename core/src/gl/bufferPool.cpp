@@ -0,0 +1,196 @@
+#include "gl/bufferPool.h"
+
+#include "gl/renderState.h"
+
+#include <algorithm>
+
+namespace Tangram {
+
+// keep allocations aligned for vertex attributes
+static constexpr uint32_t ALIGNMENT = 4;
+
+static size_t alignSize(size_t _size) {
+    return (_size + ALIGNMENT - 1) & ~size_t(ALIGNMENT - 1);
+}
+
+static void bindBuffer(RenderState& _rs, GLenum _target, GLuint _buffer) {
+    if (_target == GL_ELEMENT_ARRAY_BUFFER) {
+        _rs.indexBuffer(_buffer);
+    } else {
+        _rs.vertexBuffer(_buffer);
+    }
+}
+
+bool BufferPool::allocateFrom(Block& _block, size_t _size, uint32_t& _offset) {
+    // first fit
+    for (auto it = _block.freeRanges.begin(); it != _block.freeRanges.end(); ++it) {
+        if (it->second < _size) { continue; }
+        _offset = it->first;
+        uint32_t remaining = it->second - _size;
+        _block.freeRanges.erase(it);
+        if (remaining > 0) {
+            _block.freeRanges.emplace(_offset + _size, remaining);
+        }
+        _block.used += _size;
+        _block.allocations++;
+        return true;
+    }
+    return false;
+}
+
+void BufferPool::freeRange(Block& _block, uint32_t _offset, uint32_t _size) {
+    _block.used -= _size;
+    _block.allocations--;
+
+    auto next = _block.freeRanges.lower_bound(_offset);
+    // merge with following range
+    if (next != _block.freeRanges.end() && _offset + _size == next->first) {
+        _size += next->second;
+        next = _block.freeRanges.erase(next);
+    }
+    // merge with preceding range
+    if (next != _block.freeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == _offset) {
+            prev->second += _size;
+            return;
+        }
+    }
+    _block.freeRanges.emplace(_offset, _size);
+}
+
+BufferPool::Allocation BufferPool::allocate(RenderState& _rs, GLenum _target, uint32_t _key,
+                                            const void* _data, size_t _size) {
+    Allocation alloc;
+    if (_size == 0) { return alloc; }
+
+    size_t size = alignSize(_size);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t blockIdx = m_blocks.size();
+    uint32_t offset = 0;
+    for (size_t i = 0; i < m_blocks.size(); ++i) {
+        auto& block = m_blocks[i];
+        if (block.buffer == 0 || block.target != _target || block.key != _key) { continue; }
+        if (allocateFrom(block, size, offset)) {
+            blockIdx = i;
+            break;
+        }
+    }
+
+    if (blockIdx == m_blocks.size()) {
+        // no space left - reuse an empty slot or add a new block
+        auto slot = std::find_if(m_blocks.begin(), m_blocks.end(), [](auto& b) { return b.buffer == 0; });
+        blockIdx = slot - m_blocks.begin();
+        if (slot == m_blocks.end()) { m_blocks.emplace_back(); }
+
+        auto& block = m_blocks[blockIdx];
+        block = Block();
+        block.target = _target;
+        block.key = _key;
+        block.capacity = std::max(m_blockSize, size);
+
+        GL::genBuffers(1, &block.buffer);
+        bindBuffer(_rs, _target, block.buffer);
+        GL::bufferData(_target, block.capacity, nullptr, GL_STATIC_DRAW);
+        m_buffersCreated++;
+
+        block.freeRanges.emplace(0, block.capacity);
+        allocateFrom(block, size, offset);
+    }
+
+    auto& block = m_blocks[blockIdx];
+    bindBuffer(_rs, _target, block.buffer);
+    GL::bufferSubData(_target, offset, _size, _data);
+
+    alloc.buffer = block.buffer;
+    alloc.offset = offset;
+    alloc.size = size;
+    alloc.block = blockIdx;
+    alloc.generation = m_generation;
+    m_totalAllocations++;
+
+    return alloc;
+}
+
+void BufferPool::release(const Allocation& _alloc) {
+    if (!_alloc) { return; }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (_alloc.generation != m_generation) { return; }
+
+    m_released.push_back({_alloc, m_frame});
+}
+
+void BufferPool::flush(RenderState& _rs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_frame++;
+    if (m_released.empty()) { return; }
+
+    auto it = std::partition(m_released.begin(), m_released.end(),
+                             [&](auto& r) { return m_frame - r.frame < FRAME_DELAY; });
+    if (it == m_released.end()) { return; }
+
+    for (auto r = it; r != m_released.end(); ++r) {
+        freeRange(m_blocks[r->alloc.block], r->alloc.offset, r->alloc.size);
+    }
+    m_released.erase(it, m_released.end());
+
+    // delete empty blocks, keeping one block per target and key for reuse
+    for (auto& block : m_blocks) {
+        if (block.buffer == 0 || block.allocations > 0) { continue; }
+        bool hasOther = std::any_of(m_blocks.begin(), m_blocks.end(), [&](auto& b) {
+            return &b != &block && b.buffer != 0 && b.target == block.target && b.key == block.key;
+        });
+        if (!hasOther && block.capacity <= m_blockSize) { continue; }
+
+        if (block.target == GL_ELEMENT_ARRAY_BUFFER) {
+            _rs.indexBufferUnset(block.buffer);
+        } else {
+            _rs.vertexBufferUnset(block.buffer);
+        }
+        GL::deleteBuffers(1, &block.buffer);
+        m_buffersDeleted++;
+        block = Block();
+    }
+}
+
+void BufferPool::invalidate() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_blocks.clear();
+    m_released.clear();
+    m_generation++;
+}
+
+void BufferPool::dispose() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& block : m_blocks) {
+        if (block.buffer != 0) {
+            GL::deleteBuffers(1, &block.buffer);
+            m_buffersDeleted++;
+        }
+    }
+    m_blocks.clear();
+    m_released.clear();
+    m_generation++;
+}
+
+BufferPool::Stats BufferPool::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats;
+    for (auto& block : m_blocks) {
+        if (block.buffer == 0) { continue; }
+        stats.blocks++;
+        stats.blockBytes += block.capacity;
+        stats.usedBytes += block.used;
+        stats.liveAllocations += block.allocations;
+    }
+    stats.totalAllocations = m_totalAllocations;
+    stats.buffersCreated = m_buffersCreated;
+    stats.buffersDeleted = m_buffersDeleted;
+    return stats;
+}
+
+}
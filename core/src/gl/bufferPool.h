@@ -0,0 +1,106 @@
+#pragma once
+
+#include "gl.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace Tangram {
+
+class RenderState;
+
+/* BufferPool - suballocates static mesh buffers from a few large GL buffers
+ *
+ * Vertex data is grouped by vertex stride and index data kept separately; a <Mesh> draws from its range by
+ * offsetting attribute pointers and element offsets, so no base vertex support is required.  Released
+ * ranges are only reused after FRAME_DELAY frames so that pending draws from the GPU never see new data.
+ */
+class BufferPool {
+
+public:
+
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 4*1024*1024;
+    static constexpr uint32_t FRAME_DELAY = 3;
+
+    struct Allocation {
+        GLuint buffer = 0;
+        uint32_t offset = 0;
+        uint32_t size = 0;
+        uint32_t block = 0;
+        uint32_t generation = 0;
+
+        explicit operator bool() const { return buffer != 0; }
+    };
+
+    struct Stats {
+        size_t blocks = 0;
+        size_t blockBytes = 0;
+        size_t usedBytes = 0;
+        size_t liveAllocations = 0;
+        size_t totalAllocations = 0;
+        size_t buffersCreated = 0;
+        size_t buffersDeleted = 0;
+    };
+
+    bool enabled() const { return m_enabled; }
+    void setEnabled(bool _enabled) { m_enabled = _enabled; }
+
+    // Capacity of new blocks; larger allocations get a dedicated block
+    void setBlockSize(size_t _bytes) { m_blockSize = _bytes; }
+
+    // Copy _size bytes of _data into a pooled buffer for _target (GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER);
+    // must be called on the GL thread. Only buffers with the same _target and _key share a block.
+    Allocation allocate(RenderState& _rs, GLenum _target, uint32_t _key, const void* _data, size_t _size);
+
+    // Return range to the pool; may be called from any thread
+    void release(const Allocation& _alloc);
+
+    // Recycle ranges released FRAME_DELAY frames ago and delete empty blocks; called once per frame on GL thread
+    void flush(RenderState& _rs);
+
+    // Forget all GL buffers without deleting them (after GL context loss)
+    void invalidate();
+
+    // Delete all GL buffers; outstanding allocations become invalid
+    void dispose();
+
+    Stats stats() const;
+
+private:
+
+    struct Block {
+        GLuint buffer = 0;
+        GLenum target = 0;
+        uint32_t key = 0;
+        size_t capacity = 0;
+        size_t used = 0;
+        size_t allocations = 0;
+        // offset -> size of free ranges, adjacent ranges are always merged
+        std::map<uint32_t, uint32_t> freeRanges;
+    };
+
+    struct Released {
+        Allocation alloc;
+        uint32_t frame;
+    };
+
+    bool allocateFrom(Block& _block, size_t _size, uint32_t& _offset);
+    void freeRange(Block& _block, uint32_t _offset, uint32_t _size);
+
+    std::vector<Block> m_blocks;
+    std::vector<Released> m_released;
+
+    mutable std::mutex m_mutex;
+
+    size_t m_blockSize = DEFAULT_BLOCK_SIZE;
+    uint32_t m_frame = 0;
+    uint32_t m_generation = 1;
+    bool m_enabled = true;
+
+    size_t m_totalAllocations = 0;
+    size_t m_buffersCreated = 0;
+    size_t m_buffersDeleted = 0;
+};
+
+}
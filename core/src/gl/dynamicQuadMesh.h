@@ -113,6 +113,7 @@ bool DynamicQuadMesh<T>::draw(RenderState& rs, ShaderProgram& shader, bool useVa
 
         size_t elementsInBatch = verticesInBatch * 6 / 4;
         GL::drawElements(m_drawMode, elementsInBatch, GL_UNSIGNED_SHORT, 0);
+        rs.frameStats.drawCalls++;
 
         // Update counters.
         vertexPos += verticesInBatch;
@@ -164,6 +165,7 @@ bool DynamicQuadMesh<T>::drawRange(RenderState& rs, ShaderProgram& shader,
 
         size_t elementsInBatch = verticesInBatch * 6 / 4;
         GL::drawElements(m_drawMode, elementsInBatch, GL_UNSIGNED_SHORT, 0);
+        rs.frameStats.drawCalls++;
 
         // Update counters.
         vertexPos += verticesInBatch;
@@ -40,6 +40,7 @@ bool GlyphTexture::bind(RenderState& _rs, GLuint _textureUnit) {
         auto offset = m_buffer.get() + (range.min * m_width * bpp());
         GL::texSubImage2D(GL_TEXTURE_2D, 0, 0, range.min, m_width, rows, format,
                           GL_UNSIGNED_BYTE, offset);
+        _rs.uploads.addBytes(rows * m_width * bpp());
     }
     m_dirtyRows.clear();
     return true;
@@ -16,6 +16,9 @@ bool supportsMapBuffer = false;
 bool supportsVAOs = false;
 bool supportsTextureNPOT = false;
 bool supportsGLRGBA8OES = false;
+bool supportsS3TC = false;
+bool supportsETC2 = false;
+bool isGLES = false;
 
 int32_t maxTextureSize = 2048;
 int32_t maxCombinedTextureUnits = 16;
@@ -58,7 +61,12 @@ void loadExtensions() {
     supportsVAOs = glVersion >= 300 || isAvailable("vertex_array_object");
     supportsTextureNPOT = glVersion >= 300 || isAvailable("texture_non_power_of_two");
     supportsGLRGBA8OES = glVersion >= 300 || isAvailable("rgb8_rgba8");
+    supportsS3TC = isAvailable("texture_compression_s3tc") || isAvailable("texture_compression_dxt1");
+    // ETC2 is core in GLES 3; desktop GL 4.3+ also has it, but usually decompresses it in the driver
+    supportsETC2 = (isGLES && glVersion >= 300) || isAvailable("compressed_ETC2_RGB8_texture")
+        || isAvailable("ES3_compatibility");
 
+    LOG("Driver supports compressed textures: S3TC %d, ETC2 %d", supportsS3TC, supportsETC2);
     if (glVersion < 300) {
         LOG("Driver supports map buffer: %d", supportsMapBuffer);
         LOG("Driver supports vaos: %d", supportsVAOs);
@@ -80,6 +88,7 @@ void loadCapabilities() {
         if (*s > '0' && *s < '9') { ver = strtof(s, NULL); break; }
     }
     glVersion = ver*100 + 0.5f;
+    isGLES = verstr && strstr(verstr, "OpenGL ES");
 
     if (glVersion < 300) { GL::getIntegerv(GL_DEPTH_BITS, &depthBits); }  // assume 24 bits for GL 3+
 
@@ -10,6 +10,9 @@ extern bool supportsMapBuffer;
 extern bool supportsVAOs;
 extern bool supportsTextureNPOT;
 extern bool supportsGLRGBA8OES;
+extern bool supportsS3TC;
+extern bool supportsETC2;
+extern bool isGLES;
 extern int32_t maxTextureSize;
 extern int32_t maxCombinedTextureUnits;
 extern int32_t depthBits;
@@ -35,7 +35,10 @@ MeshBase::MeshBase(std::shared_ptr<VertexLayout> _vertexLayout, GLenum _drawMode
 
 MeshBase::~MeshBase() {
     if (m_rs) {
-        if (m_glVertexBuffer || m_glIndexBuffer) {
+        if (m_vertexAlloc) {
+            m_rs->bufferPool.release(m_vertexAlloc);
+            m_rs->bufferPool.release(m_indexAlloc);
+        } else if (m_glVertexBuffer || m_glIndexBuffer) {
             GLuint buffers[] = { m_glVertexBuffer, m_glIndexBuffer };
             m_rs->queueBufferDeletion(2, buffers);
         }
@@ -104,22 +107,54 @@ void MeshBase::subDataUpload(RenderState& rs, GLbyte* _data) {
         // for the frame to finish using the vbo but "directly" send command to upload the data
         GL::bufferData(GL_ARRAY_BUFFER, vertexBytes, data, m_hint);
     }
+    rs.uploads.addBytes(vertexBytes);
 
     m_dirty = false;
 }
 
 void MeshBase::upload(RenderState& rs) {
 
+    int stride = m_vertexLayout->getStride();
+
+    // Static meshes share buffers from the pool
+    if (m_hint == GL_STATIC_DRAW && rs.bufferPool.enabled() && m_glVertexBuffer == 0) {
+        size_t vertexBytes = m_nVertices * stride;
+        m_vertexAlloc = rs.bufferPool.allocate(rs, GL_ARRAY_BUFFER, stride, m_glVertexData, vertexBytes);
+        if (m_vertexAlloc && m_glIndexData) {
+            m_indexAlloc = rs.bufferPool.allocate(rs, GL_ELEMENT_ARRAY_BUFFER, 0, m_glIndexData,
+                                                  (m_nIndices + m_nLodIndices) * sizeof(GLushort));
+            if (!m_indexAlloc) {
+                rs.bufferPool.release(m_vertexAlloc);
+                m_vertexAlloc = {};
+            }
+        }
+        if (m_vertexAlloc) {
+            m_glVertexBuffer = m_vertexAlloc.buffer;
+            m_glIndexBuffer = m_indexAlloc.buffer;
+            rs.uploads.addBytes(bufferSize());
+
+            delete[] m_glVertexData;
+            m_glVertexData = nullptr;
+            delete[] m_glIndexData;
+            m_glIndexData = nullptr;
+
+            m_rs = &rs;
+            m_isUploaded = true;
+            return;
+        }
+    }
+
     // Generate vertex buffer, if needed
     if (m_glVertexBuffer == 0) {
         GL::genBuffers(1, &m_glVertexBuffer);
     }
 
     // Buffer vertex data
-    int vertexBytes = m_nVertices * m_vertexLayout->getStride();
+    int vertexBytes = m_nVertices * stride;
 
     rs.vertexBuffer(m_glVertexBuffer);
     GL::bufferData(GL_ARRAY_BUFFER, vertexBytes, m_glVertexData, m_hint);
+    rs.uploads.addBytes(vertexBytes);
 
     delete[] m_glVertexData;
     m_glVertexData = nullptr;
@@ -133,7 +168,9 @@ void MeshBase::upload(RenderState& rs) {
         // Buffer element index data
         rs.indexBuffer(m_glIndexBuffer);
 
-        GL::bufferData(GL_ELEMENT_ARRAY_BUFFER, m_nIndices * sizeof(GLushort), m_glIndexData, m_hint);
+        size_t indexBytes = (m_nIndices + m_nLodIndices) * sizeof(GLushort);
+        GL::bufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, m_glIndexData, m_hint);
+        rs.uploads.addBytes(indexBytes);
 
         delete[] m_glIndexData;
         m_glIndexData = nullptr;
@@ -144,8 +181,9 @@ void MeshBase::upload(RenderState& rs) {
     m_isUploaded = true;
 }
 
-bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) {
+bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao, bool _lod) {
     bool useVao = _useVao && Hardware::supportsVAOs;
+    bool lod = _lod && m_nLodIndices > 0;
 
     if (!m_isCompiled) { return false; }
     if (m_nVertices == 0) { return false; }
@@ -165,7 +203,8 @@ bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) {
     if (useVao) {
         if (!m_vaos.isInitialized()) {
             // Capture vao state
-            m_vaos.initialize(rs, m_vertexOffsets, *m_vertexLayout, m_glVertexBuffer, m_glIndexBuffer);
+            m_vaos.initialize(rs, m_vertexOffsets, *m_vertexLayout, m_glVertexBuffer, m_glIndexBuffer,
+                              m_vertexAlloc.offset);
         }
     } else {
         // Bind buffers for drawing
@@ -176,17 +215,18 @@ bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) {
         }
     }
 
-    size_t indiceOffset = 0;
+    // decimated indices follow full indices
+    size_t indiceOffset = lod ? m_nIndices : 0;
     size_t vertexOffset = 0;
 
     for (size_t i = 0; i < m_vertexOffsets.size(); ++i) {
         auto& o = m_vertexOffsets[i];
-        uint32_t nIndices = o.first;
+        uint32_t nIndices = lod ? m_lodIndexCounts[i] : o.first;
         uint32_t nVertices = o.second;
 
         if (!useVao) {
             // Enable vertex attribs via vertex layout object
-            size_t byteOffset = vertexOffset * m_vertexLayout->getStride();
+            size_t byteOffset = m_vertexAlloc.offset + vertexOffset * m_vertexLayout->getStride();
             m_vertexLayout->enable(rs,  _shader, byteOffset);
         } else {
             // Bind the corresponding vao relative to the current offset
@@ -196,9 +236,15 @@ bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) {
         // Draw as elements or arrays
         if (nIndices > 0) {
             GL::drawElements(m_drawMode, nIndices, GL_UNSIGNED_SHORT,
-                             (void*)(indiceOffset * sizeof(GLushort)));
-        } else if (nVertices > 0) {
+                             (void*)(m_indexAlloc.offset + indiceOffset * sizeof(GLushort)));
+            rs.frameStats.drawCalls++;
+            if (m_drawMode == GL_TRIANGLES) {
+                rs.frameStats.triangles += nIndices/3;
+                if (lod) { rs.frameStats.lodTrianglesSaved += (o.first - nIndices)/3; }
+            }
+        } else if (o.first == 0 && nVertices > 0) {
             GL::drawArrays(m_drawMode, 0, nVertices);
+            rs.frameStats.drawCalls++;
         }
 
         vertexOffset += nVertices;
@@ -213,34 +259,54 @@ bool MeshBase::draw(RenderState& rs, ShaderProgram& _shader, bool _useVao) {
 }
 
 size_t MeshBase::bufferSize() const {
-    return m_nVertices * m_vertexLayout->getStride() + m_nIndices * sizeof(GLushort);
+    return m_nVertices * m_vertexLayout->getStride() + (m_nIndices + m_nLodIndices) * sizeof(GLushort);
 }
 
 // Add indices by collecting them into batches to draw as much as
 // possible in one draw call.  The indices must be shifted by the
 // number of vertices that are present in the current batch.
+// Decimated indices are batched the same way, after all full indices (_lodOffsets empty to reuse full
+// indices if other meshes compiled into this one have decimated indices).
 size_t MeshBase::compileIndices(const std::vector<std::pair<uint32_t, uint32_t>>& _offsets,
-                                const std::vector<uint16_t>& _indices, size_t _offset) {
+                                const std::vector<uint16_t>& _indices, size_t _offset,
+                                const std::vector<uint32_t>& _lodOffsets,
+                                const std::vector<uint16_t>& _lodIndices) {
 
 
     GLushort* dst = m_glIndexData + _offset;
     size_t curVertices = 0;
     size_t src = 0;
 
+    GLushort* lodDst = m_glIndexData + m_nIndices;
+    for (auto count : m_lodIndexCounts) { lodDst += count; }
+    size_t lodSrc = 0;
+
     if (m_vertexOffsets.empty()) {
         m_vertexOffsets.emplace_back(0, 0);
+        m_lodIndexCounts.push_back(0);
     } else {
         curVertices = m_vertexOffsets.back().second;
     }
 
-    for (auto& p : _offsets) {
-        size_t nIndices = p.first;
-        size_t nVertices = p.second;
+    for (size_t k = 0; k < _offsets.size(); k++) {
+        size_t nIndices = _offsets[k].first;
+        size_t nVertices = _offsets[k].second;
 
         if (curVertices + nVertices > MAX_INDEX_VALUE) {
             m_vertexOffsets.emplace_back(0, 0);
+            m_lodIndexCounts.push_back(0);
             curVertices = 0;
         }
+        if (m_nLodIndices > 0) {
+            const auto& lodIndices = _lodOffsets.empty() ? _indices : _lodIndices;
+            size_t nLodIndices = _lodOffsets.empty() ? nIndices : _lodOffsets[k];
+            size_t lodStart = _lodOffsets.empty() ? src : lodSrc;
+            for (size_t i = 0; i < nLodIndices; i++, lodDst++) {
+                *lodDst = lodIndices[lodStart + i] + curVertices;
+            }
+            lodSrc += nLodIndices;
+            m_lodIndexCounts.back() += nLodIndices;
+        }
         for (size_t i = 0; i < nIndices; i++, dst++) {
             *dst = _indices[src++] + curVertices;
         }
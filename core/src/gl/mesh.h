@@ -1,6 +1,7 @@
 #pragma once
 
 #include "gl.h"
+#include "gl/bufferPool.h"
 #include "gl/vertexLayout.h"
 #include "gl/vao.h"
 #include "style/style.h"
@@ -8,6 +9,7 @@
 #include "platform.h"
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <cstring> // for memcpy
@@ -67,9 +69,10 @@ public:
 
     /*
      * Renders the geometry in this mesh using the ShaderProgram _shader; if
-     * geometry has not already been uploaded it will be uploaded at this point
+     * geometry has not already been uploaded it will be uploaded at this point.
+     * _lod draws the decimated indices instead, if mesh has them
      */
-    bool draw(RenderState& rs, ShaderProgram& _shader, bool _useVao = true);
+    bool draw(RenderState& rs, ShaderProgram& _shader, bool _useVao = true, bool _lod = false);
 
     size_t bufferSize() const;
 
@@ -90,6 +93,10 @@ protected:
     GLbyte* m_glVertexData = nullptr;
 
     size_t m_nIndices;
+    // Decimated indices (MeshData::lodIndices) follow the m_nIndices full indices in index buffer;
+    //  number of them for each entry of m_vertexOffsets
+    size_t m_nLodIndices = 0;
+    std::vector<uint32_t> m_lodIndexCounts;
     GLuint m_glIndexBuffer;
     // Compiled  indices for upload
     GLushort* m_glIndexData = nullptr;
@@ -97,6 +104,10 @@ protected:
     GLenum m_drawMode;
     GLenum m_hint;
 
+    // Ranges of RenderState::bufferPool holding static mesh data; buffers are owned by mesh if not set
+    BufferPool::Allocation m_vertexAlloc;
+    BufferPool::Allocation m_indexAlloc;
+
     bool m_isUploaded;
     bool m_isCompiled;
     bool m_dirty;
@@ -107,7 +118,9 @@ protected:
     GLintptr m_dirtyOffset;
 
     size_t compileIndices(const std::vector<std::pair<uint32_t, uint32_t>>& _offsets,
-                          const std::vector<uint16_t>& _indices, size_t _offset);
+                          const std::vector<uint16_t>& _indices, size_t _offset,
+                          const std::vector<uint32_t>& _lodOffsets = {},
+                          const std::vector<uint16_t>& _lodIndices = {});
 
     void setDirty(GLintptr _byteOffset, GLsizei _byteSize);
 };
@@ -126,13 +139,75 @@ struct MeshData {
     std::vector<T> vertices;
     std::vector<std::pair<uint32_t, uint32_t>> offsets;
 
+    // Decimated indices for lower level of detail, using same vertices; number of them for each offsets entry
+    std::vector<uint16_t> lodIndices;
+    std::vector<uint32_t> lodOffsets;
+
     void clear() {
         offsets.clear();
         indices.clear();
         vertices.clear();
+        lodIndices.clear();
+        lodOffsets.clear();
     }
+
+    /*
+     * Build lodIndices for triangles by vertex clustering: vertices of an offsets entry in the same
+     * _cellSize square (in units of T::pos) with the same height and 32 bit _clusterKey(vertex) (e.g. for
+     * normal or extrusion) are merged into the first of them and collapsed triangles dropped
+     */
+    template<class F>
+    void buildLodIndices(int _cellSize, F _clusterKey);
 };
 
+template<class T>
+template<class F>
+void MeshData<T>::buildLodIndices(int _cellSize, F _clusterKey) {
+
+    lodIndices.clear();
+    lodOffsets.clear();
+    lodIndices.reserve(indices.size());
+
+    struct ClusterKey {
+        uint64_t cell;  // x, y cell and height
+        uint32_t key;
+        bool operator==(const ClusterKey& _other) const { return cell == _other.cell && key == _other.key; }
+    };
+    struct ClusterHash {
+        size_t operator()(const ClusterKey& _k) const {
+            return std::hash<uint64_t>()(_k.cell ^ (uint64_t(_k.key) * 0x9E3779B97F4A7C15ull));
+        }
+    };
+
+    std::unordered_map<ClusterKey, uint16_t, ClusterHash> clusters;
+    std::vector<uint16_t> remap;
+    size_t firstIndex = 0, firstVertex = 0;
+
+    for (auto& o : offsets) {
+        clusters.clear();
+        remap.resize(o.second);
+        for (uint32_t i = 0; i < o.second; i++) {
+            const T& v = vertices[firstVertex + i];
+            uint64_t cell = (uint64_t((int(v.pos.x) + 32768) / _cellSize) << 32 |
+                             uint64_t((int(v.pos.y) + 32768) / _cellSize) << 16 | uint16_t(v.pos.z));
+            remap[i] = clusters.emplace(ClusterKey{cell, uint32_t(_clusterKey(v))}, uint16_t(i)).first->second;
+        }
+
+        size_t start = lodIndices.size();
+        for (size_t i = firstIndex; i + 2 < firstIndex + o.first; i += 3) {
+            uint16_t a = remap[indices[i]], b = remap[indices[i+1]], c = remap[indices[i+2]];
+            if (a == b || b == c || a == c) { continue; }
+            lodIndices.push_back(a);
+            lodIndices.push_back(b);
+            lodIndices.push_back(c);
+        }
+        lodOffsets.push_back(lodIndices.size() - start);
+
+        firstIndex += o.first;
+        firstVertex += o.second;
+    }
+}
+
 template<class T>
 class Mesh : public StyledMesh, protected MeshBase {
 public:
@@ -147,10 +222,28 @@ public:
         return MeshBase::bufferSize();
     }
 
+    size_t vertexCount() const override { return m_nVertices; }
+
+    size_t vertexBytes() const override { return m_nVertices * m_vertexLayout->getStride(); }
+
+    bool hasSelection() const override { return m_vertexLayout->hasAttrib("a_selection_color"); }
+
     bool draw(RenderState& rs, ShaderProgram& shader, bool useVao = true) override {
         return MeshBase::draw(rs, shader, useVao);
     }
 
+    bool drawLod(RenderState& rs, ShaderProgram& shader, bool useVao = true) override {
+        return MeshBase::draw(rs, shader, useVao, true);
+    }
+
+    size_t pendingUploadSize() const override {
+        return m_isCompiled && !m_isUploaded ? MeshBase::bufferSize() : 0;
+    }
+
+    void uploadBuffers(RenderState& rs) override {
+        if (m_isCompiled && !m_isUploaded && m_nVertices > 0) { MeshBase::upload(rs); }
+    }
+
     void compile(const std::vector<MeshData<T>>& _meshes);
 
     void compile(const MeshData<T>& _mesh);
@@ -169,41 +262,66 @@ public:
     template<class A>
     void updateAttribute(Range _vertexRange, const A& _newAttributeValue,
                          size_t _attribOffset = 0);
+
+private:
+
+    // Vertex layout may leave out trailing members of T (see Style::vertexLayout(bool)), in which
+    // case only the first _stride bytes of each vertex are copied
+    static GLbyte* copyVertices(GLbyte* _dst, const std::vector<T>& _vertices, size_t _stride);
 };
 
+template<class T>
+GLbyte* Mesh<T>::copyVertices(GLbyte* _dst, const std::vector<T>& _vertices, size_t _stride) {
+    assert(_stride <= sizeof(T));
+
+    if (_stride == sizeof(T)) {
+        std::memcpy(_dst, (const GLbyte*)_vertices.data(), _vertices.size() * _stride);
+        return _dst + _vertices.size() * _stride;
+    }
+    for (auto& v : _vertices) {
+        std::memcpy(_dst, (const GLbyte*)&v, _stride);
+        _dst += _stride;
+    }
+    return _dst;
+}
+
 
 template<class T>
 void Mesh<T>::compile(const std::vector<MeshData<T>>& _meshes) {
 
     m_nVertices = 0;
     m_nIndices = 0;
+    m_nLodIndices = 0;
 
+    bool hasLod = false;
     for (auto& m : _meshes) {
         m_nVertices += m.vertices.size();
         m_nIndices += m.indices.size();
+        hasLod |= !m.lodOffsets.empty();
+    }
+    // meshes without decimated indices use their full indices
+    if (hasLod) {
+        for (auto& m : _meshes) {
+            m_nLodIndices += m.lodOffsets.empty() ? m.indices.size() : m.lodIndices.size();
+        }
     }
 
     int stride = m_vertexLayout->getStride();
     m_glVertexData = new GLbyte[m_nVertices * stride];
 
-    size_t offset = 0;
+    GLbyte* dst = m_glVertexData;
     for (auto& m : _meshes) {
-        size_t nBytes = m.vertices.size() * stride;
-        std::memcpy(m_glVertexData + offset,
-                    (const GLbyte*)m.vertices.data(),
-                    nBytes);
-
-        offset += nBytes;
+        dst = copyVertices(dst, m.vertices, stride);
     }
 
-    assert(offset == m_nVertices * stride);
+    assert(size_t(dst - m_glVertexData) == m_nVertices * stride);
 
     if (m_nIndices > 0) {
-        m_glIndexData = new GLushort[m_nIndices];
+        m_glIndexData = new GLushort[m_nIndices + m_nLodIndices];
 
         size_t offset = 0;
         for (auto& m : _meshes) {
-            offset = compileIndices(m.offsets, m.indices, offset);
+            offset = compileIndices(m.offsets, m.indices, offset, m.lodOffsets, m.lodIndices);
         }
         assert(offset == m_nIndices);
     }
@@ -216,17 +334,16 @@ void Mesh<T>::compile(const MeshData<T>& _mesh) {
 
     m_nVertices = _mesh.vertices.size();
     m_nIndices = _mesh.indices.size();
+    m_nLodIndices = _mesh.lodIndices.size();
 
     int stride = m_vertexLayout->getStride();
     m_glVertexData = new GLbyte[m_nVertices * stride];
 
-    std::memcpy(m_glVertexData,
-                (const GLbyte*)_mesh.vertices.data(),
-                m_nVertices * stride);
+    copyVertices(m_glVertexData, _mesh.vertices, stride);
 
     if (m_nIndices > 0) {
-        m_glIndexData = new GLushort[m_nIndices];
-        compileIndices(_mesh.offsets, _mesh.indices, 0);
+        m_glIndexData = new GLushort[m_nIndices + m_nLodIndices];
+        compileIndices(_mesh.offsets, _mesh.indices, 0, _mesh.lodOffsets, _mesh.lodIndices);
     }
 
     m_isCompiled = true;
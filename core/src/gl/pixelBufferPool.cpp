@@ -0,0 +1,103 @@
+#include "gl/pixelBufferPool.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace Tangram {
+
+PixelBufferPool& PixelBufferPool::shared() {
+    static PixelBufferPool pool;
+    return pool;
+}
+
+PixelBufferPool::~PixelBufferPool() {
+    clear();
+}
+
+size_t PixelBufferPool::capacity(size_t _bytes) {
+    if (_bytes < MIN_POOLED_SIZE) { return _bytes; }
+    // round up to multiple of 1/4 of largest power of two <= _bytes
+    size_t pow2 = MIN_POOLED_SIZE;
+    while (pow2 <= _bytes/2) { pow2 *= 2; }
+    size_t step = pow2/4;
+    return (_bytes + step - 1)/step*step;
+}
+
+GLubyte* PixelBufferPool::acquire(size_t _bytes) {
+    size_t cap = capacity(_bytes);
+    if (cap >= MIN_POOLED_SIZE) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_freeLists.begin(), m_freeLists.end(),
+                               [&](auto& list) { return list.capacity == cap; });
+        if (it != m_freeLists.end() && !it->buffers.empty()) {
+            GLubyte* buffer = it->buffers.back();
+            it->buffers.pop_back();
+            m_pooledBytes -= cap;
+            m_hits++;
+            return buffer;
+        }
+        m_misses++;
+    }
+    return static_cast<GLubyte*>(std::malloc(std::max(cap, size_t(1))));
+}
+
+void PixelBufferPool::release(GLubyte* _buffer, size_t _bytes) {
+    if (!_buffer) { return; }
+    size_t cap = capacity(_bytes);
+    if (cap >= MIN_POOLED_SIZE) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pooledBytes + cap <= m_maxBytes) {
+            auto it = std::find_if(m_freeLists.begin(), m_freeLists.end(),
+                                   [&](auto& list) { return list.capacity == cap; });
+            if (it == m_freeLists.end()) {
+                m_freeLists.push_back({cap, {}});
+                it = m_freeLists.end() - 1;
+            }
+            it->buffers.push_back(_buffer);
+            m_pooledBytes += cap;
+            return;
+        }
+    }
+    std::free(_buffer);
+}
+
+void PixelBufferPool::setMaxBytes(size_t _bytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxBytes = _bytes;
+    trim();
+}
+
+void PixelBufferPool::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& list : m_freeLists) {
+        for (auto* buffer : list.buffers) { std::free(buffer); }
+    }
+    m_freeLists.clear();
+    m_pooledBytes = 0;
+}
+
+// free largest buffers first until under limit
+void PixelBufferPool::trim() {
+    std::sort(m_freeLists.begin(), m_freeLists.end(),
+              [](auto& a, auto& b) { return a.capacity > b.capacity; });
+    for (auto& list : m_freeLists) {
+        while (m_pooledBytes > m_maxBytes && !list.buffers.empty()) {
+            std::free(list.buffers.back());
+            list.buffers.pop_back();
+            m_pooledBytes -= list.capacity;
+        }
+    }
+}
+
+PixelBufferPool::Stats PixelBufferPool::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats;
+    for (auto& list : m_freeLists) { stats.pooledBuffers += list.buffers.size(); }
+    stats.pooledBytes = m_pooledBytes;
+    stats.maxBytes = m_maxBytes;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    return stats;
+}
+
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "gl.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Tangram {
+
+/* PixelBufferPool - recycles CPU pixel buffers of decoded images
+ *
+ * Raster and DEM tiles come in a few sizes, so buffers released by <Texture>s are kept in free lists by size
+ * class and reused for the next decode instead of allocating (and, for large buffers, page faulting) fresh
+ * memory for every tile. Sizes are rounded up to classes spaced by 1/4 power of two. Thread safe.
+ */
+class PixelBufferPool {
+
+public:
+
+    // smaller buffers are just malloc'd and freed
+    static constexpr size_t MIN_POOLED_SIZE = 16*1024;
+    static constexpr size_t DEFAULT_MAX_BYTES = 16*1024*1024;
+
+    struct Stats {
+        size_t pooledBuffers = 0;
+        size_t pooledBytes = 0;
+        size_t maxBytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+    };
+
+    // pool shared by all Textures
+    static PixelBufferPool& shared();
+
+    explicit PixelBufferPool(size_t _maxBytes = DEFAULT_MAX_BYTES) : m_maxBytes(_maxBytes) {}
+    ~PixelBufferPool();
+
+    // Buffer for at least _bytes; contents are undefined. Must be returned with release() with same _bytes
+    GLubyte* acquire(size_t _bytes);
+
+    // Keep _buffer for reuse, or free it if pool is full
+    void release(GLubyte* _buffer, size_t _bytes);
+
+    // Limit for memory held by free buffers
+    void setMaxBytes(size_t _bytes);
+
+    void clear();
+
+    Stats stats() const;
+
+    // allocated size for a request of _bytes
+    static size_t capacity(size_t _bytes);
+
+private:
+
+    struct FreeList {
+        size_t capacity;
+        std::vector<GLubyte*> buffers;
+    };
+
+    void trim();
+
+    std::vector<FreeList> m_freeLists;
+    size_t m_pooledBytes = 0;
+    size_t m_maxBytes;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+
+    mutable std::mutex m_mutex;
+};
+
+}
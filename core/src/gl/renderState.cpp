@@ -38,6 +38,8 @@ RenderState::RenderState() {
 }
 
 void RenderState::flushResourceDeletion() {
+    bufferPool.flush(*this);
+
     std::lock_guard<std::mutex> guard(m_deletionListMutex);
 
     if (m_VAODeletionList.size()) {
@@ -97,6 +99,7 @@ RenderState::~RenderState() {
 
     deleteQuadIndexBuffer();
     flushResourceDeletion();
+    bufferPool.dispose();
 
     for (auto& s : vertexShaders) {
         GL::deleteShader(s.second);
@@ -158,6 +161,8 @@ void RenderState::invalidateHandles() {
         m_programDeletionList.clear();
         m_shaderDeletionList.clear();
     }
+
+    bufferPool.invalidate();
 }
 
 void RenderState::cacheDefaultFramebuffer() {
@@ -343,6 +348,7 @@ void RenderState::texture(GLuint handle, GLuint unit, GLenum target) {
     if (!m_texture.set || m_texture.target != target || m_texture.handle != handle) {
         m_texture = { target, handle, true };
         GL::bindTexture(target, handle);
+        frameStats.textureBinds++;
     }
 }
 
@@ -370,6 +376,12 @@ void RenderState::indexBufferUnset(GLuint handle) {
     }
 }
 
+void RenderState::vertexBufferUnset(GLuint handle) {
+    if (m_vertexBuffer.handle == handle) {
+        m_vertexBuffer.set = false;
+    }
+}
+
 GLuint RenderState::getQuadIndexBuffer() {
     if (m_quadIndexBuffer == 0) {
         generateQuadIndexBuffer();
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "gl.h"
+#include "gl/bufferPool.h"
+#include "gl/uploadScheduler.h"
 #include <array>
 #include <string>
 #include <mutex>
@@ -101,6 +103,8 @@ public:
 
     void indexBufferUnset(GLuint handle);
 
+    void vertexBufferUnset(GLuint handle);
+
     void cacheDefaultFramebuffer();
 
     GLuint defaultFrameBuffer() const;
@@ -124,6 +128,24 @@ public:
     std::unordered_map<std::string, GLuint> fragmentShaders;
     std::unordered_map<std::string, GLuint> vertexShaders;
 
+    // Per-frame accounting and budgeting of GPU uploads
+    UploadScheduler uploads;
+
+    // Shared vertex and index buffers for static meshes
+    BufferPool bufferPool;
+
+    // GL calls issued in the current frame, reset by Scene::renderBeginFrame
+    struct FrameStats {
+        uint32_t drawCalls = 0;
+        uint32_t uniformUpdates = 0;
+        uint32_t textureBinds = 0;
+        uint32_t triangles = 0;
+        // triangles not drawn because decimated geometry was drawn instead of full geometry
+        uint32_t lodTrianglesSaved = 0;
+        // ... of which for proxy tiles
+        uint32_t proxyLodTrianglesSaved = 0;
+    } frameStats;
+
     float frameTime() { return m_frameTime; }
 
     friend class Scene;
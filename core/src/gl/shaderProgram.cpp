@@ -190,7 +190,7 @@ void ShaderProgram::setUniformi(RenderState& rs, const UniformLocation& _loc, in
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, _value);
-        if (!cached) { GL::uniform1i(location, _value); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform1i(location, _value); }
     }
 }
 
@@ -199,7 +199,7 @@ void ShaderProgram::setUniformi(RenderState& rs, const UniformLocation& _loc, in
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, glm::vec2(_value0, _value1));
-        if (!cached) { GL::uniform2i(location, _value0, _value1); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform2i(location, _value0, _value1); }
     }
 }
 
@@ -208,7 +208,7 @@ void ShaderProgram::setUniformi(RenderState& rs, const UniformLocation& _loc, in
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, glm::vec3(_value0, _value1, _value2));
-        if (!cached) { GL::uniform3i(location, _value0, _value1, _value2); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform3i(location, _value0, _value1, _value2); }
     }
 }
 
@@ -217,7 +217,7 @@ void ShaderProgram::setUniformi(RenderState& rs, const UniformLocation& _loc, in
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, glm::vec4(_value0, _value1, _value2, _value3));
-        if (!cached) { GL::uniform4i(location, _value0, _value1, _value2, _value3); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform4i(location, _value0, _value1, _value2, _value3); }
     }
 }
 
@@ -226,7 +226,7 @@ void ShaderProgram::setUniformf(RenderState& rs, const UniformLocation& _loc, fl
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, _value);
-        if (!cached) { GL::uniform1f(location, _value); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform1f(location, _value); }
     }
 }
 
@@ -247,7 +247,7 @@ void ShaderProgram::setUniformf(RenderState& rs, const UniformLocation& _loc, co
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, _value);
-        if (!cached) { GL::uniform2f(location, _value.x, _value.y); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform2f(location, _value.x, _value.y); }
     }
 }
 
@@ -256,7 +256,7 @@ void ShaderProgram::setUniformf(RenderState& rs, const UniformLocation& _loc, co
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, _value);
-        if (!cached) { GL::uniform3f(location, _value.x, _value.y, _value.z); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform3f(location, _value.x, _value.y, _value.z); }
     }
 }
 
@@ -265,7 +265,7 @@ void ShaderProgram::setUniformf(RenderState& rs, const UniformLocation& _loc, co
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, _value);
-        if (!cached) { GL::uniform4f(location, _value.x, _value.y, _value.z, _value.w); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform4f(location, _value.x, _value.y, _value.z, _value.w); }
     }
 }
 
@@ -274,7 +274,7 @@ void ShaderProgram::setUniformMatrix2f(RenderState& rs, const UniformLocation& _
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = !_transpose && getFromCache(location, _value);
-        if (!cached) { GL::uniformMatrix2fv(location, 1, _transpose, glm::value_ptr(_value)); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniformMatrix2fv(location, 1, _transpose, glm::value_ptr(_value)); }
     }
 }
 
@@ -283,7 +283,7 @@ void ShaderProgram::setUniformMatrix3f(RenderState& rs, const UniformLocation& _
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = !_transpose && getFromCache(location, _value);
-        if (!cached) { GL::uniformMatrix3fv(location, 1, _transpose, glm::value_ptr(_value)); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniformMatrix3fv(location, 1, _transpose, glm::value_ptr(_value)); }
     }
 }
 
@@ -292,7 +292,7 @@ void ShaderProgram::setUniformMatrix4f(RenderState& rs, const UniformLocation& _
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = !_transpose && getFromCache(location, _value);
-        if (!cached) { GL::uniformMatrix4fv(location, 1, _transpose, glm::value_ptr(_value)); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniformMatrix4fv(location, 1, _transpose, glm::value_ptr(_value)); }
     }
 }
 
@@ -301,7 +301,7 @@ void ShaderProgram::setUniformf(RenderState& rs, const UniformLocation& _loc, co
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, _value);
-        if (!cached) { GL::uniform1fv(location, _value.size(), _value.data()); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform1fv(location, _value.size(), _value.data()); }
     }
 }
 
@@ -310,7 +310,7 @@ void ShaderProgram::setUniformf(RenderState& rs, const UniformLocation& _loc, co
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, _value);
-        if (!cached) { GL::uniform2fv(location, _value.size(), (float*)_value.data()); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform2fv(location, _value.size(), (float*)_value.data()); }
     }
 }
 
@@ -319,7 +319,7 @@ void ShaderProgram::setUniformf(RenderState& rs, const UniformLocation& _loc, co
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, _value);
-        if (!cached) { GL::uniform3fv(location, _value.size(), (float*)_value.data()); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform3fv(location, _value.size(), (float*)_value.data()); }
     }
 }
 
@@ -328,7 +328,7 @@ void ShaderProgram::setUniformi(RenderState& rs, const UniformLocation& _loc, co
     GLint location = getUniformLocation(_loc);
     if (location >= 0) {
         bool cached = getFromCache(location, _value);
-        if (!cached) { GL::uniform1iv(location, _value.slots.size(), _value.slots.data()); }
+        if (!cached) { rs.frameStats.uniformUpdates++; GL::uniform1iv(location, _value.slots.size(), _value.slots.data()); }
     }
 }
 
@@ -3,6 +3,7 @@
 #include "gl/glError.h"
 #include "gl/renderState.h"
 #include "gl/hardware.h"
+#include "gl/pixelBufferPool.h"
 #include "log.h"
 #include "map.h"
 #include "platform.h"
@@ -22,6 +23,14 @@ Texture::Texture(const uint8_t* data, size_t length, TextureOptions options, boo
     loadImageFromMemory(data, length);
 }
 
+void Texture::buffer_deleter::operator()(GLubyte* x) const {
+    if (pooledSize > 0) {
+        PixelBufferPool::shared().release(x, pooledSize);
+    } else {
+        std::free(x);
+    }
+}
+
 Texture::~Texture() {
     if (m_rs) {
         m_rs->queueTextureDeletion(m_glHandle);
@@ -34,9 +43,9 @@ bool Texture::loadImageFromMemory(const uint8_t* data, size_t length) {
     GLint internalfmt = 0;
     LOGTInit();
 
-    m_buffer.reset(loadImage(data, length, &width, &height, &internalfmt, int(bpp())));
+    GLubyte* pixels = loadImage(data, length, &width, &height, &internalfmt, int(bpp()));
 
-    if (!m_buffer) {
+    if (!pixels) {
         // We now let raster tile task handle setting empty texture (or a proxy)
         // Default inconsistent texture data is set to a 1*1 pixel texture
         // This reduces inconsistent behavior when texture failed loading
@@ -48,6 +57,7 @@ bool Texture::loadImageFromMemory(const uint8_t* data, size_t length) {
 
     m_options.pixelFormat = static_cast<PixelFormat>(internalfmt);
     m_bufferSize = width * height * bpp();
+    m_buffer = TextureData(pixels, {m_bufferSize});
     resize(width, height);
 
     LOGT("Decoded image data: %dx%d bpp:%d", width, height, bpp());
@@ -66,7 +76,7 @@ bool Texture::setPixelData(int _width, int _height, int _bytesPerPixel,
     }
 
     if (!m_buffer) {
-        m_buffer.reset(reinterpret_cast<GLubyte*>(std::malloc(_length)));
+        m_buffer = TextureData(PixelBufferPool::shared().acquire(_length), {_length});
     }
 
     if (!m_buffer) {
@@ -83,6 +93,27 @@ bool Texture::setPixelData(int _width, int _height, int _bytesPerPixel,
     return true;
 }
 
+bool Texture::setCompressedData(PixelFormat _format, int _width, int _height,
+                                const GLubyte* _data, size_t _length) {
+    TextureOptions options = m_options;
+    options.pixelFormat = _format;
+    if (!options.isCompressed() || _length != options.imageSize(_width, _height)) {
+        LOGW("Invalid compressed texture data! %dx%d format:0x%x bytes:%d", _width, _height, int(_format), _length);
+        return false;
+    }
+    // glGenerateMipmap is not supported for compressed formats
+    options.generateMipmaps = false;
+    if (options.minFilter != TextureMinFilter::NEAREST) { options.minFilter = TextureMinFilter::LINEAR; }
+    m_options = options;
+
+    m_buffer = TextureData(PixelBufferPool::shared().acquire(_length), {_length});
+    std::memcpy(m_buffer.get(), _data, _length);
+    m_bufferSize = _length;
+
+    resize(_width, _height);
+    return true;
+}
+
 void Texture::setSpriteAtlas(std::unique_ptr<Tangram::SpriteAtlas> sprites) {
     m_spriteAtlas = std::move(sprites);
 }
@@ -121,9 +152,16 @@ bool Texture::upload(RenderState& _rs, GLuint _textureUnit) {
     }
 
     auto internalfmt = static_cast<GLint>(m_options.pixelFormat);
+    if (m_options.isCompressed()) {
+        GL::compressedTexImage2D(GL_TEXTURE_2D, 0, internalfmt, m_width, m_height, 0,
+                                 GLsizei(m_bufferSize), m_buffer.get());
+        _rs.uploads.addBytes(m_bufferSize);
+        return true;
+    }
     // desktop GL doesn't support GL_ALPHA, GLES doesn't support GL_RED, so have to use GL_R8
     GL::texImage2D(GL_TEXTURE_2D, 0, internalfmt, m_width, m_height, 0, m_options.glFormat(),
                    m_options.glType(), m_buffer.get());
+    if (m_buffer) { _rs.uploads.addBytes(m_options.imageSize(m_width, m_height)); }
 
     if (m_buffer && m_options.generateMipmaps) {
         GL::generateMipmap(GL_TEXTURE_2D);
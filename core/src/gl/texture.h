@@ -36,7 +36,10 @@ enum class PixelFormat : GLint {
     RGB = GL_RGB8,
     RGBA = GL_RGBA8,
     FLOAT = GL_R32F,
-    R32UI = GL_R32UI
+    R32UI = GL_R32UI,
+    // block compressed, 8 bytes per 4x4 block
+    BC1_RGB = GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+    ETC2_RGB = GL_COMPRESSED_RGB8_ETC2
 };
 
 struct TextureOptions {
@@ -55,12 +58,24 @@ struct TextureOptions {
         return GL_RGBA;
     }
 
+    bool isCompressed() const {
+        return pixelFormat == PixelFormat::BC1_RGB || pixelFormat == PixelFormat::ETC2_RGB;
+    }
+
+    // 0 for block compressed formats - use imageSize()
     int bytesPerPixel() const {
         if (pixelFormat == PixelFormat::ALPHA) return 1;
         if (pixelFormat == PixelFormat::RGB) return 3;
+        if (isCompressed()) return 0;
         return 4;  // FLOAT, RGBA, R32UI
     }
 
+    // bytes of pixel data for _width x _height image
+    size_t imageSize(int _width, int _height) const {
+        if (isCompressed()) { return size_t((_width + 3)/4) * ((_height + 3)/4) * 8; }
+        return size_t(_width) * _height * bytesPerPixel();
+    }
+
     GLenum glType() const {
         if (pixelFormat == PixelFormat::FLOAT) return GL_FLOAT;
         if (pixelFormat == PixelFormat::R32UI) return GL_UNSIGNED_INT;
@@ -83,6 +98,9 @@ public:
     // Sets texture pixel data
     bool setPixelData(int _width, int _height, int _bytesPerPixel, const GLubyte* _data, size_t _length);
 
+    // Sets block compressed pixel data, switching texture to compressed _format (mipmaps are disabled)
+    bool setCompressedData(PixelFormat _format, int _width, int _height, const GLubyte* _data, size_t _length);
+
     // Binds texture to texture unit _unit and uploads new texture data when it has changed.
     // Returns false when no data has been set or when the requested size is greater than
     // supported by the driver.
@@ -97,6 +115,12 @@ public:
     size_t bufferSize() const { return m_bufferSize; }
     GLubyte* bufferData() const { return m_buffer.get(); }
 
+    // GPU memory plus CPU memory if buffer is kept after upload, plus userData
+    size_t memoryUsage() const { return (m_disposeBuffer ? m_bufferSize : 2*m_bufferSize) + userDataSize; }
+
+    // Bytes to be sent to the GPU on next bind
+    size_t pendingUploadSize() const { return m_shouldResize ? m_options.imageSize(m_width, m_height) : 0; }
+
     float displayScale() const { return m_options.displayScale; }
 
     const auto& spriteAtlas() const { return m_spriteAtlas; }
@@ -105,8 +129,10 @@ public:
     // Resize the texture
     void resize(int width, int height);
 
-    // optional user data (currently used to store min,max for elevation tiles)
+    // optional user data (currently used to store ElevationPyramid for elevation tiles)
     std::shared_ptr<void> userData;
+    // heap memory of userData, set with it (before texture is added to RasterCache)
+    size_t userDataSize = 0;
 
 protected:
 
@@ -119,15 +145,23 @@ protected:
 
     bool sanityCheck(size_t _width, size_t _height, size_t _bytesPerPixel, size_t _length) const;
 
+    // take ownership of malloc'd buffer
     void setBufferData(GLubyte* buffer, size_t size) {
         if (m_buffer.get() == buffer) { return; }
-        m_buffer.reset(buffer);
+        m_buffer = TextureData(buffer, {});
     }
 
     TextureOptions m_options;
 
-    struct malloc_deleter { void operator()(GLubyte* x) { std::free(x); } };
-    using TextureData = std::unique_ptr<GLubyte, malloc_deleter>;
+    // returns buffer from PixelBufferPool (pooledSize > 0) to the pool, otherwise frees it
+    struct buffer_deleter {
+        // not a default member initializer, which would make deleter not default constructible within Texture
+        buffer_deleter() : pooledSize(0) {}
+        buffer_deleter(size_t _pooledSize) : pooledSize(_pooledSize) {}
+        size_t pooledSize;
+        void operator()(GLubyte* x) const;
+    };
+    using TextureData = std::unique_ptr<GLubyte, buffer_deleter>;
     TextureData m_buffer = nullptr;
 
     size_t m_bufferSize = 0;
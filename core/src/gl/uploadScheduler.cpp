@@ -0,0 +1,42 @@
+#include "gl/uploadScheduler.h"
+
+#include "tile/tile.h"
+
+#include <algorithm>
+
+namespace Tangram {
+
+void UploadScheduler::beginFrame() {
+    m_lastFrameBytes = m_frameBytes;
+    m_maxFrameBytes = std::max(m_maxFrameBytes, m_frameBytes);
+    m_frameBytes = 0;
+}
+
+void UploadScheduler::enqueue(std::shared_ptr<Tile> _tile, float _screenArea) {
+    m_queue.push_back({_tile, _screenArea});
+}
+
+int UploadScheduler::process(RenderState& _rs) {
+
+    if (m_queue.empty()) { return 0; }
+
+    std::sort(m_queue.begin(), m_queue.end(),
+              [](const Entry& a, const Entry& b) { return a.screenArea > b.screenArea; });
+
+    int uploaded = 0;
+    for (auto& entry : m_queue) {
+        auto tile = entry.tile.lock();
+        if (!tile) { continue; }
+
+        size_t bytes = tile->pendingUploadSize();
+        if (uploaded > 0 && m_frameBytes + bytes > m_frameBudget) { break; }
+
+        tile->upload(_rs);
+        uploaded++;
+    }
+    m_queue.clear();
+
+    return uploaded;
+}
+
+}
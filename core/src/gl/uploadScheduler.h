@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+
+class RenderState;
+class Tile;
+
+/* UploadScheduler - limits the bytes uploaded to the GPU per frame
+ *
+ * All mesh and texture uploads are counted.  When a frame budget is set, tiles are no longer uploaded
+ * lazily on first draw: TileManager keeps drawing proxies for tiles which are not yet uploaded and
+ * queues them here, and they are uploaded in order of screen area until the frame's budget is spent.
+ */
+class UploadScheduler {
+
+public:
+
+    // Bytes per frame; 0 (the default) disables scheduling so meshes are uploaded on first draw
+    void setFrameBudget(size_t _bytes) { m_frameBudget = _bytes; }
+    size_t frameBudget() const { return m_frameBudget; }
+    bool enabled() const { return m_frameBudget > 0; }
+
+    // Start counting bytes for a new frame
+    void beginFrame();
+
+    // Record bytes sent to the GPU
+    void addBytes(size_t _bytes) { m_frameBytes += _bytes; }
+
+    // Queue tile for upload; queue is rebuilt by TileManager every frame
+    void enqueue(std::shared_ptr<Tile> _tile, float _screenArea);
+
+    void clearQueue() { m_queue.clear(); }
+
+    // Upload queued tiles, largest screen area first, until the frame budget is spent. The first tile is
+    // always uploaded, so a tile larger than the budget cannot stall loading. Returns number of tiles uploaded.
+    int process(RenderState& _rs);
+
+    size_t frameBytes() const { return m_frameBytes; }
+    size_t lastFrameBytes() const { return m_lastFrameBytes; }
+    size_t maxFrameBytes() const { return m_maxFrameBytes; }
+    size_t queuedTiles() const { return m_queue.size(); }
+
+    void resetMaxFrameBytes() { m_maxFrameBytes = 0; }
+
+private:
+
+    struct Entry {
+        std::weak_ptr<Tile> tile;
+        float screenArea;
+    };
+
+    std::vector<Entry> m_queue;
+
+    size_t m_frameBudget = 0;
+    size_t m_frameBytes = 0;
+    size_t m_lastFrameBytes = 0;
+    size_t m_maxFrameBytes = 0;
+};
+
+}
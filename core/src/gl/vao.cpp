@@ -8,7 +8,8 @@
 namespace Tangram {
 
 void Vao::initialize(RenderState& rs, const VertexOffsets& _vertexOffsets,
-                     VertexLayout& _layout, GLuint _vertexBuffer, GLuint _indexBuffer) {
+                     VertexLayout& _layout, GLuint _vertexBuffer, GLuint _indexBuffer,
+                     size_t _vertexByteOffset) {
 
     m_glVAOs.resize(_vertexOffsets.size());
 
@@ -29,7 +30,7 @@ void Vao::initialize(RenderState& rs, const VertexOffsets& _vertexOffsets,
         }
 
         // Enable vertex layout on the specified locations
-        _layout.enable(vertexOffset * _layout.getStride());
+        _layout.enable(_vertexByteOffset + vertexOffset * _layout.getStride());
 
         vertexOffset += nVerts;
     }
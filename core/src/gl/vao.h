@@ -18,7 +18,8 @@ class Vao {
 public:
 
     void initialize(RenderState& rs, const VertexOffsets& _vertexOffsets,
-                    VertexLayout& _layout, GLuint _vertexBuffer, GLuint _indexBuffer);
+                    VertexLayout& _layout, GLuint _vertexBuffer, GLuint _indexBuffer,
+                    size_t _vertexByteOffset = 0);
     bool isInitialized();
     void bind(unsigned int _index);
     void unbind();
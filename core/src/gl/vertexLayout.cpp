@@ -50,6 +50,14 @@ size_t VertexLayout::getOffset(std::string _attribName) {
     return 0;
 }
 
+bool VertexLayout::hasAttrib(const std::string& _attribName) const {
+
+    for (auto& attrib : m_attribs) {
+        if (attrib.name == _attribName) { return true; }
+    }
+    return false;
+}
+
 void VertexLayout::enable(size_t _byteOffset) {
 
     for (size_t location = 0; location < m_attribs.size(); ++location) {
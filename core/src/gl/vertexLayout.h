@@ -37,6 +37,8 @@ public:
 
     size_t getOffset(std::string _attribName);
 
+    bool hasAttrib(const std::string& _attribName) const;
+
 private:
 
     std::vector<VertexAttrib> m_attribs;
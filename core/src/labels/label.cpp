@@ -7,10 +7,17 @@
 #include "util/mapProjection.h"
 #include "view/view.h"
 
+#include <atomic>
+
 namespace Tangram {
 
 const float Label::activation_distance_threshold = 2;
 
+uint64_t Label::Serial::next() {
+    static std::atomic<uint64_t> s_serial{0};
+    return ++s_serial;
+}
+
 Label::Label(glm::vec2 _size, Type _type, Options _options)
     : m_type(_type),
       m_dim(_size + _options.buffer),
@@ -156,6 +156,9 @@ public:
 
     Type type() const { return m_type; }
 
+    // Unique for the lifetime of the process, unlike the label's address; copies get a new serial
+    uint64_t serial() const { return m_serial.value; }
+
     void print() const;
 
     void setAlpha(float _alpha);
@@ -169,8 +172,17 @@ protected:
 
     virtual void applyAnchor(LabelProperty::Anchor _anchor) = 0;
 
+    struct Serial {
+        Serial() : value(next()) {}
+        Serial(const Serial&) : value(next()) {}
+        Serial& operator=(const Serial&) { return *this; }
+        static uint64_t next();
+        const uint64_t value;
+    };
+
     const Type m_type;
     const glm::vec2 m_dim;
+    const Serial m_serial;
 
     Options m_options;
 
@@ -18,6 +18,7 @@
 #include "tile/tileCache.h"
 #include "tile/tileManager.h"
 #include "view/view.h"
+#include "util/asyncWorker.h"
 #include "util/elevationManager.h"
 
 #include "glm/glm.hpp"
@@ -26,6 +27,7 @@
 #include "glm/gtx/norm.hpp"
 
 #include <cassert>
+#include <cmath>
 
 namespace Tangram {
 
@@ -33,7 +35,9 @@ LabelManager::LabelManager()
     : m_needUpdate(false),
       m_lastZoom(0.0f) {}
 
-LabelManager::~LabelManager() {}
+LabelManager::~LabelManager() {
+    waitForPlacement();
+}
 
 void LabelManager::processLabelUpdate(const ViewState& _viewState, const LabelSet* _labelSet, Style* _style,
                                 const Tile* _tile, const Marker* _marker, ElevationManager* _elevManager,
@@ -155,6 +159,8 @@ void LabelManager::processLabelUpdate(const ViewState& _viewState, const LabelSe
 
 std::pair<Label*, const Tile*> LabelManager::getLabel(uint32_t _selectionColor) const {
 
+    waitForPlacement();
+
     for (auto& entry : m_selectionLabels) {
 
         if (entry.label->visibleState() &&
@@ -415,6 +421,11 @@ bool LabelManager::zOrderComparator(const LabelEntry& _a, const LabelEntry& _b)
 
 void LabelManager::handleOcclusions(const ViewState& _viewState, bool _hideExtraLabels) {
 
+    if (m_collisionThreshold >= 0) {
+        handleOcclusionsIncremental(_viewState, _hideExtraLabels);
+        return;
+    }
+
     m_isect2d.clear();
     m_repeatGroups.clear();
 
@@ -560,34 +571,272 @@ bool LabelManager::withinRepeatDistance(Label *_label) {
     return false;
 }
 
-void LabelManager::updateLabelSet(const View& _view, float _dt, const Scene& _scene,
-                            const std::vector<std::shared_ptr<Tile>>& _tiles,
-                            const std::vector<std::unique_ptr<Marker>>& _markers,
-                            bool _onlyRender) {
+// Incremental collision: the result of a label is reused if it moved at most m_collisionThreshold pixels since
+//  it was last tested, no label changed in the region it was tested against, and all labels it found there are
+//  unchanged and still come before it. Collision order and the cheap checks (hidden, child, repeat group) are
+//  replayed every frame, so with a threshold of 0 the result matches handleOcclusions() exactly.
+static constexpr float COLLISION_CELL_SIZE = 64;
+// labels partially off screen still take part in collision
+static constexpr float COLLISION_GRID_BORDER = 256;
+
+// max distance a corner of any OBB moved; infinite if the number of OBBs changed
+static float obbsMoved(OBBBuffer& _obbs, const std::vector<isect2d::OBB<glm::vec2>>& _prev) {
+    if (size_t(_obbs.end() - _obbs.begin()) != _prev.size()) { return INFINITY; }
+    float moved = 0;
+    auto prev = _prev.begin();
+    for (auto& obb : _obbs) {
+        auto& q0 = obb.getQuad();
+        auto& q1 = (prev++)->getQuad();
+        for (size_t i = 0; i < q0.size(); i++) {
+            moved = std::max(moved, std::max(std::abs(q0[i].x - q1[i].x), std::abs(q0[i].y - q1[i].y)));
+        }
+    }
+    return moved;
+}
 
-    m_transforms.clear();
-    m_obbs.clear();
+void LabelManager::setCollisionThreshold(float _threshold) {
+    waitForPlacement();
+    m_collisionThreshold = _threshold;
+    m_collisionCache.clear();
+    m_changedCells.clear();
+    m_changedGridSize = glm::ivec2(0);
+}
 
-    auto _viewState = _view.state();
-    /// Collect and update labels from visible tiles
-    updateLabels(_viewState, _dt, _scene, _tiles, _markers, _onlyRender);
-    if (_onlyRender) { return; }
+void LabelManager::handleOcclusionsIncremental(const ViewState& _viewState, bool _hideExtraLabels) {
 
-    std::sort(m_labels.begin(), m_labels.end(), LabelManager::priorityComparator);
+    m_isect2d.clear();
+    m_repeatGroups.clear();
+    m_obbLabels.clear();
 
-    /// Mark labels to skip transitions
+    uint32_t frame = ++m_collisionFrame;
 
-    if (int(m_lastZoom) != int(_viewState.zoom)) {
-        skipTransitions(_scene, _tiles, *_scene.tileManager(), _viewState.zoom);
+    glm::ivec2 gridSize = glm::ivec2(glm::ceil((_viewState.viewportSize + 2*COLLISION_GRID_BORDER) / COLLISION_CELL_SIZE));
+    if (gridSize != m_changedGridSize || _hideExtraLabels != m_collisionHideExtra) {
+        m_collisionCache.clear();
+        m_changedCells.assign(gridSize.x * gridSize.y, 0);
+        m_changedGridSize = gridSize;
+        m_collisionHideExtra = _hideExtraLabels;
+    }
+
+    auto cellRange = [&](float _min, float _max, int _size) {
+        int c0 = int(std::floor((_min + COLLISION_GRID_BORDER) / COLLISION_CELL_SIZE));
+        int c1 = int(std::floor((_max + COLLISION_GRID_BORDER) / COLLISION_CELL_SIZE));
+        return glm::ivec2(glm::clamp(c0, 0, _size - 1), glm::clamp(c1, 0, _size - 1));
+    };
+    // calls _fn(cell) for each grid cell overlapping _aabb, until it returns true
+    auto forCells = [&](const AABB& _aabb, auto _fn) {
+        if (_aabb.min.x > _aabb.max.x) { return false; }  // empty
+        auto xs = cellRange(_aabb.min.x, _aabb.max.x, m_changedGridSize.x);
+        auto ys = cellRange(_aabb.min.y, _aabb.max.y, m_changedGridSize.y);
+        for (int y = ys.x; y <= ys.y; y++) {
+            for (int x = xs.x; x <= xs.y; x++) {
+                if (_fn(m_changedCells[y * m_changedGridSize.x + x])) { return true; }
+            }
+        }
+        return false;
+    };
+    auto markChanged = [&](const AABB& _aabb) {
+        forCells(_aabb, [&](uint32_t& cell) { cell = frame; return false; });
+    };
+    auto isChanged = [&](const AABB& _aabb) {
+        return forCells(_aabb, [&](uint32_t& cell) { return cell == frame; });
+    };
+    // label will not go through collision tests, so its previous result cannot be reused
+    auto dropCache = [&](const Label* _label) {
+        auto it = m_collisionCache.find(_label->serial());
+        if (it == m_collisionCache.end()) { return; }
+        markChanged(it->second.footprint);
+        m_collisionCache.erase(it);
+    };
+
+    for (uint32_t i = 0; i < m_labels.size(); i++) {
+        auto it = m_collisionCache.find(m_labels[i].label->serial());
+        if (it != m_collisionCache.end()) {
+            it->second.frame = frame;
+            it->second.order = i;
+        }
+    }
+    // labels which are gone no longer occlude others
+    for (auto it = m_collisionCache.begin(); it != m_collisionCache.end();) {
+        if (it->second.frame != frame) {
+            markChanged(it->second.footprint);
+            it = m_collisionCache.erase(it);
+        } else {
+            ++it;
+        }
     }
 
-    m_isect2d.resize({_viewState.viewportSize.x / 256, _viewState.viewportSize.y / 256},
-                     {_viewState.viewportSize.x, _viewState.viewportSize.y});
+    std::vector<uint64_t> neighbors;
+
+    for (uint32_t i = 0; i < m_labels.size(); i++) {
+        auto& entry = m_labels[i];
+        auto* l = entry.label;
+
+        ScreenTransform transform { m_transforms, entry.transformRange };
+        OBBBuffer obbs { m_obbs, entry.obbsRange };
+
+        l->obbs(transform, obbs);
+
+        if (_hideExtraLabels && l->options().selectTransition.time < 0) {
+          l->occlude();
+          l->skipTransitions();
+          dropCache(l);
+          continue;
+        }
+
+        if (l->isChild()) {
+            if (l->relative()->isOccluded()) {
+                l->occlude();
+                if (l->relative()->state() == Label::State::skip_transition) {
+                    l->skipTransitions();
+                }
+                dropCache(l);
+                continue;
+            }
+        }
+
+        if (l->options().repeatDistance > 0.f) {
+            if (withinRepeatDistance(l)) {
+                l->occlude();
+                if (l->relative() && !l->options().optional) {
+                    l->relative()->occlude();
+                }
+                dropCache(l);
+                continue;
+            }
+        }
+
+        // already occluded by its relative: no collision test
+        if (l->isOccluded()) { dropCache(l); }
+
+        auto cached = m_collisionCache.find(l->serial());
+        bool reuse = !l->isOccluded() && cached != m_collisionCache.end() &&
+            cached->second.anchorIndex == l->anchorIndex() &&
+            obbsMoved(obbs, cached->second.obbs) <= m_collisionThreshold &&
+            !isChanged(cached->second.region);
+        if (reuse) {
+            for (uint64_t n : cached->second.neighbors) {
+                auto nit = m_collisionCache.find(n);
+                if (nit == m_collisionCache.end() || nit->second.order >= i || nit->second.unchangedFrame != frame) {
+                    reuse = false;
+                    break;
+                }
+            }
+        }
+
+        if (reuse) {
+            auto& c = cached->second;
+            l->occlude(c.occluded);
+            if (c.instantHide && l->state() != Label::State::sleep) {
+                l->skipTransitions();
+            }
+            c.unchangedFrame = frame;
+        } else {
+            int anchorIndex = l->anchorIndex();
+            bool instantHide = false;
+            AABB region;
+            neighbors.clear();
+
+            do {
+                if (l->isOccluded()) {
+                    obbs.clear();
+                    l->obbs(transform, obbs);
+                    if (anchorIndex == l->anchorIndex()) { break; }
+                }
+
+                l->occlude(false);
+
+                for (auto& obb : obbs) {
+                    auto extent = obb.getExtent();
+                    region = isect2d::unionAABB(region, extent);
+                    m_isect2d.intersect(extent, [&](auto& a, auto& b) {
+                            size_t other = reinterpret_cast<size_t>(b.m_userData);
+                            Label* other_label = m_obbLabels[other];
+                            if (neighbors.empty() || neighbors.back() != other_label->serial()) {
+                                neighbors.push_back(other_label->serial());
+                            }
+
+                            if (!intersect(obb, m_obbs[other])) {
+                                return true;
+                            }
+                            if (l->relative() && l->relative() == other_label) {
+                                return true;
+                            }
+                            l->occlude();
+                            if (other_label->options().selectTransition.time > 0) {
+                                instantHide = true;
+                                if (l->state() != Label::State::sleep) {
+                                    l->skipTransitions();
+                                }
+                            }
+                            return false;
+
+                        }, false);
+
+                    if (l->isOccluded()) { break; }
+                }
+            } while (l->isOccluded() && l->nextAnchor());
+
+            AABB footprint;
+            if (!l->isOccluded()) {
+                for (auto& obb : obbs) { footprint = isect2d::unionAABB(footprint, obb.getExtent()); }
+            }
+
+            bool changed = cached == m_collisionCache.end() || cached->second.occluded != l->isOccluded() ||
+                cached->second.anchorIndex != l->anchorIndex() ||
+                obbsMoved(obbs, cached->second.obbs) > m_collisionThreshold;
+            if (changed && cached != m_collisionCache.end()) {
+                markChanged(cached->second.footprint);
+            }
 
-    handleOcclusions(_viewState, _scene.hideExtraLabels);
+            auto& c = m_collisionCache[l->serial()];
+            c.region = region;
+            c.neighbors = neighbors;
+            c.instantHide = instantHide;
+            c.order = i;
+            c.frame = frame;
+            if (changed) {
+                markChanged(footprint);
+                // OBBs are only updated on change, so that small moves cannot accumulate past the threshold
+                c.obbs.assign(obbs.begin(), obbs.end());
+                c.footprint = footprint;
+                c.occluded = l->isOccluded();
+                c.anchorIndex = l->anchorIndex();
+            } else {
+                c.unchangedFrame = frame;
+            }
+        }
+
+        if (l->isOccluded()) {
+            if (l->relative() && !l->options().optional) {
+                l->relative()->occlude();
+                if (l->state() == Label::State::skip_transition) {
+                    l->relative()->skipTransitions();
+                }
+            }
+        } else {
+            int obbPos = entry.obbsRange.start;
+            for (auto& obb : obbs) {
+                auto aabb = obb.getExtent();
+                aabb.m_userData = reinterpret_cast<void*>(obbPos);
+                m_isect2d.insert(aabb);
+                if (m_obbLabels.size() <= size_t(obbPos)) { m_obbLabels.resize(obbPos + 1); }
+                m_obbLabels[obbPos++] = l;
+            }
+
+            if (l->options().repeatDistance > 0.f) {
+                m_repeatGroups[l->options().repeatGroup].push_back(l);
+            }
+        }
+    }
+}
+
+void LabelManager::updateLabelMeshes(const ViewState& _viewState, float _dt, const Scene& _scene,
+                                     const std::vector<std::shared_ptr<Tile>>& _tiles, bool _async) {
 
     // Update label state
     for (auto& entry : m_labels) {
+        if (!entry.placed) { continue; }
         //if (m_lastZoom < _viewState.zoom && entry.label->isOccluded() && !entry.label->occludedLastFrame()) {
         //    LOGD("Label hidden on zoom in: %s (%d labels)", entry.label->debugTag.c_str(), int(m_labels.size()));
         //}
@@ -603,6 +852,8 @@ void LabelManager::updateLabelSet(const View& _view, float _dt, const Scene& _sc
     // Update label meshes
     for (auto& entry : m_labels) {
 
+        if (!entry.placed) { continue; }
+
         // show alt marker if (non-optional part of) marker is occluded
         if (entry.label->isOccluded() && entry.marker
                 && entry.marker->altMarker && !entry.label->options().optional) {
@@ -629,6 +880,17 @@ void LabelManager::updateLabelSet(const View& _view, float _dt, const Scene& _sc
 
         ScreenTransform transform { m_transforms, entry.transformRange };
 
+        if (_async) {
+            // OBBs for this frame are not computed until placement runs, so test bounds around anchor
+            glm::vec2 center = entry.label->screenCenter();
+            float radius = glm::length(entry.label->dimension());
+            if (AABB(center.x - radius, center.y - radius, center.x + radius, center.y + radius)
+                    .intersect(screenBounds)) {
+                entry.label->addVerticesToMesh(transform, _viewState.viewportSize);
+            }
+            continue;
+        }
+
         for (auto& obb : OBBBuffer{ m_obbs, entry.obbsRange }) {
 
             if (obb.getExtent().intersect(screenBounds)) {
@@ -637,6 +899,102 @@ void LabelManager::updateLabelSet(const View& _view, float _dt, const Scene& _sc
             }
         }
     }
+}
+
+void LabelManager::updatePlacementAsync(const ViewState& _viewState, float _dt, const Scene& _scene,
+                                        const std::vector<std::shared_ptr<Tile>>& _tiles) {
+
+    // Occlusion from last placement: Label::update() moved it to occludedLastFrame. Labels which were not
+    //  part of the last placement are not shown until placed.
+    for (auto& entry : m_labels) {
+        entry.placed = m_placedLabels.count(entry.label->serial()) > 0;
+        if (entry.placed && entry.label->occludedLastFrame()) { entry.label->occlude(); }
+    }
+
+    updateLabelMeshes(_viewState, _dt, _scene, _tiles, true);
+
+    /// Mark labels to skip transitions
+    if (int(m_lastZoom) != int(_viewState.zoom)) {
+        skipTransitions(_scene, _tiles, *_scene.tileManager(), _viewState.zoom);
+    }
+
+    m_placementTiles = _tiles;
+    bool hideExtraLabels = _scene.hideExtraLabels;
+
+    auto task = std::make_shared<std::packaged_task<void()>>([this, _viewState, hideExtraLabels]() {
+        std::sort(m_labels.begin(), m_labels.end(), LabelManager::priorityComparator);
+
+        m_isect2d.resize({_viewState.viewportSize.x / 256, _viewState.viewportSize.y / 256},
+                         {_viewState.viewportSize.x, _viewState.viewportSize.y});
+
+        handleOcclusions(_viewState, hideExtraLabels);
+
+        m_placedLabels.clear();
+        for (auto& entry : m_labels) { m_placedLabels.insert(entry.label->serial()); }
+    });
+    m_placement = task->get_future();
+    m_placementWorker->enqueue([task]() { (*task)(); });
+}
+
+void LabelManager::setAsyncPlacement(bool _async) {
+    waitForPlacement();
+    if (_async && !m_placementWorker) {
+        m_placementWorker = std::make_unique<AsyncWorker>("LabelManager placement worker");
+    } else if (!_async) {
+        m_placementWorker.reset();
+        m_placedLabels.clear();
+        m_placementPending = false;
+    }
+}
+
+void LabelManager::waitForPlacement() const {
+    if (m_placement.valid()) { m_placement.get(); }
+}
+
+void LabelManager::updateLabelSet(const View& _view, float _dt, const Scene& _scene,
+                            const std::vector<std::shared_ptr<Tile>>& _tiles,
+                            const std::vector<std::unique_ptr<Marker>>& _markers,
+                            bool _onlyRender) {
+
+    waitForPlacement();
+    m_placementTiles.clear();
+
+    m_transforms.clear();
+    m_obbs.clear();
+
+    // placement started from a changed view must be applied (and shown) by a full update
+    if (m_placementWorker) {
+        bool changed = !_onlyRender;
+        if (m_placementPending) { _onlyRender = false; }
+        m_placementPending = changed;
+    }
+
+    auto _viewState = _view.state();
+    /// Collect and update labels from visible tiles
+    updateLabels(_viewState, _dt, _scene, _tiles, _markers, _onlyRender);
+    if (_onlyRender) { return; }
+
+    if (m_placementWorker) {
+        // request another frame to apply this placement
+        m_needUpdate |= m_placementPending;
+        updatePlacementAsync(_viewState, _dt, _scene, _tiles);
+    } else {
+        std::sort(m_labels.begin(), m_labels.end(), LabelManager::priorityComparator);
+
+        /// Mark labels to skip transitions
+
+        if (int(m_lastZoom) != int(_viewState.zoom)) {
+            skipTransitions(_scene, _tiles, *_scene.tileManager(), _viewState.zoom);
+        }
+
+        m_isect2d.resize({_viewState.viewportSize.x / 256, _viewState.viewportSize.y / 256},
+                         {_viewState.viewportSize.x, _viewState.viewportSize.y});
+
+        handleOcclusions(_viewState, _scene.hideExtraLabels);
+
+        updateLabelMeshes(_viewState, _dt, _scene, _tiles, false);
+    }
+
     m_lastZoom = _viewState.zoom;
     m_lastViewPos = _view.getPosition();
     m_lastViewProj = _view.getViewProjectionMatrix();
@@ -644,6 +1002,8 @@ void LabelManager::updateLabelSet(const View& _view, float _dt, const Scene& _sc
 
 void LabelManager::drawDebug(RenderState& rs, const View& _view) {
 
+    waitForPlacement();
+
     if (!Tangram::getDebugFlag(Tangram::DebugFlags::labels)) {
         return;
     }
@@ -9,15 +9,18 @@
 #include "glm_vec.h" // for isect2d.h
 #include "isect2d.h"
 
+#include <future>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace Tangram {
 
+class AsyncWorker;
 class FontContext;
 class LabelSet;
 class Marker;
@@ -46,6 +49,18 @@ public:
 
     std::pair<Label*, const Tile*> getLabel(uint32_t _selectionColor) const;
 
+    // Run label collision on a worker thread, overlapped with rendering of the frame; each frame applies
+    //  the placement computed in the previous one. Labels must not be modified or destroyed while placement
+    //  runs: updateLabelSet() and Map::render() wait for it, and so must anything else touching labels.
+    void setAsyncPlacement(bool _async);
+
+    // Wait for pending async label placement
+    void waitForPlacement() const;
+
+    // Keep the collision result of labels which moved at most _threshold pixels since last tested and
+    //  whose neighbors did not change, instead of testing every label each frame; < 0 disables (default)
+    void setCollisionThreshold(float _threshold);
+
 protected:
 
     using AABB = isect2d::AABB<glm::vec2>;
@@ -60,6 +75,9 @@ protected:
 
     void handleOcclusions(const ViewState& _viewState, bool _hideExtraLabels = false);
 
+    // handleOcclusions() re-testing only labels which are new, moved, or near a changed label
+    void handleOcclusionsIncremental(const ViewState& _viewState, bool _hideExtraLabels);
+
     bool withinRepeatDistance(Label *_label);
 
     void updateLabels(const ViewState& _viewState, float _dt, const Scene& _scene,
@@ -71,6 +89,14 @@ protected:
                             const Tile* _tile, const Marker* _marker, ElevationManager* _elevManager,
                             float _dt, bool _onlyRender);
 
+    // Evaluate label states and build label meshes after occlusion has been determined
+    void updateLabelMeshes(const ViewState& _viewState, float _dt, const Scene& _scene,
+                           const std::vector<std::shared_ptr<Tile>>& _tiles, bool _async);
+
+    // Apply last frame's placement and start placement for this frame on m_placementWorker
+    void updatePlacementAsync(const ViewState& _viewState, float _dt, const Scene& _scene,
+                              const std::vector<std::shared_ptr<Tile>>& _tiles);
+
     bool m_needUpdate;
 
     isect2d::ISect2D<glm::vec2> m_isect2d;
@@ -96,6 +122,8 @@ protected:
 
         Range transformRange;
         Range obbsRange;
+        // false if async placement has not determined occlusion of label yet
+        bool placed = true;
     };
 
     static bool priorityComparator(const LabelEntry& _a, const LabelEntry& _b);
@@ -110,6 +138,46 @@ protected:
 
     std::unordered_map<size_t, std::vector<Label*>> m_repeatGroups;
 
+    // Collision result of a label when it was last tested, for incremental collision
+    struct CollisionCache {
+        std::vector<OBB> obbs;
+        // extent of OBBs of all anchors tested
+        AABB region;
+        // extent of OBBs if label was not occluded
+        AABB footprint;
+        // labels found in region when tested (Label::serial())
+        std::vector<uint64_t> neighbors;
+        int anchorIndex = 0;
+        bool occluded = false;
+        // occluded by a label hiding others without transition
+        bool instantHide = false;
+        // position in collision order of current frame
+        uint32_t order = 0;
+        uint32_t frame = 0;
+        // last frame the result was reused or reproduced
+        uint32_t unchangedFrame = 0;
+    };
+
+    // keyed by Label::serial(), since a new label can be allocated at the address of a deleted one
+    std::unordered_map<uint64_t, CollisionCache> m_collisionCache;
+    // owner of each OBB inserted into m_isect2d
+    std::vector<Label*> m_obbLabels;
+    // persistent grid covering the extended viewport; each cell holds the last frame it was changed in
+    std::vector<uint32_t> m_changedCells;
+    glm::ivec2 m_changedGridSize{0};
+    float m_collisionThreshold = -1;
+    uint32_t m_collisionFrame = 0;
+    bool m_collisionHideExtra = false;
+
+    std::unique_ptr<AsyncWorker> m_placementWorker;
+    mutable std::future<void> m_placement;
+    // labels placed by the last async placement, by Label::serial() as for m_collisionCache
+    std::unordered_set<uint64_t> m_placedLabels;
+    // keeps tiles (and their labels) alive while placement runs
+    std::vector<std::shared_ptr<Tile>> m_placementTiles;
+    // placement started from a changed view has not been applied by a full update yet
+    bool m_placementPending = false;
+
     float m_lastZoom;
     // view state for last label update;
     glm::mat4 m_lastViewProj;
@@ -2,6 +2,7 @@
 
 #include "debug/textDisplay.h"
 #include "debug/frameInfo.h"
+#include "debug/trace.h"
 #include "gl.h"
 #include "gl/glError.h"
 #include "gl/framebuffer.h"
@@ -14,7 +15,6 @@
 #include "marker/markerManager.h"
 #include "platform.h"
 #include "scene/scene.h"
-#include "scene/sceneLoader.h"
 #include "selection/selectionQuery.h"
 #include "style/material.h"
 #include "style/style.h"
@@ -30,8 +30,10 @@
 #include "view/flyTo.h"
 #include "view/view.h"
 
+#include <algorithm>
 #include <bitset>
 #include <cmath>
+#include <iterator>
 
 namespace Tangram {
 
@@ -202,10 +204,7 @@ View& Map::getView() {
 
 void Map::updateGlobals(const std::vector<SceneUpdate>& _sceneUpdates, bool _rebuildTiles)
 {
-  auto& config = const_cast<YAML::Node&>(impl->scene->config());
-  SceneLoader::applyUpdates(config, _sceneUpdates);
-  impl->scene->globalsGeneration++;
-  if (_rebuildTiles) { impl->scene->tileManager()->clearTileSets(); }
+  impl->scene->updateGlobals(_sceneUpdates, _rebuildTiles);
   impl->platform.requestRender();
 }
 
@@ -237,9 +236,11 @@ void Map::setViewport(int _newX, int _newY, int _newWidth, int _newHeight) {
 
 MapState Map::update(float _dt) {
 
+    TRACE_SCOPE("Map::update");
     FrameInfo::beginUpdate();
     FrameInfo::begin("Update");
 
+    impl->renderState.uploads.beginFrame();
     impl->jobQueue.runJobs();
 
     bool isEasing = impl->updateCameraEase(_dt);
@@ -282,6 +283,8 @@ MapState Map::update(float _dt) {
 
 void Map::render() {
 
+    TRACE_SCOPE("Map::render");
+
     auto& scene = *impl->scene;
     auto& view = impl->view;
     auto& renderState = impl->renderState;
@@ -311,6 +314,20 @@ void Map::render() {
 
     scene.renderBeginFrame(renderState);
 
+    // Resolve feature queries with the feature index of visible tiles, without a selection pass
+    if (scene.options().cpuFeaturePicking) {
+        auto& queries = impl->selectionQueries;
+        auto it = std::stable_partition(queries.begin(), queries.end(),
+                                        [](auto& q) { return q.type() != QueryType::feature; });
+        // callbacks may queue new queries
+        std::vector<SelectionQuery> featureQueries(std::make_move_iterator(it),
+                                                   std::make_move_iterator(queries.end()));
+        queries.erase(it, queries.end());
+        for (auto& query : featureQueries) {
+            query.processFeatureIndex(view, *scene.tileManager());
+        }
+    }
+
     // Render feature selection pass to offscreen framebuffer
     bool drawSelectionDebug = getDebugFlag(DebugFlags::selection_buffer);
     bool drawDepthDebug = scene.elevationManager() && getDebugFlag(DebugFlags::depth_buffer);
@@ -350,9 +367,12 @@ void Map::render() {
         scene.labelManager()->drawDebug(renderState, view);
     }
 
+    // labels may be modified after render() returns
+    scene.labelManager()->waitForPlacement();
+
     FrameInfo::draw(renderState, view, *this);
 
-    // if almost out of font atlas textures, reset
+    // if almost out of font atlas textures (unused textures are reused first), reset
     if (scene.fontContext()->glyphTextureCount() > FontContext::max_textures - 2) {
         LOGW("Rebuilding tiles due to font atlas exhaustion!");
         scene.tileManager()->clearTileSets();
@@ -975,6 +995,18 @@ void Map::useCachedGlState(bool _useCache) {
     impl->cacheGlState = _useCache;
 }
 
+void Map::setFrameUploadBudget(size_t _bytes) {
+    impl->renderState.uploads.setFrameBudget(_bytes);
+}
+
+void Map::setTracing(bool _enabled) {
+    Trace::setEnabled(_enabled);
+}
+
+std::string Map::getTraceJson() {
+    return Trace::exportJson();
+}
+
 void Map::runAsyncTask(std::function<void()> _task) {
     if (impl->asyncWorker) {
         impl->asyncWorker->enqueue(std::move(_task));
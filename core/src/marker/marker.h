@@ -93,6 +93,12 @@ public:
     // Get the zoom level at which the mesh for this marker was built.
     int builtZoomLevel() const;
 
+    // Whether mesh must be rebuilt when zoom changes, i.e. styling uses stops or functions, or marker is a
+    // polyline (width is only interpolated up to the next zoom level)
+    bool isZoomDependent() const { return m_zoomDependent; }
+
+    void setZoomDependent(bool zoomDependent) { m_zoomDependent = zoomDependent; }
+
     // Get the ordering of this marker relative to other markers.
     int drawOrder() const;
 
@@ -133,6 +139,9 @@ public:
     bool isAltMarker = false;  // set if is alternate
     bool altMeshAdded = false;  // set on alternate if shown
 
+    // set while mesh is being built on worker thread
+    bool meshPending = false;
+
     static bool compareByDrawOrder(const std::unique_ptr<Marker>& lhs, const std::unique_ptr<Marker>& rhs);
 
 protected:
@@ -174,6 +183,8 @@ protected:
 
     bool m_visible = true;
 
+    bool m_zoomDependent = true;
+
 };
 
 } // namespace Tangram
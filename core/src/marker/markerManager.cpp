@@ -8,19 +8,28 @@
 #include "scene/styleContext.h"
 #include "style/style.h"
 #include "view/view.h"
+#include "labels/labelManager.h"
 #include "labels/labelSet.h"
 #include "log.h"
 #include "selection/featureSelection.h"
+#include "platform.h"
+#include "util/asyncWorker.h"
 
 #include <algorithm>
+#include <chrono>
 
 namespace Tangram {
 
 // ':' Delimiter for style params and layer-sublayer naming
 static const char DELIMITER = ':';
 
+// markers per worker task, so results are applied progressively
+static const size_t BUILD_BATCH_SIZE = 256;
+
 MarkerManager::MarkerManager(const Scene& _scene, MarkerManager* _oldInst) : m_scene(_scene) {
     if(_oldInst && !_oldInst->m_markers.empty()) {
+        _oldInst->waitForPlacement();
+        _oldInst->waitForBuilds();
         m_dirty = true;
         m_markers = std::move(_oldInst->m_markers);
         m_idCounter = _oldInst->m_idCounter;
@@ -31,6 +40,8 @@ MarkerManager::MarkerManager(const Scene& _scene, MarkerManager* _oldInst) : m_s
 }
 
 MarkerManager::~MarkerManager() {
+    // join worker before builders it uses are destroyed
+    m_buildWorker.reset();
     if(!m_markers.empty())
         LOGD("Destroying MarkerManager with %d markers.", int(m_markers.size()));
 }
@@ -48,10 +59,12 @@ MarkerID MarkerManager::add() {
 }
 
 bool MarkerManager::remove(MarkerID markerID) {
+    waitForPlacement();
     m_dirty = true;
 
     for (auto it = m_markers.begin(), end = m_markers.end(); it != end; ++it) {
         if (it->get()->id() == markerID) {
+            finishBuild(**it);
             m_markers.erase(it);
             return true;
         }
@@ -62,6 +75,7 @@ bool MarkerManager::remove(MarkerID markerID) {
 bool MarkerManager::setStyling(MarkerID markerID, const char* styling, bool isPath) {
     Marker* marker = getMarkerOrNull(markerID);
     if (!marker) { return false; }
+    finishBuild(*marker);
 
     marker->setStyling(std::string(styling), isPath);
     m_dirty = true;
@@ -72,6 +86,7 @@ bool MarkerManager::setStyling(MarkerID markerID, const char* styling, bool isPa
 bool MarkerManager::setBitmap(MarkerID markerID, int width, int height, float density, const unsigned int* bitmapData) {
     Marker* marker = getMarkerOrNull(markerID);
     if (!marker) { return false; }
+    finishBuild(*marker);
 
     marker->clearMesh();
 
@@ -110,6 +125,7 @@ bool MarkerManager::setDrawOrder(MarkerID markerID, int drawOrder) {
 bool MarkerManager::setProperties(MarkerID markerID, Properties&& properties) {
     Marker* marker = getMarkerOrNull(markerID);
     if (!marker) { return false; }
+    finishBuild(*marker);
     if (!marker->feature()) { LOGE("Marker geometry must be set before properties!"); return false; }
     marker->clearMesh();
     marker->feature()->props = std::move(properties);
@@ -129,6 +145,7 @@ bool MarkerManager::setAlternate(MarkerID markerID, MarkerID altID) {
 bool MarkerManager::setPoint(MarkerID markerID, LngLat lngLat) {
     Marker* marker = getMarkerOrNull(markerID);
     if (!marker) { return false; }
+    finishBuild(*marker);
 
     marker->clearMesh();
 
@@ -169,6 +186,7 @@ bool MarkerManager::setPointEased(MarkerID markerID, LngLat lngLat, float durati
 bool MarkerManager::setPolyline(MarkerID markerID, LngLat* coordinates, int count) {
     Marker* marker = getMarkerOrNull(markerID);
     if (!marker) { return false; }
+    finishBuild(*marker);
 
     m_dirty = true;
     marker->clearMesh();
@@ -215,6 +233,7 @@ bool MarkerManager::setPolygon(MarkerID markerID, LngLat* coordinates, int* coun
 
     Marker* marker = getMarkerOrNull(markerID);
     if (!marker) { return false; }
+    finishBuild(*marker);
 
     m_dirty = true;
     marker->clearMesh();
@@ -276,19 +295,15 @@ MarkerManager::UpdateState MarkerManager::update(const View& _view, float _dt) {
     // do this here instead of Scene::update so we don't print every time map is moved
     LOGTInit(">>> update");
 
-    if (!m_styleContext) {
+    if (!m_builders.styleContext) {
         // First call to update after scene became ready
-        // Initialize Stylecontext and StyleBuilders.
-        m_styleContext = std::make_unique<StyleContext>();
-        m_styleContext->initFunctions(m_scene);
-        for (const auto& style : m_scene.styles()) {
-            m_styleBuilders[style->getName()] = style->createBuilder();
-        }
+        initBuilders(m_builders);
     }
 
     m_zoom = _view.getIntegerZoom();
 
-    bool rebuilt = false;
+    waitForPlacement();
+    bool rebuilt = applyBuilds(false);
     bool easing = false;
     bool dirty = m_dirty;
     m_dirty = false;
@@ -298,30 +313,118 @@ MarkerManager::UpdateState MarkerManager::update(const View& _view, float _dt) {
         std::stable_sort(m_markers.begin(), m_markers.end(), Marker::compareByDrawOrder);
     }
 
+    std::vector<Marker*> asyncBuilds;
     for (auto& marker : m_markers) {
         // skip hidden markers (else we'll end up rendering continuously since buildStyling() doesn't finish)
         if (!marker->isVisible()) { continue; }
 
         int builtZoom = marker->builtZoomLevel();
-        if (m_zoom != builtZoom || !marker->mesh()) {
-            if (builtZoom < 0) { buildStyling(*marker); }
-
-            // prevent continuous rendering if marker styling fails
-            if (buildMesh(*marker, m_zoom))
-                rebuilt = true;
-            else
-                LOGE("Error building marker mesh.");
+        bool needsBuild = builtZoom < 0 || !marker->mesh() || (m_zoom != builtZoom && marker->isZoomDependent());
+        if (needsBuild && !marker->meshPending) {
+            if (m_buildWorker && builtZoom >= 0 && marker->mesh()) {
+                // keep showing mesh for previous zoom until rebuilt
+                asyncBuilds.push_back(marker.get());
+            } else {
+                if (builtZoom < 0) { buildStyling(*marker); }
+
+                // prevent continuous rendering if marker styling fails
+                if (buildMesh(*marker, m_zoom))
+                    rebuilt = true;
+                else
+                    LOGE("Error building marker mesh.");
+            }
         }
 
         marker->update(_dt, _view);
         easing |= marker->isEasing();
     }
+
+    if (!asyncBuilds.empty()) { dispatchBuilds(asyncBuilds); }
     LOGT("<<< update");
 
     return {rebuilt || easing || dirty, easing};
 }
 
+void MarkerManager::setAsyncBuilds(bool _async) {
+    waitForBuilds();
+    if (_async && !m_buildWorker) {
+        m_buildWorker = std::make_unique<AsyncWorker>("MarkerManager build worker");
+    } else if (!_async) {
+        m_buildWorker.reset();
+    }
+}
+
+void MarkerManager::waitForBuilds() {
+    if (applyBuilds(true)) { m_dirty = true; }
+}
+
+void MarkerManager::waitForPlacement() {
+    // async label placement reads marker labels and meshes until it is joined after rendering
+    if (auto labelManager = m_scene.labelManager()) { labelManager->waitForPlacement(); }
+}
+
+void MarkerManager::finishBuild(Marker& marker) {
+    if (marker.meshPending) { waitForBuilds(); }
+}
+
+void MarkerManager::dispatchBuilds(std::vector<Marker*>& markers) {
+
+    for (size_t start = 0; start < markers.size(); start += BUILD_BATCH_SIZE) {
+        m_buildBatches.emplace_back();
+        // deque does not move elements on push_back, so worker can keep a reference
+        auto& batch = m_buildBatches.back();
+        batch.zoom = m_zoom;
+
+        size_t end = std::min(start + BUILD_BATCH_SIZE, markers.size());
+        batch.results.resize(end - start);
+        for (size_t i = start; i < end; ++i) {
+            markers[i]->meshPending = true;
+            batch.results[i - start].marker = markers[i];
+        }
+        batch.functions.assign(m_functions.begin() + m_workerFunctions, m_functions.end());
+        m_workerFunctions = m_functions.size();
+
+        auto task = std::make_shared<std::packaged_task<void()>>([this, &batch]() {
+            if (!m_workerBuilders.styleContext) { initBuilders(m_workerBuilders); }
+            for (auto& function : batch.functions) {
+                m_workerBuilders.styleContext->addFunction(function);
+            }
+            for (auto& result : batch.results) {
+                buildMesh(*result.marker, batch.zoom, m_workerBuilders, result);
+            }
+            m_scene.platform().requestRender();
+        });
+        batch.done = task->get_future();
+        m_buildWorker->enqueue([task]() { (*task)(); });
+    }
+}
+
+bool MarkerManager::applyBuilds(bool wait) {
+    bool applied = false;
+    while (!m_buildBatches.empty()) {
+        auto& batch = m_buildBatches.front();
+        if (!wait && batch.done.wait_for(std::chrono::seconds(0)) != std::future_status::ready) { break; }
+        batch.done.wait();
+
+        waitForPlacement();
+        for (auto& result : batch.results) {
+            result.marker->meshPending = false;
+            if (result.valid) {
+                applyBuild(result, batch.zoom);
+            } else {
+                result.marker->clearMesh();
+                LOGE("Error building marker mesh.");
+            }
+        }
+        applied = true;
+        m_buildBatches.pop_front();
+    }
+    return applied;
+}
+
 void MarkerManager::removeAll() {
+    waitForPlacement();
+    waitForBuilds();
     m_dirty = true;
     m_markers.clear();
 }
@@ -329,6 +432,8 @@ void MarkerManager::removeAll() {
 void MarkerManager::rebuildAll() {
     if (m_markers.empty()) { return; }
 
+    waitForPlacement();
+    waitForBuilds();
     m_dirty = true;
 
     for (auto& entry : m_markers) {
@@ -338,6 +443,9 @@ void MarkerManager::rebuildAll() {
 }
 
 void MarkerManager::clearMeshes() {
+    // results built with e.g. old font atlases would replace cleared meshes
+    waitForPlacement();
+    waitForBuilds();
     for (auto& entry : m_markers) {
         entry->clearMesh();
     }
@@ -424,7 +532,7 @@ bool MarkerManager::buildStyling(Marker& marker) {
     }
     // Compile any new JS functions used for styling.
     for (auto i = prevFunctionCount; i < m_functions.size(); ++i) {
-        m_styleContext->addFunction(m_functions[i]);
+        m_builders.styleContext->addFunction(m_functions[i]);
     }
 
     marker.setDrawRuleData(std::make_unique<DrawRuleData>("", 0, std::move(params)));
@@ -432,34 +540,63 @@ bool MarkerManager::buildStyling(Marker& marker) {
     return true;
 }
 
+void MarkerManager::initBuilders(Builders& builders) {
+    builders.styleContext = std::make_unique<StyleContext>();
+    builders.styleContext->initFunctions(m_scene);
+    for (const auto& style : m_scene.styles()) {
+        builders.styleBuilders[style->getName()] = style->createBuilder();
+    }
+}
+
 bool MarkerManager::buildMesh(Marker& marker, int zoom) {
 
     marker.clearMesh();
 
+    BuildResult result;
+    result.marker = &marker;
+    buildMesh(marker, zoom, m_builders, result);
+    if (!result.valid) { return false; }
+
+    applyBuild(result, zoom);
+    return true;
+}
+
+// Only uses marker's feature, draw rule and texture, so it can run on the worker thread while the marker's
+//  previous mesh is rendered
+void MarkerManager::buildMesh(Marker& marker, int zoom, Builders& builders, BuildResult& result) {
+
     auto feature = marker.feature();
     auto rule = marker.drawRule();
-    if (!feature || !rule) { return false; }
+    if (!feature || !rule) { return; }
 
     StyleBuilder* styler = nullptr;
     {
         auto name = rule->getStyleName();
-        auto it = m_styleBuilders.find(name);
-        if (it != m_styleBuilders.end()) {
+        auto it = builders.styleBuilders.find(name);
+        if (it != builders.styleBuilders.end()) {
             styler = it->second.get();
         } else {
             LOGN("Invalid style %s", name.c_str());
-            return false;
+            return;
         }
     }
 
     // Apply default draw rules defined for this style
     styler->style().applyDefaultDrawRules(*rule);
 
-    m_styleContext->setTileID(TileID(0, 0, zoom));
-    m_styleContext->setFeature(*feature);
-    bool valid = marker.evaluateRuleForContext(*m_styleContext);
+    // polyline width is only interpolated to the next zoom level
+    result.zoomDependent = feature->geometryType == GeometryType::lines;
+    for (size_t i = 0; i < StyleParamKeySize && !result.zoomDependent; ++i) {
+        if (!rule->active[i]) { continue; }
+        auto* param = rule->params[i].param;
+        result.zoomDependent = param->function >= 0 || param->stops;
+    }
+
+    builders.styleContext->setTileID(TileID(0, 0, zoom));
+    builders.styleContext->setFeature(*feature);
+    bool valid = marker.evaluateRuleForContext(*builders.styleContext);
 
-    if (!valid) { return false; }
+    if (!valid) { return; }
 
     styler->setup(marker, zoom);
 
@@ -474,12 +611,19 @@ bool MarkerManager::buildMesh(Marker& marker, int zoom) {
         rule->selectionColor = 0;
     }
 
-    if (!styler->addFeature(*feature, *rule)) { return false; }
+    if (!styler->addFeature(*feature, *rule)) { return; }
 
-    marker.setSelectionColor(selectionColor);
-    marker.setMesh(styler->style().getID(), zoom, styler->build());
+    result.selectionColor = selectionColor;
+    result.styleId = styler->style().getID();
+    result.mesh = styler->build();
+    result.valid = true;
+}
 
-    return true;
+void MarkerManager::applyBuild(BuildResult& result, int zoom) {
+    auto& marker = *result.marker;
+    marker.setSelectionColor(result.selectionColor);
+    marker.setMesh(result.styleId, zoom, std::move(result.mesh));
+    marker.setZoomDependent(result.zoomDependent);
 }
 
 const Marker* MarkerManager::getMarkerOrNullBySelectionColor(uint32_t selectionColor) const {
@@ -494,6 +638,8 @@ const Marker* MarkerManager::getMarkerOrNullBySelectionColor(uint32_t selectionC
 
 Marker* MarkerManager::getMarkerOrNull(MarkerID markerID) {
     if (!markerID) { return nullptr; }
+    // only used to modify marker
+    waitForPlacement();
     // typical use case is to add marker, then call fns to configure it, so caller is most likely to want
     //  marker at end of list, so we search from end
     for (size_t ii = m_markers.size(); ii--;) {
@@ -6,16 +6,20 @@
 #include "util/fastmap.h"
 #include "util/types.h"
 
+#include <deque>
+#include <future>
 #include <memory>
 #include <vector>
 
 namespace Tangram {
 
+class AsyncWorker;
 class MapProjection;
 class Marker;
 class StyleBuilder;
 class StyleContext;
 class View;
+struct StyledMesh;
 
 class MarkerManager {
 
@@ -69,8 +73,9 @@ public:
     bool setPolygon(MarkerID markerID, LngLat* coordinates, int* counts, int rings);
 
     // Update the zoom level for all markers; markers are built for one zoom
-    // level at a time so when the current zoom changes, all marker meshes are
-    // rebuilt. Returns true when any Markers changed since last call to update.
+    // level at a time so when the current zoom changes, meshes of markers with
+    // zoom dependent styling are rebuilt. Returns true when any Markers changed
+    // since last call to update.
     struct UpdateState { bool dirty, easing; };
     UpdateState update(const View& _view, float _dt);
 
@@ -87,22 +92,68 @@ public:
 
     const Marker* getMarkerOrNullBySelectionColor(uint32_t selectionColor) const;
 
+    // Rebuild meshes of markers on zoom change on a worker thread; markers keep their previous mesh until
+    //  the new one is ready. Other builds (new markers, changed styling) remain synchronous.
+    void setAsyncBuilds(bool _async);
+
+    // Wait for pending marker builds and apply their results
+    void waitForBuilds();
+
 private:
 
+    struct BuildResult {
+        Marker* marker = nullptr;
+        std::unique_ptr<StyledMesh> mesh;
+        uint32_t styleId = 0;
+        uint32_t selectionColor = 0;
+        bool zoomDependent = true;
+        bool valid = false;
+    };
+
+    struct BuildBatch {
+        std::vector<BuildResult> results;
+        // JS functions from marker styling added since last batch
+        std::vector<std::string> functions;
+        std::future<void> done;
+        int zoom = 0;
+    };
+
+    // StyleContext and StyleBuilders are not thread safe: one set for main thread, one for worker
+    struct Builders {
+        std::unique_ptr<StyleContext> styleContext;
+        fastmap<std::string, std::unique_ptr<StyleBuilder>> styleBuilders;
+    };
+
     Marker* getMarkerOrNull(MarkerID markerID);
 
     bool setStyling(MarkerID markerID, const char* styling, bool isPath);
     bool buildStyling(Marker& marker);
     bool buildMesh(Marker& marker, int zoom);
+    void buildMesh(Marker& marker, int zoom, Builders& builders, BuildResult& result);
+    void applyBuild(BuildResult& result, int zoom);
+    void initBuilders(Builders& builders);
+    void dispatchBuilds(std::vector<Marker*>& markers);
+    // apply results of finished batches; returns true if any were applied
+    bool applyBuilds(bool wait);
+    // markers with a build in flight must not be modified
+    void finishBuild(Marker& marker);
+    // nor markers with labels being placed
+    void waitForPlacement();
 
     const Scene& m_scene;
     // Custom functions and stops from styling strings
     SceneStops m_stops;
     SceneFunctions m_functions;
 
-    std::unique_ptr<StyleContext> m_styleContext;
+    Builders m_builders;
     std::vector<std::unique_ptr<Marker>> m_markers;
-    fastmap<std::string, std::unique_ptr<StyleBuilder>> m_styleBuilders;
+
+    // used only on m_buildWorker thread
+    Builders m_workerBuilders;
+    std::unique_ptr<AsyncWorker> m_buildWorker;
+    std::deque<BuildBatch> m_buildBatches;
+    // number of m_functions passed to worker
+    size_t m_workerFunctions = 0;
 
     uint32_t m_idCounter = 0;
     int m_zoom = 0;
@@ -3,6 +3,7 @@
 #include "log.h"
 #include "platform.h"
 #include "util/asyncWorker.h"
+#include "util/hash.h"
 #include "util/yamlUtil.h"
 #include "util/zipArchive.h"
 
@@ -54,10 +55,22 @@ YAML::Node Importer::loadSceneData(Platform& _platform, const Url& _sceneUrl, co
         // unlock m_sceneMutex before starting request because callback could be sync or async
         auto cb = [&, nextUrlToImport](UrlResponse&& response) {
             if (m_canceled) { return; }
+            // parse before locking so scene files arriving on different threads are parsed concurrently
+            bool isYaml = !response.error && !isZipArchiveUrl(nextUrlToImport);
+            SceneNode sceneNode;
+            uint64_t hash = 0;
+            if (isYaml) {
+                hash = hash_fnv1a(response.content.data(), response.content.size());
+                sceneNode = parseSceneYaml(nextUrlToImport, response.content.data(), response.content.size());
+            }
             std::unique_lock<std::mutex> _lock(m_sceneMutex);
             if (response.error) {
                 LOGE("Unable to retrieve '%s': %s", nextUrlToImport.string().c_str(),
                      response.error);
+            } else if (isYaml) {
+                LOGD("Process: '%s'", nextUrlToImport.string().c_str());
+                m_sceneHashes[nextUrlToImport] = hash;
+                addSceneNode(nextUrlToImport, std::move(sceneNode));
             } else {
                 addSceneData(nextUrlToImport, std::move(response.content));
             }
@@ -105,15 +118,73 @@ YAML::Node Importer::loadSceneData(Platform& _platform, const Url& _sceneUrl, co
     return root;
 }
 
+// State of fetchSceneHashes() shared with its URL callbacks, which can still run after it returns (on cancel)
+struct Importer::HashFetch {
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<uint64_t> hashes;
+    size_t activeDownloads = 0;
+    bool canceled = false;
+};
+
 void Importer::cancelLoading() {  //Platform& _platform) {
     std::unique_lock<std::mutex> lock(m_sceneMutex);
     m_canceled = true;
     m_sceneCond.notify_all();
+    if (m_hashFetch) {
+        std::lock_guard<std::mutex> fetchLock(m_hashFetch->mutex);
+        m_hashFetch->canceled = true;
+        m_hashFetch->cond.notify_all();
+    }
+}
+
+std::vector<uint64_t> Importer::fetchSceneHashes(Platform& _platform, const std::vector<Url>& _urls) {
+
+    auto fetch = std::make_shared<HashFetch>();
+    fetch->hashes.resize(_urls.size(), 0);
+    fetch->activeDownloads = _urls.size();
+    {
+        std::lock_guard<std::mutex> lock(m_sceneMutex);
+        if (m_canceled) { return {}; }
+        m_hashFetch = fetch;
+    }
+
+    std::vector<UrlRequestHandle> urlRequests;
+    for (size_t i = 0; i < _urls.size(); ++i) {
+        auto cb = [fetch, i](UrlResponse&& response) {
+            std::lock_guard<std::mutex> lock(fetch->mutex);
+            if (!response.error && !fetch->canceled) {
+                fetch->hashes[i] = hash_fnv1a(response.content.data(), response.content.size());
+            }
+            fetch->activeDownloads--;
+            fetch->cond.notify_one();
+        };
+        urlRequests.push_back(_platform.startUrlRequest(_urls[i], cb));
+    }
+
+    bool canceled;
+    {
+        std::unique_lock<std::mutex> lock(fetch->mutex);
+        fetch->cond.wait(lock, [&](){ return fetch->activeDownloads == 0 || fetch->canceled; });
+        canceled = fetch->canceled;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sceneMutex);
+        m_hashFetch.reset();
+    }
+    if (canceled) {
+        for (auto& req : urlRequests) { _platform.cancelUrlRequest(req); }
+        return {};
+    }
+    // all callbacks have run
+    return std::move(fetch->hashes);
 }
 
 void Importer::addSceneData(const Url& sceneUrl, std::vector<char>&& sceneData) {
     LOGD("Process: '%s'", sceneUrl.string().c_str());
 
+    m_sceneHashes[sceneUrl] = hash_fnv1a(sceneData.data(), sceneData.size());
+
     if (!isZipArchiveUrl(sceneUrl)) {
         addSceneYaml(sceneUrl, sceneData.data(), sceneData.size());
         return;
@@ -180,14 +251,18 @@ UrlRequestHandle Importer::readFromZip(const Url& url, UrlCallback callback) {
 }
 
 void Importer::addSceneYaml(const Url& sceneUrl, const char* sceneYaml, size_t length) {
+    addSceneNode(sceneUrl, parseSceneYaml(sceneUrl, sceneYaml, length));
+}
 
-    auto& sceneNode = m_sceneNodes[sceneUrl];
+Importer::SceneNode Importer::parseSceneYaml(const Url& sceneUrl, const char* sceneYaml, size_t length) {
+
+    SceneNode sceneNode;
 
     sceneNode.yaml = YAML::Load(sceneYaml, length);
 
     if (!sceneNode.yaml.IsMap()) {
         LOGE("Scene is not a valid YAML map: %s", sceneUrl.string().c_str());
-        return;
+        return sceneNode;
     }
 
     sceneNode.imports = getResolvedImportUrls(sceneNode.yaml, sceneUrl);
@@ -197,7 +272,15 @@ void Importer::addSceneYaml(const Url& sceneUrl, const char* sceneYaml, size_t l
     // Remove 'import' values so they don't get merged.
     sceneNode.yaml.remove("import");
 
-    for (const auto& url : sceneNode.imports) {
+    return sceneNode;
+}
+
+void Importer::addSceneNode(const Url& sceneUrl, SceneNode&& sceneNode) {
+
+    auto& node = m_sceneNodes[sceneUrl];
+    node = std::move(sceneNode);
+
+    for (const auto& url : node.imports) {
         // Check if this scene URL has been (or is going to be) imported already
         if (m_sceneNodes.find(url) == m_sceneNodes.end()) {
             m_sceneQueue.push_back(url);
@@ -26,13 +26,20 @@ public:
     using Node = YAML::Node;
 
     Importer();
-    ~Importer();
+    virtual ~Importer();
 
     // Loads the main scene with deep merging dependent imported scenes.
     YAML::Node loadSceneData(Platform& platform, const Url& sceneUrl, const std::string& sceneYaml = "");
 
     void cancelLoading();
 
+    // URLs of scene files fetched by loadSceneData() with a hash of their contents
+    const std::unordered_map<Url, uint64_t>& sceneHashes() const { return m_sceneHashes; }
+
+    // Fetch the given scene files and return the hash of their contents, or 0 if a request failed, e.g. to
+    // check if a compiled scene is still valid without parsing scene files
+    std::vector<uint64_t> fetchSceneHashes(Platform& platform, const std::vector<Url>& urls);
+
     static bool isZipArchiveUrl(const Url& url);
 
     static Url getBaseUrlForZipArchive(const Url& archiveUrl);
@@ -81,7 +88,16 @@ protected:
         std::vector<Url> imports;
         std::vector<const YAML::Node*> pendingUrlNodes;
     };
+
+    // Parse scene YAML and find its imports; does not access Importer state, so called without m_sceneMutex
+    //  (virtual for testing)
+    virtual SceneNode parseSceneYaml(const Url& sceneUrl, const char* sceneYaml, size_t length);
+
+    // Store parsed scene and queue its imports
+    void addSceneNode(const Url& sceneUrl, SceneNode&& sceneNode);
+
     std::unordered_map<Url, SceneNode> m_sceneNodes = {};
+    std::unordered_map<Url, uint64_t> m_sceneHashes;
 
     std::vector<Url> m_sceneQueue = {};
 
@@ -89,6 +105,10 @@ protected:
     std::mutex m_sceneMutex;
     std::condition_variable m_sceneCond;
 
+    // fetchSceneHashes() in progress, so cancelLoading() can stop waiting for it
+    struct HashFetch;
+    std::shared_ptr<HashFetch> m_hashFetch;
+
     // Container for any zip archives needed for the scene. For each entry, the
     // key is the original URL from which the zip archive was retrieved and the
     // value is a ZipArchive initialized with the compressed archive data.
@@ -2,6 +2,7 @@
 
 #include "data/tileSource.h"
 #include "data/rasterSource.h"
+#include "debug/trace.h"
 #include "gl/framebuffer.h"
 #include "gl/shaderProgram.h"
 #include "labels/labelManager.h"
@@ -10,6 +11,7 @@
 #include "scene/importer.h"
 #include "scene/light.h"
 #include "scene/sceneLoader.h"
+#include "scene/sceneSnapshot.h"
 #include "scene/spriteAtlas.h"
 #include "scene/stops.h"
 #include "selection/featureSelection.h"
@@ -22,6 +24,7 @@
 #include "style/rasterStyle.h"
 #include "style/style.h"
 #include "text/fontContext.h"
+#include "util/asyncWorker.h"
 #include "util/base64.h"
 #include "util/util.h"
 #include "util/elevationManager.h"
@@ -32,6 +35,10 @@
 #include "scene.h"
 
 #include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <future>
 
 namespace Tangram {
 
@@ -51,8 +58,11 @@ Scene::Scene(Platform& _platform,
     m_prana = std::make_shared<ScenePrana>(this);
     m_tileWorker = std::make_unique<TileWorker>(_platform, m_options.numTileWorkers);
     m_tileManager = std::make_unique<TileManager>(_platform, *m_tileWorker, m_prana);
+    m_tileManager->setTileDataCacheSize(m_options.tileDataCacheSize);
     m_markerManager = std::make_unique<MarkerManager>(*this,
         _oldScene && _options.preserveMarkers ? _oldScene->m_markerManager.get() : NULL);
+    // like tiles, markers are built on the main thread if there are no tile workers
+    m_markerManager->setAsyncBuilds(m_options.numTileWorkers > 0);
 }
 
 ScenePrana::~ScenePrana() {
@@ -73,6 +83,10 @@ Scene::~Scene() {
     // See https://stackoverflow.com/questions/45507041/ to support TileTask w/o ScenePrana set
     m_prana.reset();
 
+    if (m_labelManager) { m_labelManager->waitForPlacement(); }
+    // marker build worker uses styles
+    if (m_markerManager) { m_markerManager->setAsyncBuilds(false); }
+
     cancelTasks();  // normally no-op since this is called on main thread in Map before ~Scene()
     m_tileWorker->stop();  // this waits for worker threads
 
@@ -144,6 +158,19 @@ bool Scene::load() {
 
     LOGTOInit();
     LOGTO(">>>>>> loadScene >>>>>>");
+    TRACE_SCOPE("Scene::load");
+
+    auto loadStart = std::chrono::steady_clock::now();
+    auto elapsedMs = [&]() {
+        return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+    };
+    float stageStart = 0;
+    auto endStage = [&](const char* _name) {
+        float now = elapsedMs();
+        m_loadStages.push_back({_name, stageStart, now, false});
+        stageStart = now;
+        LOGTO("<<< %s", _name);
+    };
 
     //std::unique_lock<std::mutex> sceneLoadLock(m_sceneLoadMutex);
 
@@ -163,49 +190,54 @@ bool Scene::load() {
     ///
     /// Importer is blocking until all imports are loaded
     m_importer = std::make_unique<Importer>();
-    m_config = m_importer->loadSceneData(m_platform, m_options.url, m_options.yaml);
-    LOGTO("<<< applyImports");
-
-    if (isCanceled(State::loading)) { return false; }
-
-    if (!m_config) {
-        LOGE("Scene loading failed: No config!");
-        m_errors.emplace_back(SceneError{{}, Error::no_valid_scene});
-        return false;
-    }
+    if (loadSnapshot()) {
+        endStage("loadSnapshot");
+    } else {
+        m_config = m_importer->loadSceneData(m_platform, m_options.url, m_options.yaml);
+        endStage("applyImports");
+
+        if (isCanceled(State::loading)) { return false; }
+
+        if (!m_config) {
+            LOGE("Scene loading failed: No config!");
+            m_errors.emplace_back(SceneError{{}, Error::no_valid_scene});
+            return false;
+        }
 
-    auto result = SceneLoader::applyUpdates(m_config, m_options.updates);
-    if (result.error != Error::none) {
-        m_errors.push_back(result);
-        LOGE("Applying SceneUpdates failed (error %d)", int(result.error));
-        return false;
-    }
-    LOGTO("<<< applyUpdates");
+        auto result = SceneLoader::applyUpdates(m_config, m_options.updates);
+        if (result.error != Error::none) {
+            m_errors.push_back(result);
+            LOGE("Applying SceneUpdates failed (error %d)", int(result.error));
+            return false;
+        }
+        endStage("applyUpdates");
 
 #ifdef TANGRAM_DUMP_MERGED_SCENE
-    logMsg(YAML::Dump(m_config).c_str());
+        logMsg(YAML::Dump(m_config).c_str());
 #endif
 
-    Importer::resolveSceneUrls(m_config, m_options.url);
+        Importer::resolveSceneUrls(m_config, m_options.url);
 
-    SceneLoader::applyGlobals(m_config, m_config);
-    LOGTO("<<< applyGlobals");
+        SceneLoader::applyGlobals(m_config, m_config);
+        endStage("applyGlobals");
+
+        if (!m_options.compiledScenePath.empty()) {
+            saveSnapshot();
+            endStage("saveSnapshot");
+        }
+    }
 
     m_tileSources = SceneLoader::applySources(m_config, m_options, m_sourceContext);
-    LOGTO("<<< applySources");
+    endStage("applySources");
 
     SceneLoader::applyCameras(m_config, m_camera);
-    LOGTO("<<< applyCameras");
-
-    m_lights = SceneLoader::applyLights(m_config["lights"]);
-    m_lightShaderBlocks = Light::assembleLights(m_lights);
-    LOGTO("<<< applyLights");
+    endStage("applyCameras");
 
     const YAML::Node& sceneNode = m_config["scene"];
     SceneLoader::applyScene(sceneNode, m_background, m_backgroundStops, m_animated);
     bool terrain3d = YamlUtil::getBoolOrDefault(sceneNode["terrain_3d"], false);
     std::string elevSrc = sceneNode["elevation_source"].as<std::string>("");
-    LOGTO("<<< applyScene");
+    endStage("applyScene");
 
     m_tileManager->setTileSources(m_tileSources);
 
@@ -214,25 +246,75 @@ bool Scene::load() {
         m_tilePrefetchCallback(this);
     }
 
+    /// Fallback fonts are loaded on a worker while scene resources are requested and styles and layers
+    /// are parsed - FontContext is not used until styles are set up
+    LoadStage fontStage{"initFonts", 0, 0, true};
     m_fontContext = std::make_unique<FontContext>(m_platform);
-    m_fontContext->loadFonts(m_options.fallbackFonts.empty() ?
-                             m_platform.systemFontFallbacksHandle() : m_options.fallbackFonts);
-    LOGTO("<<< initFonts");
+    auto fontTask = std::make_shared<std::packaged_task<void()>>([&]() {
+        TRACE_SCOPE("Scene initFonts");
+        fontStage.startMs = elapsedMs();
+        m_fontContext->loadFonts(m_options.fallbackFonts.empty() ?
+                                 m_platform.systemFontFallbacksHandle() : m_options.fallbackFonts);
+        fontStage.endMs = elapsedMs();
+    });
+    std::future<void> fontsLoaded = fontTask->get_future();
+    // destroyed (and joined) first on early return, before anything captured by fontTask
+    AsyncWorker loadWorker("Scene load worker");
+    loadWorker.enqueue([fontTask]() { (*fontTask)(); });
+
+    m_lights = SceneLoader::applyLights(m_config["lights"]);
+    m_lightShaderBlocks = Light::assembleLights(m_lights);
+    endStage("applyLights");
 
     SceneLoader::applyFonts(m_config["fonts"], m_fonts);
     runFontTasks();
-    LOGTO("<<< applyFonts");
+    endStage("applyFonts");
 
     SceneLoader::applyTextures(m_config["textures"], m_textures);
     runTextureTasks();
-    LOGTO("<<< textures");
-
-    m_styles = SceneLoader::applyStyles(m_config["styles"], m_textures,
-                                        m_jsFunctions, m_stops, m_names);
-    LOGTO("<<< applyStyles");
+    endStage("applyTextures");
+
+    /// Styles depend only on textures (looked up by name), so they are built on a second worker while
+    /// layers are parsed here. They get their own function, stops and rule name tables, which are merged
+    /// into the scene tables after both are done; the two only read disjoint subtrees of m_config.
+    LoadStage styleStage{"applyStyles", 0, 0, true};
+    SceneFunctions styleFunctions;
+    SceneStops styleStops;
+    DrawRuleNames styleNames;
+    const YAML::Node& config = m_config;  // const [] does not add missing keys, keeping references valid
+    const YAML::Node& stylesNode = config["styles"];
+    const YAML::Node& layersNode = config["layers"];
+    auto styleTask = std::make_shared<std::packaged_task<void()>>([&]() {
+        TRACE_SCOPE("Scene applyStyles");
+        styleStage.startMs = elapsedMs();
+        m_styles = SceneLoader::applyStyles(stylesNode, m_textures, styleFunctions, styleStops, styleNames);
+        styleStage.endMs = elapsedMs();
+    });
+    std::future<void> stylesLoaded = styleTask->get_future();
+    AsyncWorker styleWorker("Scene style worker");
+    styleWorker.enqueue([styleTask]() { (*styleTask)(); });
+
+    m_layers = SceneLoader::applyLayers(layersNode, m_jsFunctions, m_stops, m_names);
+    endStage("applyLayers");
+
+    stylesLoaded.wait();
+    m_loadStages.push_back(styleStage);
+    m_stops.splice(m_stops.end(), styleStops);  // Stops are referenced by pointer, which splice keeps valid
+    for (auto& style : m_styles) {
+        DrawRuleData* rule = style->defaultDrawRule();
+        if (!rule) { continue; }
+        rule->id = SceneLoader::addDrawRuleName(m_names, rule->name);
+        for (auto& param : rule->parameters) {
+            if (param.function >= 0) {
+                param.function = SceneLoader::addSceneFunction(m_jsFunctions, styleFunctions[param.function]);
+            }
+        }
+    }
+    endStage("waitStyles");
 
-    m_layers = SceneLoader::applyLayers(m_config["layers"], m_jsFunctions, m_stops, m_names);
-    LOGTO("<<< applyLayers");
+    fontsLoaded.wait();
+    m_loadStages.push_back(fontStage);
+    endStage("waitFonts");
 
     /// Remove unused styles
     std::set<std::string> activeStyles;
@@ -269,7 +351,7 @@ bool Scene::load() {
         }
     }
     runTextureTasks();
-    LOGTO("<<< sortStyles");
+    endStage("sortStyles");
 
     auto terrainSrcIt = std::find_if(m_tileSources.begin(), m_tileSources.end(),
         [&](auto& src){ return src->isRaster() && src->name() == elevSrc; });
@@ -282,6 +364,7 @@ bool Scene::load() {
               [](auto& style){ return style->type() == StyleType::raster; });
         if (terrainSrc && terrainStyle != m_styles.end()) {
             m_elevationManager = std::make_unique<ElevationManager>(terrainSrc, **terrainStyle);
+            m_elevationManager->setDepthOptions(m_options.cpuTerrainDepth, m_options.terrainDepthResolution);
         } else {
             LOGE("Unable to find elevation source or raster style needed for 3D terrain!");
         }
@@ -290,14 +373,14 @@ bool Scene::load() {
     if (m_elevationManager || (terrainSrc && terrainSrc->TileSource::generateGeometry())) {
         terrainSrc->m_keepTextureData = true;
     }
-    LOGTO("<<< elevationManager");
+    endStage("elevationManager");
 
     // won't be initialized until sky is visible
     m_skyManager = std::make_unique<SkyManager>();
 
     for (auto& style : m_styles) { style->build(*this); }
     if (m_elevationManager) { m_elevationManager->m_style->build(*this); }
-    LOGTO("<<< buildStyles");
+    endStage("buildStyles");
 
     if (isCanceled(State::loading)) { return false; }
 
@@ -315,6 +398,8 @@ bool Scene::load() {
 
     m_featureSelection = std::make_unique<FeatureSelection>();
     m_labelManager = std::make_unique<LabelManager>();
+    m_labelManager->setAsyncPlacement(m_options.asyncLabelPlacement);
+    m_labelManager->setCollisionThreshold(m_options.labelCollisionThreshold);
 
     m_state = State::pending_resources;
 
@@ -406,6 +491,12 @@ bool Scene::load() {
     }
 
     LOGTO("<<<<<< loadScene <<<<<<");
+    for (auto& stage : m_loadStages) {
+        LOGD("Scene load stage %-16s %8.2f - %8.2f ms%s", stage.name, stage.startMs, stage.endMs,
+             stage.worker ? " (worker)" : "");
+    }
+    // stages on this thread ran one after another, so their total is the critical path
+    LOG("Scene loaded in %.2f ms", elapsedMs());
     return true;
 }
 
@@ -550,6 +641,158 @@ std::shared_ptr<Texture> SceneTextures::get(const std::string& _name) {
     return add(_name, Url(_name), options);
 }
 
+void Scene::updateGlobals(const std::vector<SceneUpdate>& _updates, bool _rebuildTiles) {
+    SceneLoader::applyUpdates(m_config, _updates);
+    globalsGeneration++;
+    if (!_rebuildTiles) { return; }
+
+    std::vector<std::string> paths;
+    for (auto& update : _updates) {
+        const char* path = update.path.c_str();
+        if (path[0] == '+') { path++; }
+        if (std::strncmp(path, "global", 6) != 0 || (path[6] && path[6] != '.' && path[6] != '#')) {
+            // other parts of the config are only read on load, so we don't know what depends on them
+            m_tileManager->clearTileSets();
+            return;
+        }
+        paths.push_back(path);
+    }
+    auto sources = sourcesUsingGlobals(m_layers, m_jsFunctions, paths);
+    LOGD("Rebuilding tiles of %d sources for updated globals", int(sources.size()));
+    m_tileManager->rebuildTileSets(sources);
+}
+
+std::set<std::string> Scene::sourcesUsingGlobals(const Layers& _layers, const SceneFunctions& _functions,
+                                                 const std::vector<std::string>& _paths) {
+    std::vector<bool> changed(_functions.size(), false), used(_functions.size(), false);
+    bool anyChanged = false;
+    for (size_t i = 0; i < _functions.size(); i++) {
+        for (auto& path : _paths) {
+            if (functionUsesGlobal(_functions[i], path)) {
+                changed[i] = anyChanged = true;
+                break;
+            }
+        }
+    }
+    std::set<std::string> sources;
+    if (!anyChanged) { return sources; }
+
+    bool affected = false;
+    auto useFunction = [&](int32_t fn) {
+        if (fn < 0 || size_t(fn) >= used.size()) { return; }
+        used[fn] = true;
+        affected = affected || changed[fn];
+    };
+    std::function<void(const Filter&)> visitFilter = [&](const Filter& filter) {
+        auto& data = filter.data;
+        if (data.is<Filter::Function>()) {
+            useFunction(data.get<Filter::Function>().id);
+        } else if (data.is<Filter::OperatorAll>()) {
+            for (auto& f : data.get<Filter::OperatorAll>().operands) { visitFilter(f); }
+        } else if (data.is<Filter::OperatorAny>()) {
+            for (auto& f : data.get<Filter::OperatorAny>().operands) { visitFilter(f); }
+        } else if (data.is<Filter::OperatorNone>()) {
+            for (auto& f : data.get<Filter::OperatorNone>().operands) { visitFilter(f); }
+        }
+    };
+    std::function<void(const SceneLayer&)> visitLayer = [&](const SceneLayer& layer) {
+        visitFilter(layer.filter());
+        for (auto& rule : layer.rules()) {
+            for (auto& param : rule.parameters) { useFunction(param.function); }
+        }
+        for (auto& sublayer : layer.sublayers()) { visitLayer(sublayer); }
+    };
+
+    for (auto& layer : _layers) {
+        affected = false;
+        visitLayer(layer);
+        if (affected) { sources.insert(layer.source()); }
+    }
+    // functions not from data layers (e.g. style draw defaults) can apply to any tile
+    for (size_t i = 0; i < _functions.size(); i++) {
+        if (changed[i] && !used[i]) {
+            for (auto& layer : _layers) { sources.insert(layer.source()); }
+            break;
+        }
+    }
+    return sources;
+}
+
+bool Scene::functionUsesGlobal(const std::string& _function, const std::string& _path) {
+    static const std::string global = "global";
+    auto isIdent = [](char c) { return std::isalnum(uint8_t(c)) || c == '_' || c == '$'; };
+    // path and reference match if one is a prefix of the other
+    auto prefixMatch = [](const std::string& a, const std::string& b) {
+        size_t n = std::min(a.size(), b.size());
+        if (a.compare(0, n, b, 0, n) != 0) { return false; }
+        const std::string& longer = a.size() > b.size() ? a : b;
+        return longer.size() == n || longer[n] == '.' || longer[n] == '#';
+    };
+
+    size_t pos = 0, size = _function.size();
+    while ((pos = _function.find(global, pos)) != std::string::npos) {
+        size_t end = pos + global.size();
+        // skip other identifiers containing "global" and properties named global
+        if ((pos > 0 && (isIdent(_function[pos-1]) || _function[pos-1] == '.')) ||
+            (end < size && isIdent(_function[end]))) {
+            pos = end;
+            continue;
+        }
+        std::string ref = global;
+        while (end + 1 < size && _function[end] == '.' && isIdent(_function[end+1])) {
+            size_t start = ++end;
+            while (end < size && isIdent(_function[end])) { end++; }
+            ref += '.';
+            ref.append(_function, start, end - start);
+        }
+        // global used without a property, e.g. global[key], depends on all of global
+        if (ref == global || prefixMatch(ref, _path)) { return true; }
+        pos = end;
+    }
+    return false;
+}
+
+bool Scene::loadSnapshot() {
+    if (m_options.compiledScenePath.empty()) { return false; }
+
+    SceneSnapshot snapshot;
+    if (!SceneSnapshot::read(m_options.compiledScenePath, SceneSnapshot::inputKey(m_options), snapshot)) {
+        return false;
+    }
+    // local files with unchanged size and mtime are not read and remote imports are trusted while the key
+    //  matches; other local files are read to check their hashes
+    std::vector<Url> urls;
+    std::vector<uint64_t> expected;
+    for (auto& import : snapshot.imports) {
+        if (import.url.hasHttpScheme()) { continue; }
+        if (import.stamp != 0 && SceneSnapshot::fileStamp(import.url) == import.stamp) { continue; }
+        urls.push_back(import.url);
+        expected.push_back(import.hash);
+    }
+    if (!urls.empty()) {
+        auto hashes = m_importer->fetchSceneHashes(m_platform, urls);
+        if (hashes.size() != urls.size()) { return false; }
+        for (size_t i = 0; i < urls.size(); ++i) {
+            if (hashes[i] != expected[i]) {
+                LOGD("Compiled scene is stale: '%s' changed", urls[i].string().c_str());
+                return false;
+            }
+        }
+    }
+    m_config = std::move(snapshot.config);
+    return bool(m_config);
+}
+
+void Scene::saveSnapshot() {
+    SceneSnapshot::Imports imports;
+    for (auto& entry : m_importer->sceneHashes()) {
+        // resources in zip archives are only available after the archive is loaded by Importer
+        if (Importer::isZipArchiveUrl(entry.first) || entry.first.scheme() == "zip") { return; }
+        imports.push_back({entry.first, entry.second, SceneSnapshot::fileStamp(entry.first)});
+    }
+    SceneSnapshot::write(m_options.compiledScenePath, SceneSnapshot::inputKey(m_options), imports, m_config);
+}
+
 void Scene::runTextureTasks() {
 
     std::weak_ptr<ScenePrana> wprana(m_prana);
@@ -651,11 +894,16 @@ Scene::UpdateState Scene::update(RenderState& _rs, View& _view, float _dt) {
 
     m_time += _dt;
 
+    // tiles and markers (and so labels) may be deleted below
+    m_labelManager->waitForPlacement();
+
     bool viewChanged = _view.update();
 
     auto markersState = m_markerManager->update(_view, _dt);
 
-    bool tilesChanged = m_tileManager->updateTileSets(_view);
+    // upload tiles queued last frame within the frame budget, then requeue tiles still waiting
+    _rs.uploads.process(_rs);
+    bool tilesChanged = m_tileManager->updateTileSets(_view, &_rs.uploads);
 
     for (const auto& style : m_styles) {
         style->onBeginUpdate();
@@ -684,6 +932,7 @@ Scene::UpdateState Scene::update(RenderState& _rs, View& _view, float _dt) {
 
 void Scene::renderBeginFrame(RenderState& _rs) {
     _rs.setFrameTime(m_time);
+    _rs.frameStats = {};
     ++frameCount;
 
     for (const auto& style : m_styles) {
@@ -18,6 +18,7 @@
 #include <memory>
 #include <condition_variable>
 #include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 #include <tuple>
@@ -148,6 +149,16 @@ public:
     /// Load the whole Scene
     bool load();
 
+    /// Timing of load() stages in ms from start of load(). Stages not on a worker ran one after another,
+    /// so they make up the critical path; a worker stage only adds the time load() waited for it.
+    struct LoadStage {
+        const char* name;
+        float startMs;
+        float endMs;
+        bool worker;
+    };
+    const std::vector<LoadStage>& loadStages() const { return m_loadStages; }
+
     auto& tileSources() const { return m_tileSources; }
     auto& featureSelection() const { return m_featureSelection; }
     auto& fontContext() const { return m_fontContext; }
@@ -194,6 +205,7 @@ public:
     TileManager* tileManager() const { return m_tileManager.get(); }
     LabelManager* labelManager() const { return m_labelManager.get(); }
     MarkerManager* markerManager() const { return m_markerManager.get(); }
+    Platform& platform() const { return m_platform; }
     ElevationManager* elevationManager() const { return m_elevationManager.get(); }
 
     const SceneError* errors() const {
@@ -241,6 +253,18 @@ public:
     using Styles = std::vector<std::unique_ptr<Style>>;
     using Layers = std::vector<DataLayer>;
 
+    /// Apply SceneUpdates to globals, which JS functions read when tiles are built. With _rebuildTiles,
+    /// only tiles of sources with data layers using an updated global are rebuilt, and current tiles are
+    /// drawn until their replacements are ready; updates outside of globals rebuild all tiles.
+    void updateGlobals(const std::vector<SceneUpdate>& _updates, bool _rebuildTiles);
+
+    /// Names of sources of data layers with functions using a global at any of _paths (e.g. "global.color")
+    static std::set<std::string> sourcesUsingGlobals(const Layers& _layers, const SceneFunctions& _functions,
+                                                     const std::vector<std::string>& _paths);
+
+    /// True if JS function source references global at _path, a parent or a child of it, or global itself
+    static bool functionUsesGlobal(const std::string& _function, const std::string& _path);
+
 protected:
 
     Platform& m_platform;
@@ -250,6 +274,8 @@ protected:
 
     std::unique_ptr<Importer> m_importer;
 
+    std::vector<LoadStage> m_loadStages;
+
     /// Only SceneUpdate errors for now
     std::vector<SceneError> m_errors;
 
@@ -288,6 +314,10 @@ protected:
     Lights m_lights;
     LightShaderBlocks m_lightShaderBlocks;
 
+    /// Set m_config from SceneOptions::compiledScenePath if the local scene files are unchanged
+    bool loadSnapshot();
+    void saveSnapshot();
+
     void runTextureTasks();
     SceneTextures m_textures;
 
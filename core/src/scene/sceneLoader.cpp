@@ -1,6 +1,7 @@
 #include "scene/sceneLoader.h"
 
 #include "data/clientDataSource.h"
+#include "data/contourSource.h"
 #include "data/memoryCacheDataSource.h"
 #include "data/mbtilesDataSource.h"
 #include "data/networkDataSource.h"
@@ -580,6 +581,8 @@ Scene::TileSources SceneLoader::applySources(const Node& _config, const SceneOpt
     }
     for (const auto& source : sources.pairs()) {
         std::string srcName = source.first.Scalar();
+        // contour sources are created below, once their elevation sources exist
+        if (source.second["type"].as<std::string>("") == "Contour") { continue; }
         if (auto tileSource = loadSource(source.second, srcName, _options, _context)) {
             tileSources.push_back(std::move(tileSource));
         }
@@ -592,6 +595,13 @@ Scene::TileSources SceneLoader::applySources(const Node& _config, const SceneOpt
         return nullptr;
     };
 
+    for (const auto& source : sources.pairs()) {
+        if (source.second["type"].as<std::string>("") != "Contour") { continue; }
+        if (auto tileSource = loadContourSource(source.second, source.first.Scalar(), getTileSource)) {
+            tileSources.push_back(std::move(tileSource));
+        }
+    }
+
     // Add Raster subsources
     for (const auto& source : sources.pairs()) {
         std::string srcName = source.first.Scalar();
@@ -658,6 +668,50 @@ Scene::TileSources SceneLoader::applySources(const Node& _config, const SceneOpt
     return tileSources;
 }
 
+std::shared_ptr<TileSource> SceneLoader::loadContourSource(const Node& _source, const std::string& _name,
+        const std::function<std::shared_ptr<TileSource>(const std::string&)>& _getTileSource) {
+
+    std::string demName = _source["elevation_source"].as<std::string>("");
+    auto demSource = _getTileSource(demName);
+    if (!demSource || !demSource->isRaster()) {
+        LOGE("Contour source '%s' requires a Raster elevation_source. This source will be ignored.",
+             _name.c_str());
+        return nullptr;
+    }
+
+    // contour interval by zoom, e.g. [[11, 100], [13, 50], [14, 20], [15, 10]]
+    ContourSource::Intervals intervals;
+    const Node& intervalsNode = _source["intervals"];
+    if (intervalsNode && !intervalsNode.IsSequence()) {
+        LOGNode("Invalid 'intervals'", intervalsNode, "");
+    } else if (intervalsNode) {
+        for (const auto& stop : intervalsNode) {
+            int zoom = 0;
+            float interval = 0;
+            if (!stop.IsSequence() || stop.size() != 2 || !YamlUtil::getInt(stop[0], zoom)
+                    || !YamlUtil::getFloat(stop[1], interval)) {
+                LOGNode("Invalid contour interval", stop, "");
+                continue;
+            }
+            intervals.emplace_back(zoom, interval);
+        }
+    } else {
+        intervals = { {11, 100.0f}, {13, 50.0f}, {14, 20.0f}, {15, 10.0f} };
+    }
+    int indexInterval = YamlUtil::getIntOrDefault(_source["index_interval"], 5);
+
+    TileSource::ZoomOptions zoomOptions{};
+    if (const auto& minDisplayZoomNode = _source["min_display_zoom"]) {
+        YamlUtil::getInt(minDisplayZoomNode, zoomOptions.minDisplayZoom);
+    }
+    if (const auto& maxDisplayZoomNode = _source["max_display_zoom"]) {
+        YamlUtil::getInt(maxDisplayZoomNode, zoomOptions.maxDisplayZoom);
+    }
+
+    return std::make_shared<ContourSource>(_name, std::static_pointer_cast<RasterSource>(demSource),
+                                           std::move(intervals), indexInterval, zoomOptions);
+}
+
 std::shared_ptr<TileSource> SceneLoader::loadSource(const Node& _source, const std::string& _name,
                                                     const SceneOptions& _options, DataSourceContext& _context) {
 
@@ -826,7 +880,10 @@ std::shared_ptr<TileSource> SceneLoader::loadSource(const Node& _source, const s
                 LOGW("Invalid texture filtering: %s", Dump(filtering).c_str());
             }
         }
-        sourcePtr = std::make_shared<RasterSource>(_name, std::move(rawSources), options, zoomOptions);
+        auto rasterSource = std::make_shared<RasterSource>(_name, std::move(rawSources), options, zoomOptions);
+        rasterSource->setCacheSize(_options.rasterCacheSize);
+        rasterSource->m_compressTextures = YamlUtil::getBoolOrDefault(_source["compress"], false);
+        sourcePtr = rasterSource;
     } else {
         sourcePtr = std::make_shared<TileSource>(_name, std::move(rawSources), zoomOptions);
 
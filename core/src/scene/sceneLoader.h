@@ -4,6 +4,7 @@
 #include "map.h"
 #include "scene/scene.h"
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -66,6 +67,9 @@ struct SceneLoader {
     static std::shared_ptr<TileSource> loadSource(const Node& _source, const std::string& _name,
                                                   const SceneOptions& _options, DataSourceContext& _context);
 
+    static std::shared_ptr<TileSource> loadContourSource(const Node& _source, const std::string& _name,
+            const std::function<std::shared_ptr<TileSource>(const std::string&)>& _getTileSource);
+
     /// Styles
     static Scene::Styles applyStyles(const Node& stylesNode, SceneTextures& textures, SceneFunctions& functions,
                                      SceneStops& stops, DrawRuleNames& ruleNames);
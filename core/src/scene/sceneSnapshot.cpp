@@ -0,0 +1,233 @@
+#include "scene/sceneSnapshot.h"
+
+#include "log.h"
+#include "sceneOptions.h"
+#include "util/hash.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+
+namespace Tangram {
+
+using YAML::Node;
+using YAML::Tag;
+
+// increment if the format or the processing of the config before it is saved changes
+static const char SNAPSHOT_MAGIC[8] = {'T', 'G', 'S', 'C', 'E', 'N', 'E', '2'};
+
+static void writeVarint(std::string& _out, uint64_t _value) {
+    while (_value >= 0x80) {
+        _out.push_back(char(_value | 0x80));
+        _value >>= 7;
+    }
+    _out.push_back(char(_value));
+}
+
+static bool readVarint(const char*& _pos, const char* _end, uint64_t& _value) {
+    _value = 0;
+    for (int shift = 0; _pos < _end && shift < 64; shift += 7) {
+        uint8_t byte = uint8_t(*_pos++);
+        _value |= uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) { return true; }
+    }
+    return false;
+}
+
+template<typename T>
+static void writeRaw(std::string& _out, T _value) {
+    _out.append(reinterpret_cast<const char*>(&_value), sizeof(T));
+}
+
+template<typename T>
+static bool readRaw(const char*& _pos, const char* _end, T& _value) {
+    if (size_t(_end - _pos) < sizeof(T)) { return false; }
+    std::memcpy(&_value, _pos, sizeof(T));
+    _pos += sizeof(T);
+    return true;
+}
+
+static void writeString(std::string& _out, const std::string& _str) {
+    writeVarint(_out, _str.size());
+    _out.append(_str);
+}
+
+static bool readString(const char*& _pos, const char* _end, std::string& _str) {
+    uint64_t length;
+    if (!readVarint(_pos, _end, length) || length > uint64_t(_end - _pos)) { return false; }
+    _str.assign(_pos, length);
+    _pos += length;
+    return true;
+}
+
+uint64_t SceneSnapshot::inputKey(const SceneOptions& _options) {
+    std::string input(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    writeString(input, _options.url.string());
+    writeString(input, _options.yaml);
+    for (auto& update : _options.updates) {
+        writeString(input, update.path);
+        writeString(input, update.value);
+    }
+    return hash_fnv1a(input.data(), input.size());
+}
+
+uint64_t SceneSnapshot::fileStamp(const Url& _url) {
+    if (!_url.hasFileScheme()) { return 0; }
+
+    struct stat info;
+    if (stat(_url.path().c_str(), &info) != 0) { return 0; }
+    // a file modified again within the same second would keep its stamp
+    if (std::difftime(std::time(nullptr), info.st_mtime) < 2) { return 0; }
+
+    std::string stamp;
+    writeVarint(stamp, uint64_t(info.st_size));
+    writeVarint(stamp, uint64_t(info.st_mtime));
+    return std::max(hash_fnv1a(stamp.data(), stamp.size()), uint64_t(1));
+}
+
+void SceneSnapshot::serialize(const Node& _node, std::string& _out) {
+    writeVarint(_out, uint32_t(_node.getFlags()));
+
+    switch (_node.getTag()) {
+    case Tag::NUMBER:
+        writeRaw(_out, _node.getNumber());
+        break;
+    case Tag::JSON_BOOL:
+        _out.push_back(char(_node.getBoolean()));
+        break;
+    case Tag::STRING:
+    case Tag::YAML_COMMENT:
+        writeString(_out, _node.getString());
+        break;
+    case Tag::ARRAY:
+    case Tag::OBJECT: {
+        bool isMap = _node.IsMap();
+        writeVarint(_out, _node.size());
+        for (auto* item : _node.items()) {
+            if (isMap) { serialize(item->key, _out); }
+            serialize(item->value, _out);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+bool SceneSnapshot::deserialize(const char*& _pos, const char* _end, Node& _node) {
+    uint64_t bits;
+    if (!readVarint(_pos, _end, bits)) { return false; }
+    Tag flags = Tag(bits);
+
+    switch (flags & Tag::TYPE_MASK) {
+    case Tag::NUMBER: {
+        double value;
+        if (!readRaw(_pos, _end, value)) { return false; }
+        _node = Node(value, flags);
+        return true;
+    }
+    case Tag::JSON_BOOL: {
+        if (_pos >= _end) { return false; }
+        _node = Node(*_pos++ != 0, flags);
+        return true;
+    }
+    case Tag::STRING:
+    case Tag::YAML_COMMENT: {
+        std::string str;
+        if (!readString(_pos, _end, str)) { return false; }
+        _node = Node(std::move(str), flags);
+        return true;
+    }
+    case Tag::ARRAY:
+    case Tag::OBJECT: {
+        bool isMap = (flags & Tag::TYPE_MASK) == Tag::OBJECT;
+        uint64_t count;
+        // each item takes at least one byte - reject corrupt counts before allocating
+        if (!readVarint(_pos, _end, count) || count > uint64_t(_end - _pos)) { return false; }
+
+        YAML::ListNode* head = nullptr;
+        YAML::ListNode** next = &head;
+        bool ok = true;
+        for (uint64_t i = 0; i < count && ok; ++i) {
+            auto* item = new YAML::ListNode{Node(), nullptr, Node()};
+            *next = item;
+            next = &item->next;
+            if (isMap) { ok = deserialize(_pos, _end, item->key); }
+            ok = ok && deserialize(_pos, _end, item->value);
+        }
+        // node owns (and on failure frees) the items
+        _node = Node(flags, head);
+        return ok;
+    }
+    default:
+        _node = Node(flags);
+        return true;
+    }
+}
+
+bool SceneSnapshot::write(const std::string& _path, uint64_t _key, const Imports& _imports, const Node& _config) {
+    std::string data(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    writeRaw(data, _key);
+    writeVarint(data, _imports.size());
+    for (auto& import : _imports) {
+        writeString(data, import.url.string());
+        writeRaw(data, import.hash);
+        writeRaw(data, import.stamp);
+    }
+    serialize(_config, data);
+
+    // replace atomically so a concurrent or interrupted write never leaves a partial snapshot
+    std::string tmpPath = _path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file.write(data.data(), data.size())) {
+            LOGE("Cannot write compiled scene '%s'", tmpPath.c_str());
+            return false;
+        }
+    }
+    std::remove(_path.c_str());
+    if (std::rename(tmpPath.c_str(), _path.c_str()) != 0) {
+        LOGE("Cannot write compiled scene '%s'", _path.c_str());
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool SceneSnapshot::read(const std::string& _path, uint64_t _key, SceneSnapshot& _snapshot) {
+    std::ifstream file(_path, std::ios::binary);
+    if (!file) { return false; }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    const char* pos = data.data();
+    const char* end = pos + data.size();
+
+    uint64_t key;
+    if (data.size() < sizeof(SNAPSHOT_MAGIC) || std::memcmp(pos, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+        return false;
+    }
+    pos += sizeof(SNAPSHOT_MAGIC);
+    if (!readRaw(pos, end, key) || key != _key) { return false; }
+
+    uint64_t count;
+    if (!readVarint(pos, end, count) || count > uint64_t(end - pos)) { return false; }
+    _snapshot.imports.clear();
+    for (uint64_t i = 0; i < count; ++i) {
+        std::string url;
+        uint64_t hash, stamp;
+        if (!readString(pos, end, url) || !readRaw(pos, end, hash) || !readRaw(pos, end, stamp)) { return false; }
+        _snapshot.imports.push_back({Url(url), hash, stamp});
+    }
+
+    if (!deserialize(pos, end, _snapshot.config) || pos != end) {
+        LOGW("Invalid compiled scene '%s'", _path.c_str());
+        return false;
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "util/url.h"
+
+#include "gaml/src/yaml.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Tangram {
+
+class SceneOptions;
+
+/* Compiled scene snapshot
+ *
+ * The scene config after imports are merged and scene updates, URL resolution and globals are applied,
+ * stored in a compact binary form which loads without parsing or merging the scene YAML. A
+ * snapshot is valid for a key derived from SceneOptions (scene URL or YAML string and updates) and for
+ * the contents of the local scene files it was built from, checked by size and mtime first. Remote
+ * imports are not fetched again while the key matches, so changes to them are only picked up after the
+ * snapshot file is removed.
+ *
+ * Only the config is stored: layers, filters, draw rules, stops and styles are still parsed from it by
+ * SceneLoader on each load, so this saves the import fetches and YAML parsing and merging only.
+ */
+struct SceneSnapshot {
+
+    struct Import {
+        Url url;
+        uint64_t hash;  // of file contents
+        uint64_t stamp;  // fileStamp() when snapshot was written, 0 if none
+    };
+    using Imports = std::vector<Import>;
+
+    // scene files the config was built from
+    Imports imports;
+    YAML::Node config;
+
+    // key for scene inputs other than the contents of scene files
+    static uint64_t inputKey(const SceneOptions& options);
+
+    // Size and modification time of a local scene file, to validate it without reading it; 0 for other
+    // URLs, missing files and files modified too recently for their (1s resolution) mtime to be trusted
+    static uint64_t fileStamp(const Url& url);
+
+    static bool write(const std::string& path, uint64_t key, const Imports& imports, const YAML::Node& config);
+
+    // returns false if file is missing or invalid, or was written for a different key
+    static bool read(const std::string& path, uint64_t key, SceneSnapshot& snapshot);
+
+    static void serialize(const YAML::Node& node, std::string& out);
+    // returns false if data is truncated or invalid
+    static bool deserialize(const char*& pos, const char* end, YAML::Node& node);
+};
+
+}
@@ -0,0 +1,179 @@
+#include "selection/featureIndex.h"
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Tangram {
+
+static int cellCoord(float _x) {
+    int cell = int(std::floor(_x * FeatureIndex::GRID_SIZE));
+    return std::min(std::max(cell, 0), FeatureIndex::GRID_SIZE - 1);
+}
+
+static float segmentDistance(glm::vec2 _p, glm::vec2 _a, glm::vec2 _b) {
+    glm::vec2 ab = _b - _a;
+    float len2 = glm::dot(ab, ab);
+    float t = len2 > 0 ? glm::clamp(glm::dot(_p - _a, ab) / len2, 0.f, 1.f) : 0.f;
+    return glm::distance(_p, _a + t * ab);
+}
+
+void FeatureIndex::addPart(const Line& _points, IndexedFeature& _feature) {
+    if (_points.empty()) { return; }
+
+    m_parts.push_back({uint32_t(m_points.size()), uint32_t(m_points.size() + _points.size())});
+    for (auto& p : _points) {
+        m_points.push_back(p);
+        _feature.min = glm::min(_feature.min, p);
+        _feature.max = glm::max(_feature.max, p);
+    }
+}
+
+void FeatureIndex::add(const Feature& _feature, uint32_t _selectionColor, uint32_t _order,
+                       float _halfWidth, float _pixelHalfWidth) {
+
+    IndexedFeature feature;
+    feature.color = _selectionColor;
+    feature.order = _order;
+    feature.type = _feature.geometryType;
+    feature.halfWidth = _halfWidth;
+    feature.pixelHalfWidth = _pixelHalfWidth;
+    feature.partsBegin = m_parts.size();
+    feature.min = glm::vec2(std::numeric_limits<float>::max());
+    feature.max = glm::vec2(std::numeric_limits<float>::lowest());
+
+    switch (_feature.geometryType) {
+    case GeometryType::points:
+        for (auto& point : _feature.points) { addPart({point}, feature); }
+        break;
+    case GeometryType::lines:
+        for (auto& line : _feature.lines) { addPart(line, feature); }
+        break;
+    case GeometryType::polygons:
+        for (auto& polygon : _feature.polygons) {
+            for (auto& ring : polygon) { addPart(ring, feature); }
+        }
+        break;
+    default:
+        break;
+    }
+
+    feature.partsEnd = m_parts.size();
+    if (feature.partsBegin == feature.partsEnd) { return; }
+
+    m_maxPixelHalfWidth = std::max(m_maxPixelHalfWidth, _pixelHalfWidth);
+    m_features.push_back(feature);
+}
+
+void FeatureIndex::build() {
+
+    const size_t nCells = GRID_SIZE * GRID_SIZE;
+    m_cells.assign(nCells + 1, 0);
+
+    auto forEachCell = [](const IndexedFeature& f, auto _fn) {
+        int x0 = cellCoord(f.min.x - f.halfWidth), x1 = cellCoord(f.max.x + f.halfWidth);
+        int y0 = cellCoord(f.min.y - f.halfWidth), y1 = cellCoord(f.max.y + f.halfWidth);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) { _fn(y * GRID_SIZE + x); }
+        }
+    };
+
+    // count, then fill features per cell
+    for (auto& f : m_features) {
+        forEachCell(f, [&](int cell) { m_cells[cell + 1]++; });
+    }
+    for (size_t i = 0; i < nCells; i++) { m_cells[i + 1] += m_cells[i]; }
+
+    m_cellFeatures.resize(m_cells[nCells]);
+    std::vector<uint32_t> fill(m_cells.begin(), m_cells.end() - 1);
+    for (size_t i = 0; i < m_features.size(); i++) {
+        forEachCell(m_features[i], [&](int cell) { m_cellFeatures[fill[cell]++] = i; });
+    }
+}
+
+float FeatureIndex::distance(const IndexedFeature& _feature, glm::vec2 _pos) const {
+
+    float minDistance = std::numeric_limits<float>::max();
+    bool inside = false;
+
+    for (uint32_t i = _feature.partsBegin; i < _feature.partsEnd; i++) {
+        auto& part = m_parts[i];
+        const glm::vec2* points = &m_points[part.begin];
+        uint32_t n = part.end - part.begin;
+
+        if (n == 1 || _feature.type == GeometryType::points) {
+            minDistance = std::min(minDistance, glm::distance(_pos, points[0]));
+            continue;
+        }
+
+        bool closed = _feature.type == GeometryType::polygons;
+        for (uint32_t j = closed ? 0 : 1, k = closed ? n - 1 : 0; j < n; k = j++) {
+            glm::vec2 a = points[k], b = points[j];
+            minDistance = std::min(minDistance, segmentDistance(_pos, a, b));
+            // even-odd rule across all rings, so holes and multipolygons need no special handling
+            if (closed && ((a.y > _pos.y) != (b.y > _pos.y)) &&
+                (_pos.x < (b.x - a.x) * (_pos.y - a.y) / (b.y - a.y) + a.x)) {
+                inside = !inside;
+            }
+        }
+    }
+
+    return inside ? 0.f : minDistance;
+}
+
+uint32_t FeatureIndex::pick(glm::vec2 _pos, float _radius, float _tileUnitsPerPixel, float* _distance) const {
+
+    if (m_cells.empty()) { return 0; }
+
+    float reach = _radius + m_maxPixelHalfWidth * _tileUnitsPerPixel;
+    int x0 = cellCoord(_pos.x - reach), x1 = cellCoord(_pos.x + reach);
+    int y0 = cellCoord(_pos.y - reach), y1 = cellCoord(_pos.y + reach);
+
+    int best = -1;
+    float bestDistance = 0;
+
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int cell = y * GRID_SIZE + x;
+            for (uint32_t i = m_cells[cell]; i < m_cells[cell + 1]; i++) {
+                uint32_t idx = m_cellFeatures[i];
+                if (int(idx) == best) { continue; }
+
+                auto& f = m_features[idx];
+                float extent = f.halfWidth + f.pixelHalfWidth * _tileUnitsPerPixel;
+                float margin = extent + _radius;
+                if (_pos.x < f.min.x - margin || _pos.x > f.max.x + margin ||
+                    _pos.y < f.min.y - margin || _pos.y > f.max.y + margin) {
+                    continue;
+                }
+
+                float d = std::max(distance(f, _pos) - extent, 0.f);
+                if (d > _radius) { continue; }
+
+                // nearest wins; then the one drawn on top
+                if (best < 0 || d < bestDistance ||
+                    (d == bestDistance && (f.order > m_features[best].order ||
+                                           (f.order == m_features[best].order && int(idx) > best)))) {
+                    best = idx;
+                    bestDistance = d;
+                }
+            }
+        }
+    }
+
+    if (best < 0) { return 0; }
+    if (_distance) { *_distance = bestDistance; }
+    return m_features[best].color;
+}
+
+size_t FeatureIndex::memoryUsage() const {
+    return m_features.capacity() * sizeof(IndexedFeature) +
+        m_parts.capacity() * sizeof(Part) +
+        m_points.capacity() * sizeof(glm::vec2) +
+        (m_cells.capacity() + m_cellFeatures.capacity()) * sizeof(uint32_t);
+}
+
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "data/tileData.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Tangram {
+
+/* FeatureIndex - geometry of the interactive features of a tile, for picking without a selection render pass
+ *
+ * Coordinates are tile units (see <TileData>). Features are bucketed by bounding box into a uniform grid
+ * covering the tile. A pick matches the feature nearest to the query position, like reading the selection
+ * buffer: polygons match when they contain the position, lines and points when within pick radius plus
+ * their styled extent (half line width plus outline, or half point size).
+ */
+class FeatureIndex {
+
+public:
+
+    static constexpr int GRID_SIZE = 16;
+
+    // Add geometry of _feature selected by _selectionColor; on equal distance a feature with higher _order
+    // wins. Line or point extent is given as _halfWidth in tile units plus _pixelHalfWidth in pixels.
+    void add(const Feature& _feature, uint32_t _selectionColor, uint32_t _order,
+             float _halfWidth = 0, float _pixelHalfWidth = 0);
+
+    // Bucket features into the grid; must be called after all features are added and before pick()
+    void build();
+
+    // Return selection color of the feature nearest to _pos within _radius (both in tile units), or 0;
+    // _tileUnitsPerPixel scales the pixel widths of features. Distance to the feature is set in _distance.
+    uint32_t pick(glm::vec2 _pos, float _radius, float _tileUnitsPerPixel, float* _distance = nullptr) const;
+
+    bool empty() const { return m_features.empty(); }
+    size_t size() const { return m_features.size(); }
+
+    size_t memoryUsage() const;
+
+private:
+
+    struct Part {
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    struct IndexedFeature {
+        uint32_t color;
+        uint32_t order;
+        GeometryType type;
+        float halfWidth;
+        float pixelHalfWidth;
+        // range in m_parts
+        uint32_t partsBegin;
+        uint32_t partsEnd;
+        glm::vec2 min;
+        glm::vec2 max;
+    };
+
+    // distance from _pos to feature geometry, 0 if inside a polygon
+    float distance(const IndexedFeature& _feature, glm::vec2 _pos) const;
+
+    void addPart(const Line& _points, IndexedFeature& _feature);
+
+    std::vector<IndexedFeature> m_features;
+    std::vector<Part> m_parts;
+    std::vector<glm::vec2> m_points;
+
+    // feature indices per grid cell: m_cellFeatures[m_cells[i]] .. m_cellFeatures[m_cells[i+1]]
+    std::vector<uint32_t> m_cells;
+    std::vector<uint32_t> m_cellFeatures;
+
+    // features are bucketed with their tile unit width; the query area is grown by max pixel width
+    float m_maxPixelHalfWidth = 0;
+};
+
+}
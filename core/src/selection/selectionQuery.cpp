@@ -5,9 +5,12 @@
 #include "labels/labelManager.h"
 #include "marker/marker.h"
 #include "marker/markerManager.h"
+#include "selection/featureIndex.h"
 #include "tile/tileManager.h"
 #include "view/view.h"
 
+#include "glm/geometric.hpp"
+
 #include <cmath>
 
 namespace Tangram {
@@ -15,6 +18,51 @@ namespace Tangram {
 SelectionQuery::SelectionQuery(glm::vec2 _position, float _radius, QueryCallback _queryCallback)
     : m_position(_position), m_radius(_radius), m_queryCallback(_queryCallback) {}
 
+void SelectionQuery::processFeatureIndex(View& _view, const TileManager& _tileManager) const {
+
+    auto& cb = m_queryCallback.get<FeaturePickCallback>();
+
+    // query position and pixel size on the ground, relative to view position
+    glm::dvec2 position = _view.screenToGroundPlane(m_position.x, m_position.y);
+    double metersPerPixel = glm::length(_view.screenToGroundPlane(m_position.x + 1, m_position.y) - position);
+    // feature widths are in logical pixels, screen coordinates in physical pixels
+    double metersPerLogicalPixel = metersPerPixel * _view.pixelScale();
+    double radius = m_radius * metersPerLogicalPixel;
+
+    std::shared_ptr<Properties> props;
+    float minDistance = 0;
+    int minProxyDepth = 0;
+
+    for (const auto& tile : _tileManager.getVisibleTiles()) {
+        auto* index = tile->featureIndex();
+        if (!index || index->empty()) { continue; }
+
+        double scale = tile->getScale();
+        glm::vec2 tileCoord((position - _view.getRelativeMeters(tile->getOrigin())) / scale);
+        float distance = 0;
+        uint32_t color = index->pick(tileCoord, radius / scale, metersPerLogicalPixel / scale, &distance);
+        if (color == 0) { continue; }
+
+        // compare in meters; proxies are drawn beneath the tiles they stand in for
+        distance *= scale;
+        if (!props || distance < minDistance || (distance == minDistance && tile->proxyDepth() < minProxyDepth)) {
+            if (auto p = tile->getSelectionFeature(color)) {
+                props = p;
+                minDistance = distance;
+                minProxyDepth = tile->proxyDepth();
+            }
+        }
+    }
+
+    if (!props) {
+        cb(nullptr);
+        return;
+    }
+
+    FeaturePickResult queryResult(props, {{m_position.x, m_position.y}});
+    cb(&queryResult);
+}
+
 QueryType SelectionQuery::type() const {
     return m_queryCallback.is<FeaturePickCallback>() ? QueryType::feature :
           (m_queryCallback.is<LabelPickCallback>() ? QueryType::label : QueryType::marker);
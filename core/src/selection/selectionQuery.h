@@ -35,6 +35,9 @@ public:
                  const TileManager& _tileManager, const LabelManager& _labelManager,
                  std::vector<SelectionColorRead>& _cache) const;
 
+    // Resolve a feature query with the FeatureIndex of visible tiles instead of the selection buffer
+    void processFeatureIndex(View& _view, const TileManager& _tileManager) const;
+
     QueryType type() const;
 
 private:
@@ -39,15 +39,24 @@ struct PolygonVertexNoUVs {
     glm::i8vec3 norm;
     uint8_t padding = 0;
     GLuint abgr;
-    GLuint selection;
+    GLuint selection; // last, so it can be left out by compact vertex layout
 };
 
-struct PolygonVertex : PolygonVertexNoUVs {
+struct PolygonVertex {
 
     PolygonVertex(glm::vec3 position, uint32_t order, glm::vec3 normal, glm::vec2 uv, GLuint abgr, GLuint selection)
-        : PolygonVertexNoUVs(position, order, normal, uv, abgr, selection), texcoord(uv * texture_scale) {}
+        : pos(glm::i16vec4{ nearbyint(position * position_scale), order }),
+          norm(normal * normal_scale),
+          abgr(abgr),
+          texcoord(uv * texture_scale),
+          selection(selection) {}
 
+    glm::i16vec4 pos; // pos.w contains layer (params.order)
+    glm::i8vec3 norm;
+    uint8_t padding = 0;
+    GLuint abgr;
     glm::u16vec2 texcoord;
+    GLuint selection; // last, so it can be left out by compact vertex layout
 };
 
 PolygonStyle::PolygonStyle(std::string _name, Blending _blendMode, GLenum _drawMode, bool _selection)
@@ -63,8 +72,8 @@ void PolygonStyle::constructVertexLayout() {
             {"a_position", 4, GL_SHORT, false, 0},
             {"a_normal", 4, GL_BYTE, true, 0}, // The 4th byte is for padding
             {"a_color", 4, GL_UNSIGNED_BYTE, true, 0},
-            {"a_selection_color", 4, GL_UNSIGNED_BYTE, true, 0},
             {"a_texcoord", 2, GL_UNSIGNED_SHORT, true, 0},
+            {"a_selection_color", 4, GL_UNSIGNED_BYTE, true, 0},
         }));
     } else {
         m_vertexLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
@@ -104,12 +113,14 @@ public:
         m_tileUnitsPerMeter = _tile.getInverseScale();
         m_zoom = _tile.getID().z;
         m_meshData.clear();
+        m_hasSelection = false;
     }
 
     void setup(const Marker& _marker, int zoom) override {
         m_zoom = zoom;
         m_tileUnitsPerMeter = 1.f / _marker.extent();
         m_meshData.clear();
+        m_hasSelection = false;
     }
 
     bool addPolygon(const Polygon& _polygon, const Properties& _props, const DrawRule& _rule) override;
@@ -134,6 +145,8 @@ private:
 
     float m_tileUnitsPerMeter = 0;
     int m_zoom = 0;
+    // any interactive features added; if not, mesh is built without selection colors
+    bool m_hasSelection = false;
 
 };
 
@@ -141,8 +154,15 @@ template <class V>
 std::unique_ptr<StyledMesh> PolygonStyleBuilder<V>::build() {
     if (m_meshData.vertices.empty()) { return nullptr; }
 
-    auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(),
-                                                      m_style.drawMode());
+    auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(m_hasSelection),
+                                          m_style.drawMode());
+    if (m_lodResolution > 0 && m_style.drawMode() == GL_TRIANGLES) {
+        // roof and wall vertices have different normals
+        int cellSize = std::max(1, int(position_scale / m_lodResolution));
+        m_meshData.buildLodIndices(cellSize, [](const V& v) {
+            return uint8_t(v.norm.x) << 8 | uint8_t(v.norm.y);
+        });
+    }
     mesh->compile(m_meshData);
     m_meshData.clear();
 
@@ -170,6 +190,7 @@ auto PolygonStyleBuilder<V>::parseRule(const DrawRule& _rule, const Properties&
     p.height = getUpperExtrudeMeters(extrude, _props) * m_tileUnitsPerMeter;
 
     p.selectionColor = _rule.selectionColor;
+    m_hasSelection |= p.selectionColor != 0;
     return p;
 }
 
@@ -49,20 +49,30 @@ struct PolylineVertexNoUVs {
     glm::i16vec4 pos;
     glm::i16vec4 extrude;
     GLuint abgr;
-    GLuint selection;
+    GLuint selection; // last, so it can be left out by compact vertex layout
 };
 
-struct PolylineVertex : PolylineVertexNoUVs {
+struct PolylineVertex {
     PolylineVertex(glm::vec2 position, glm::vec2 extrude, glm::vec2 uv,
                    glm::i16vec2 width, glm::i16vec2 height, GLuint abgr, GLuint selection)
-        : PolylineVertexNoUVs(position, extrude, uv, width, height, abgr, selection),
-          texcoord(uv * texture_scale) {}
+        : pos(glm::i16vec2{ nearbyint(position * position_scale)}, height),
+          extrude(glm::i16vec2{extrude * extrusion_scale}, width),
+          abgr(abgr),
+          texcoord(uv * texture_scale),
+          selection(selection) {}
 
     PolylineVertex(PolylineVertex v, short order, glm::i16vec2 width, GLuint abgr, GLuint selection)
-        : PolylineVertexNoUVs(v, order, width, abgr, selection),
-          texcoord(v.texcoord) {}
+        : pos(glm::i16vec4{glm::i16vec3{v.pos}, order}),
+          extrude(glm::i16vec4{ v.extrude.x, v.extrude.y, width }),
+          abgr(abgr),
+          texcoord(v.texcoord),
+          selection(selection) {}
 
+    glm::i16vec4 pos;
+    glm::i16vec4 extrude;
+    GLuint abgr;
     glm::u16vec2 texcoord;
+    GLuint selection; // last, so it can be left out by compact vertex layout
 };
 
 PolylineStyle::PolylineStyle(std::string _name, Blending _blendMode, GLenum _drawMode, bool _selection)
@@ -79,8 +89,8 @@ void PolylineStyle::constructVertexLayout() {
             {"a_position", 4, GL_SHORT, false, 0},
             {"a_extrude", 4, GL_SHORT, false, 0},
             {"a_color", 4, GL_UNSIGNED_BYTE, true, 0},
-            {"a_selection_color", 4, GL_UNSIGNED_BYTE, true, 0},
             {"a_texcoord", 2, GL_UNSIGNED_SHORT, false, 0},
+            {"a_selection_color", 4, GL_UNSIGNED_BYTE, true, 0},
         }));
     } else {
         m_vertexLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
@@ -213,6 +223,8 @@ private:
     float m_tileUnitsPerPixel = 0;
     int m_zoom = 0;
     float m_overzoom2 = 1;
+    // any interactive features added; if not, mesh is built without selection colors
+    bool m_hasSelection = false;
 };
 
 template <class V>
@@ -225,6 +237,7 @@ void PolylineStyleBuilder<V>::setup(const Tile& tile) {
     m_overzoom2 = exp2(id.s - id.z);
     m_tileUnitsPerMeter = tile.getInverseScale();
     m_tileUnitsPerPixel = 1.f / MapProjection::tileSize();
+    m_hasSelection = false;
 
     // When a tile is overzoomed, we are actually styling the area of its
     // 'source' tile, which will have a larger effective pixel size at the
@@ -244,6 +257,7 @@ void PolylineStyleBuilder<V>::setup(const Marker& marker, int zoom) {
     // "tile size" for building a Marker is the size of a tile in pixels multiplied
     // by the ratio of the Marker's extent to the length of a tile side at this zoom.
     m_tileUnitsPerPixel = metersPerTile / (marker.extent() * 256.f);
+    m_hasSelection = false;
 
 }
 
@@ -254,7 +268,17 @@ std::unique_ptr<StyledMesh> PolylineStyleBuilder<V>::build() {
         return nullptr;
     }
 
-    auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(), m_style.drawMode());
+    auto mesh = std::make_unique<Mesh<V>>(m_style.vertexLayout(m_hasSelection), m_style.drawMode());
+
+    if (m_lodResolution > 0 && m_style.drawMode() == GL_TRIANGLES) {
+        int cellSize = std::max(1, int(position_scale / m_lodResolution));
+        float lodResolution = m_lodResolution;
+        for (auto& meshData : m_meshData) {
+            meshData.buildLodIndices(cellSize, [lodResolution](const V& v) {
+                return PolylineStyle::lodClusterKey(v.extrude.x, v.extrude.y, v.extrude.z, lodResolution);
+            });
+        }
+    }
 
     bool painterMode = (m_style.blendMode() == Blending::overlay ||
                         m_style.blendMode() == Blending::inlay);
@@ -368,6 +392,7 @@ auto PolylineStyleBuilder<V>::parseRule(const DrawRule& _rule, const Properties&
     }
 
     p.selectionColor = _rule.selectionColor;
+    m_hasSelection |= p.selectionColor != 0;
 
     return p;
 }
@@ -512,6 +537,18 @@ void PolylineStyleBuilder<V>::addMesh(const Line& _line, const Parameters& _para
     }
 }
 
+uint32_t PolylineStyle::lodClusterKey(int _extrudeX, int _extrudeY, int _width, float _lodResolution) {
+    if (_extrudeX == 0 && _extrudeY == 0) { return 8u << 26; }
+    // octant keeps the two sides of a line apart, so lines under a pixel wide do not collapse
+    uint32_t octant = (_extrudeX < 0) << 2 | (_extrudeY < 0) << 1 | (std::abs(_extrudeX) < std::abs(_extrudeY));
+    // join and cap fan vertices share the centerline position, so quantize the extrusion itself to half
+    //  a pixel; width is at the styling zoom, which is its screen size whenever decimated indices are drawn
+    float scale = 2 * _lodResolution * std::abs(_width) / (extrusion_scale * extrusion_scale);
+    int qx = std::max(-4095, std::min(int(std::floor(_extrudeX * scale + 0.5f)), 4095));
+    int qy = std::max(-4095, std::min(int(std::floor(_extrudeY * scale + 0.5f)), 4095));
+    return octant << 26 | uint32_t(qx & 0x1FFF) << 13 | uint32_t(qy & 0x1FFF);
+}
+
 std::unique_ptr<StyleBuilder> PolylineStyle::createBuilder() const {
     if (m_texCoordsGeneration) {
         auto builder = std::make_unique<PolylineStyleBuilder<PolylineVertex>>(*this);
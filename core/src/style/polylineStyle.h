@@ -23,6 +23,11 @@ public:
 
     void setDashBackgroundColor(const glm::vec4 _dashBackgroundColor);
 
+    /* Cluster key for decimated geometry (see StyleBuilder::setLodResolution): vertices at the same position
+     * are merged only if their packed extrusions (a_extrude.xy, width a_extrude.z) end up within about half
+     * a pixel of each other on a tile drawn _lodResolution pixels wide */
+    static uint32_t lodClusterKey(int _extrudeX, int _extrudeY, int _width, float _lodResolution);
+
 private:
 
     std::vector<float> m_dashArray;
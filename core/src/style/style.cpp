@@ -41,6 +41,14 @@ void Style::build(const Scene& _scene) {
     constructVertexLayout();
     constructShaderProgram();
 
+    // attribute locations are bound by index, so leaving out the last attribute keeps the others valid
+    auto attribs = m_vertexLayout->getAttribs();
+    m_compactVertexLayout.reset();
+    if (!attribs.empty() && attribs.back().name == "a_selection_color") {
+        attribs.pop_back();
+        m_compactVertexLayout = std::make_shared<VertexLayout>(attribs);
+    }
+
     const char* blendingDefine = "";
     switch (m_blend) {
     case Blending::opaque: blendingDefine = "#define TANGRAM_BLEND_OPAQUE\n"; break;
@@ -377,7 +385,7 @@ void Style::drawSelectionFrame(RenderState& _rs, const Marker& _marker) {
 
     auto* mesh = _marker.mesh();
 
-    if (!mesh) { return; }
+    if (!mesh || !mesh->hasSelection()) { return; }
 
     m_selectionProgram->setUniformMatrix4f(_rs, m_selectionUniforms.uModel, _marker.modelMatrix());
     m_selectionProgram->setUniformf(_rs, m_selectionUniforms.uTileOrigin,
@@ -393,7 +401,8 @@ void Style::drawSelectionFrame(Tangram::RenderState& rs, const Tangram::Tile& _t
 
     auto& styleMesh = _tile.getMesh(*this);
 
-    if (!styleMesh) { return; }
+    // meshes without selection colors have no selectable features
+    if (!styleMesh || !styleMesh->hasSelection()) { return; }
 
     int prevTexUnit = rs.currentTextureUnit();
     setupTileShaderUniforms(rs, _tile, *m_selectionProgram, m_selectionUniforms);
@@ -470,10 +479,16 @@ bool Style::draw(RenderState& rs, const Tile& _tile) {
     int prevTexUnit = rs.currentTextureUnit();
     setupTileShaderUniforms(rs, _tile, *m_shaderProgram, m_mainUniforms);
 
-    if (!styleMesh->draw(rs, *m_shaderProgram)) {
+    uint32_t lodSaved = rs.frameStats.lodTrianglesSaved;
+    bool drawn = _tile.useLod() ? styleMesh->drawLod(rs, *m_shaderProgram)
+                                : styleMesh->draw(rs, *m_shaderProgram);
+    if (!drawn) {
         LOGN("Mesh built by style %s cannot be drawn", m_name.c_str());
         styleMeshDrawn = false;
     }
+    if (_tile.isProxy()) {
+        rs.frameStats.proxyLodTrianglesSaved += rs.frameStats.lodTrianglesSaved - lodSaved;
+    }
 
     rs.resetTextureUnit(prevTexUnit);
 
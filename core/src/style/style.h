@@ -66,8 +66,24 @@ enum class RasterType : uint8_t {
 
 struct StyledMesh {
     virtual bool draw(RenderState& rs, ShaderProgram& _shader, bool _useVao = true) = 0;
+    /* Draw lower level of detail geometry, if the mesh has any */
+    virtual bool drawLod(RenderState& rs, ShaderProgram& _shader, bool _useVao = true) {
+        return draw(rs, _shader, _useVao);
+    }
     virtual size_t bufferSize() const = 0;
 
+    /* Number of vertices and their size in bytes, for stats */
+    virtual size_t vertexCount() const { return 0; }
+    virtual size_t vertexBytes() const { return 0; }
+
+    /* False if built with a vertex layout without selection colors; such meshes are skipped by selection pass */
+    virtual bool hasSelection() const { return true; }
+
+    /* Bytes still to be sent to the GPU before this mesh can be drawn */
+    virtual size_t pendingUploadSize() const { return 0; }
+    /* Upload pending buffers ahead of first draw (see UploadScheduler) */
+    virtual void uploadBuffers(RenderState& rs) {}
+
     virtual ~StyledMesh() {}
 };
 
@@ -101,6 +117,13 @@ public:
     virtual void addSelectionItems(LabelCollider& _layout) {}
 
     virtual const Style& style() const = 0;
+
+    /* Also build decimated geometry for tile drawn _pixels wide, moving vertices by up to about 1.5 pixels
+     *  (1 pixel cells plus half pixel line extrusion steps); 0 disables */
+    void setLodResolution(float _pixels) { m_lodResolution = _pixels; }
+
+protected:
+    float m_lodResolution = 0;
 };
 
 /* Means of constructing and rendering map geometry
@@ -136,6 +159,10 @@ protected:
     /* <VertexLayout> shared between meshes using this style */
     std::shared_ptr<VertexLayout> m_vertexLayout;
 
+    /* m_vertexLayout without trailing a_selection_color, for meshes without interactive features;
+     * only set if the style's vertices have selection color as last member */
+    std::shared_ptr<VertexLayout> m_compactVertexLayout;
+
     /* Stores default style draw rules*/
     std::unique_ptr<DrawRuleData> m_defaultDrawRule = nullptr;
 
@@ -216,7 +243,7 @@ public:
 
     virtual ~Style();
 
-    StyleType type() { return m_type; }
+    StyleType type() const { return m_type; }
 
     static bool compare(std::unique_ptr<Style>& a, std::unique_ptr<Style>& b) {
 
@@ -322,6 +349,7 @@ public:
     std::vector<StyleUniform>& styleUniforms() { return m_mainUniforms.styleUniforms; }
 
     void setDefaultDrawRule(std::unique_ptr<DrawRuleData>&& _rule);
+    DrawRuleData* defaultDrawRule() { return m_defaultDrawRule.get(); }
     void applyDefaultDrawRules(DrawRule& _rule) const;
 
     virtual std::unique_ptr<StyleBuilder> createBuilder() const = 0;
@@ -329,6 +357,10 @@ public:
     GLenum drawMode() const { return m_drawMode; }
     float pixelScale() const { return m_pixelScale; }
     const auto& vertexLayout() const { return m_vertexLayout; }
+    /* Layout for meshes with (_selection) or without selection colors */
+    const auto& vertexLayout(bool _selection) const {
+        return _selection || !m_compactVertexLayout ? m_vertexLayout : m_compactVertexLayout;
+    }
 
     bool hasColorShaderBlock() const { return m_hasColorShaderBlock; }
 
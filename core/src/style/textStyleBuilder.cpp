@@ -159,6 +159,12 @@ std::unique_ptr<StyledMesh> TextStyleBuilder::build() {
             labels.push_back(std::move(label));
         }
 
+        // Release glyph textures only referenced by dropped labels so they can be reused
+        std::bitset<FontContext::max_textures> usedRefs;
+        for (auto& quad : quads) { usedRefs[quad.atlas] = true; }
+        m_style.context()->releaseAtlas(m_atlasRefs & ~usedRefs);
+        m_atlasRefs = usedRefs;
+
         m_textLabels->setLabels(labels);
         m_textLabels->setQuads(std::move(quads), m_atlasRefs);
     }
@@ -86,6 +86,8 @@ void FontContext::releaseFonts()
   m_textures.clear();
   m_textures.push_back(std::make_unique<GlyphTexture>());
   m_atlasRefCount = {{0}};
+  m_atlasLastUse = {{0}};
+  m_pendingRefs.reset();
 }
 
 void FontContext::flushTextTexture() {
@@ -136,6 +138,20 @@ void FontContext::bindTexture(RenderState& rs, int _id, GLuint _unit) {
 // Synchronized on m_fontMutex in layoutText(), called on tile-worker threads
 int FontContext::addTexture() {
     std::lock_guard<std::mutex> lock(m_textureMutex);
+
+    // Reuse least recently used texture not referenced by any TextLabels or by the text being laid out;
+    //  its glyphs are discarded from fontstash and will be rendered again if needed
+    int reuse = -1;
+    for (int i = 0; i < int(m_textures.size()); i++) {
+        if (m_atlasRefCount[i] > 0 || m_pendingRefs[i]) { continue; }
+        if (reuse < 0 || m_atlasLastUse[i] < m_atlasLastUse[reuse]) { reuse = i; }
+    }
+    if (reuse >= 0) {
+        LOGD("Reusing glyph texture %d", reuse);
+        fonsResetAtlasRows(m_fons, reuse * GlyphTexture::size, (reuse + 1) * GlyphTexture::size);
+        return reuse;
+    }
+
     if (m_textures.size() == max_textures) {
         LOGE("Way too many glyph textures!");
         return -1;
@@ -146,6 +162,8 @@ int FontContext::addTexture() {
     m_textures.push_back(std::make_unique<GlyphTexture>());
     fonsGetAtlasSize(m_fons, &iw, &ih, NULL);
     fonsExpandAtlas(m_fons, iw, ih + GlyphTexture::size);
+    // new glyphs go in new texture (previous fill position may have been in a reused texture)
+    fonsResetAtlasRows(m_fons, ih, ih + GlyphTexture::size);
     return m_textures.size() - 1;
 }
 
@@ -183,6 +201,7 @@ bool FontContext::layoutLine(TextStyle::Parameters& _params, float x, float y,
         int texidx = int(q.t1*(ih/GlyphTexture::size));
         int s0 = int(q.s0 * iw), t0 = int(q.t0 * ih) - texidx*GlyphTexture::size;
         int s1 = int(q.s1 * iw), t1 = int(q.t1 * ih) - texidx*GlyphTexture::size;
+        m_pendingRefs[texidx] = true;
         _quads.push_back({size_t(texidx),
                 {{{x0, y0}, {s0, t0}},
                  {{x0, y1}, {s0, t1}},
@@ -246,6 +265,8 @@ bool FontContext::layoutText(TextStyle::Parameters& _params /*in*/, const std::s
     std::lock_guard<std::mutex> fontlock(m_fontMutex);
 
     size_t quadsStart = _quads.size();
+    m_pendingRefs.reset();
+    m_layoutCount++;
 
     if(_params.wordWrap) {
 
@@ -314,6 +335,7 @@ bool FontContext::layoutText(TextStyle::Parameters& _params /*in*/, const std::s
                 _refs[it->atlas] = true;
                 m_atlasRefCount[it->atlas] += 1;
             }
+            m_atlasLastUse[it->atlas] = m_layoutCount;
 
             it->quad[0].pos -= offset;
             it->quad[1].pos -= offset;
@@ -321,13 +343,7 @@ bool FontContext::layoutText(TextStyle::Parameters& _params /*in*/, const std::s
             it->quad[3].pos -= offset;
         }
 
-        // Clear unused textures
-        //for (size_t i = 0; i < m_textures.size(); i++) {
-        //    if (m_atlasRefCount[i] == 0) {
-        //        m_atlas.clear(i);
-        //        std::memset(m_textures[i]->buffer(), 0, GlyphTexture::size * GlyphTexture::size);
-        //    }
-        //}
+        // unused textures are reused by addTexture() when needed
     }
 
     return true;
@@ -46,7 +46,7 @@ public:
 
     void setPixelScale(float _scale);
 
-    // called for memory warning or almost out of GlyphTextures; tiles and markers must be rebuilt
+    // called for memory warning or if all GlyphTextures are in use; tiles and markers must be rebuilt
     void releaseFonts();
 
 private:
@@ -64,6 +64,11 @@ private:
     float m_sdfRadius;
     FONScontext* m_fons;
     std::array<int, max_textures> m_atlasRefCount = {{0}};
+    // for choosing least recently used unreferenced texture to reuse
+    std::array<uint64_t, max_textures> m_atlasLastUse = {{0}};
+    uint64_t m_layoutCount = 0;
+    // textures used by text being laid out, not yet counted in m_atlasRefCount
+    std::bitset<max_textures> m_pendingRefs;
     std::vector< std::vector<char> > m_sources;
     std::vector<std::unique_ptr<GlyphTexture>> m_textures;
     Platform& m_platform;
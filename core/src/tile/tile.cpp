@@ -1,6 +1,9 @@
 #include "tile/tile.h"
 
+#include "debug/trace.h"
+#include "gl/renderState.h"
 #include "labels/labelSet.h"
+#include "selection/featureIndex.h"
 #include "style/style.h"
 #include "tile/tileID.h"
 #include "util/mapProjection.h"
@@ -47,6 +50,10 @@ void Tile::update(const View& _view, float _dt) {
     m_modelMatrix[3][1] = static_cast<float>(originRelativeMeters.y);
 
     m_mvp = _view.getViewProjectionMatrix() * m_modelMatrix;
+
+    if (m_lodResolution > 0) {
+        m_lodError = m_scale * _view.pixelsPerMeter() / m_lodResolution;
+    }
 }
 
 void Tile::resetState() {
@@ -77,6 +84,10 @@ void Tile::setSelectionFeatures(const fastmap<uint32_t, std::shared_ptr<Properti
     m_selectionFeatures = _selectionFeatures;
 }
 
+void Tile::setFeatureIndex(std::unique_ptr<FeatureIndex> _index) {
+    m_featureIndex = std::move(_index);
+}
+
 std::shared_ptr<Properties> Tile::getSelectionFeature(uint32_t _id) const {
     auto it = m_selectionFeatures.find(_id);
     if (it != m_selectionFeatures.end()) {
@@ -97,9 +108,43 @@ size_t Tile::getMemoryUsage() const {
                 m_memoryUsage += raster.texture->bufferSize();
             }
         }
+        if (m_featureIndex) {
+            m_memoryUsage += m_featureIndex->memoryUsage();
+        }
     }
 
     return m_memoryUsage;
 }
 
+size_t Tile::pendingUploadSize() const {
+    size_t bytes = 0;
+    for (auto& entry : m_geometry) {
+        if (entry) { bytes += entry->pendingUploadSize(); }
+    }
+    for (auto& raster : m_rasters) {
+        if (raster.texture) { bytes += raster.texture->pendingUploadSize(); }
+    }
+    return bytes;
+}
+
+size_t Tile::upload(RenderState& _rs) {
+    TRACE_SCOPE_TILE("upload", m_id);
+    size_t bytes = _rs.uploads.frameBytes();
+    for (auto& entry : m_geometry) {
+        if (entry) { entry->uploadBuffers(_rs); }
+    }
+    for (auto& raster : m_rasters) {
+        if (raster.texture && raster.texture->pendingUploadSize() > 0) {
+            raster.texture->bind(_rs, 0);
+        }
+    }
+    m_uploaded = true;
+    return _rs.uploads.frameBytes() - bytes;
+}
+
+bool Tile::isUploaded() const {
+    if (!m_uploaded) { m_uploaded = pendingUploadSize() == 0; }
+    return m_uploaded;
+}
+
 }
@@ -7,6 +7,7 @@
 
 #include "glm/mat4x4.hpp"
 #include "glm/vec2.hpp"
+#include <cmath>
 #include <map>
 #include <memory>
 #include <string>
@@ -14,8 +15,10 @@
 
 namespace Tangram {
 
+class FeatureIndex;
 class MapProjection;
 struct Properties;
+class RenderState;
 class Style;
 class View;
 struct StyledMesh;
@@ -73,6 +76,11 @@ public:
 
     const auto& getSelectionFeatures() const { return m_selectionFeatures; }
 
+    /* Geometry of selection features for CPU picking; null unless SceneOptions::cpuFeaturePicking is set */
+    void setFeatureIndex(std::unique_ptr<FeatureIndex> _index);
+
+    const FeatureIndex* featureIndex() const { return m_featureIndex.get(); }
+
     auto& rasters() { return m_rasters; }
     const auto& rasters() const { return m_rasters; }
 
@@ -84,6 +92,14 @@ public:
     /* Get the sum in bytes of static <Mesh>es */
     size_t getMemoryUsage() const;
 
+    /* Bytes of mesh and raster data not yet sent to the GPU */
+    size_t pendingUploadSize() const;
+
+    /* Send all pending mesh and raster data to the GPU; returns bytes uploaded */
+    size_t upload(RenderState& _rs);
+
+    bool isUploaded() const;
+
     int64_t sourceGeneration() const { return m_sourceGeneration; }
 
     int32_t sourceID() const { return m_sourceId; }
@@ -93,6 +109,15 @@ public:
 
     void setProxyDepth(int8_t _depth) { m_proxyDepth = _depth; }
 
+    /* Width in pixels for which decimated mesh geometry was built (see TileBuilder); 0 if none */
+    void setLodResolution(float _pixels) { m_lodResolution = _pixels; }
+
+    /* Draw decimated geometry: error is under 1 pixel at current view, or for proxy tiles, which are shown
+     * at up to 2^proxyDepth scale only until replaced, under 2^(proxyDepth + 1) pixels */
+    bool useLod() const {
+        return m_lodResolution > 0 && m_lodError < (isProxy() ? std::ldexp(2.f, m_proxyDepth) : 1.f);
+    }
+
 private:
 
     const TileID m_id;
@@ -107,6 +132,10 @@ private:
 
     int8_t m_proxyDepth = 0;
 
+    float m_lodResolution = 0;
+    // size in pixels of decimation cell at current view
+    float m_lodError = 0;
+
     glm::dvec2 m_tileOrigin; // South-West corner of the tile in 2D projection space in meters (e.g. mercator meters)
 
     glm::mat4 m_modelMatrix; // Matrix relating tile-local coordinates to global projection space coordinates;
@@ -122,8 +151,12 @@ private:
 
     mutable size_t m_memoryUsage = 0;
 
+    mutable bool m_uploaded = false;
+
     fastmap<uint32_t, std::shared_ptr<Properties>> m_selectionFeatures;
 
+    std::unique_ptr<FeatureIndex> m_featureIndex;
+
 };
 
 }
@@ -7,11 +7,17 @@
 #include "log.h"
 #include "scene/dataLayer.h"
 #include "scene/scene.h"
+#include "scene/stops.h"
+#include "selection/featureIndex.h"
 #include "selection/featureSelection.h"
 #include "tile/tile.h"
 #include "util/mapProjection.h"
 #include "view/view.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
 namespace Tangram {
 
 TileBuilder::TileBuilder(const Scene& _scene)
@@ -42,6 +48,88 @@ StyleBuilder* TileBuilder::getStyleBuilder(const std::string& _name) {
     return it->second.get();
 }
 
+// Add time and allocations between construction and destruction to a BuildStats entry; no-op if _entry is null
+struct TileBuilder::StatsScope {
+    using clock = std::chrono::steady_clock;
+
+    StatsScope(const BuildStats* _stats, BuildStats::Entry* _entry) : stats(_stats), entry(_entry) {
+        if (!entry) { return; }
+        if (stats->allocCounter) { stats->allocCounter(allocs, bytes); }
+        start = clock::now();
+    }
+
+    ~StatsScope() {
+        if (!entry) { return; }
+        entry->seconds += std::chrono::duration<double>(clock::now() - start).count();
+        if (stats->allocCounter) {
+            uint64_t endAllocs = 0, endBytes = 0;
+            stats->allocCounter(endAllocs, endBytes);
+            entry->allocs += endAllocs - allocs;
+            entry->allocBytes += endBytes - bytes;
+        }
+    }
+
+    const BuildStats* stats;
+    BuildStats::Entry* entry;
+    uint64_t allocs = 0, bytes = 0;
+    clock::time_point start;
+};
+
+// Add _scale times the width parameter _width to pixel or tile unit extent, as in PolylineStyleBuilder::evalWidth
+static void pickWidth(const StyleParam& _width, float _scale, float _tileUnitsPerMeter,
+                      float& _halfWidth, float& _pixelHalfWidth) {
+    if (_width.stops) {
+        if (_width.value.is<float>()) { _pixelHalfWidth += _scale * _width.value.get<float>(); }
+    } else if (_width.value.is<StyleParam::Width>()) {
+        auto& widthParam = _width.value.get<StyleParam::Width>();
+        if (widthParam.isMeter()) {
+            _halfWidth += _scale * widthParam.value * _tileUnitsPerMeter;
+        } else {
+            _pixelHalfWidth += _scale * widthParam.value;
+        }
+    }
+}
+
+// Extent of the geometry drawn with _rule beyond the feature geometry, for picking: half the line width
+//  plus outline width for lines and outlines (PolylineStyleBuilder::parseRule); half the size plus outline
+//  width for points (PointStyleBuilder::evalSizeParam; sizes relative to a sprite are unknown here and
+//  left out). Text is only placed at label layout and has no extent.
+static void pickExtent(const DrawRule& _rule, StyleType _type, float _zoom, float _tileUnitsPerMeter,
+                       float& _halfWidth, float& _pixelHalfWidth) {
+    float halfWidth = 0, pixelHalfWidth = 0;
+
+    if (_type == StyleType::polyline || _rule.findParameter(StyleParamKey::outline_style)) {
+        auto& width = _rule.findParameter(StyleParamKey::width);
+        if (!width) { return; }
+        pickWidth(width, .5f, _tileUnitsPerMeter, halfWidth, pixelHalfWidth);
+        // outline is drawn on both sides of the line
+        auto& outlineWidth = _rule.findParameter(StyleParamKey::outline_width);
+        bool outlineVisible = true;
+        _rule.get(StyleParamKey::outline_visible, outlineVisible);
+        if (outlineWidth && outlineVisible) {
+            pickWidth(outlineWidth, 1.f, _tileUnitsPerMeter, halfWidth, pixelHalfWidth);
+        }
+    } else if (_type == StyleType::point) {
+        glm::vec2 size(NAN);
+        auto& sizeParam = _rule.findParameter(StyleParamKey::size);
+        StyleParam::SizeValue sizeValue;
+        if (sizeParam.stops) {
+            size = sizeParam.stops->evalSize(_zoom, glm::vec2(NAN));
+        } else if (_rule.get(StyleParamKey::size, sizeValue)) {
+            size = sizeValue.getSizePixels(glm::vec2(NAN));
+        }
+        if (std::isnan(size.x) || std::isnan(size.y)) { return; }
+        pixelHalfWidth = .5f * std::max(size.x, size.y);
+        auto& outlineWidth = _rule.findParameter(StyleParamKey::outline_width);
+        if (outlineWidth && outlineWidth.value.is<StyleParam::Width>()) {
+            pixelHalfWidth += .5f * outlineWidth.value.get<StyleParam::Width>().value;
+        }
+    }
+
+    _halfWidth = std::max(_halfWidth, halfWidth);
+    _pixelHalfWidth = std::max(_pixelHalfWidth, pixelHalfWidth);
+}
+
 void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer) {
 
     // If no rules matched the feature, return immediately
@@ -50,6 +138,10 @@ void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer
     uint32_t selectionColor = 0;
     bool added = false;
 
+    // for feature index
+    uint32_t pickOrder = 0;
+    float pickHalfWidth = 0, pickPixelHalfWidth = 0;
+
     // For each matched rule, find the style to be used and
     // build the feature with the rule's parameters
     for (auto& rule : m_ruleSet.matchedRules()) {
@@ -79,6 +171,9 @@ void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer
             rule.selectionColor = 0;
         }
 
+        BuildStats::Entry* styleEntry = m_stats ? &m_stats->styles[rule.getStyleName()] : nullptr;
+        StatsScope styleStats(m_stats, styleEntry);
+
         // build outline explicitly with outline style
         const auto& outlineStyleName = rule.findParameter(StyleParamKey::outline_style);
         if (outlineStyleName) {
@@ -94,11 +189,24 @@ void TileBuilder::applyStyling(const Feature& _feature, const SceneLayer& _layer
         }
 
         // build feature with style
-        added |= builder->addFeature(_feature, rule);
+        bool styled = builder->addFeature(_feature, rule);
+        if (styled && styleEntry) { styleEntry->features++; }
+
+        if (styled && m_featureIndex && rule.selectionColor != 0) {
+            uint32_t order = 0;
+            rule.get(StyleParamKey::order, order);
+            pickOrder = std::max(pickOrder, order);
+            pickExtent(rule, builder->style().type(), m_pickZoom, m_tileUnitsPerMeter,
+                       pickHalfWidth, pickPixelHalfWidth);
+        }
+        added |= styled;
     }
 
     if (added && (selectionColor != 0)) {
         m_selectionFeatures[selectionColor] = std::make_shared<Properties>(_feature.props);
+        if (m_featureIndex) {
+            m_featureIndex->add(_feature, selectionColor, pickOrder, pickHalfWidth, pickPixelHalfWidth);
+        }
     }
 }
 
@@ -106,6 +214,13 @@ void TileBuilder::build(Tile& tile, const TileData& _tileData, const TileSource&
 
     m_selectionFeatures.clear();
 
+    if (m_scene.options().cpuFeaturePicking) {
+        m_featureIndex = std::make_unique<FeatureIndex>();
+        // same scaling as PolylineStyleBuilder for overzoomed tiles
+        m_tileUnitsPerMeter = tile.getInverseScale() * exp2(tile.getID().s - tile.getID().z);
+        m_pickZoom = tile.getID().s;
+    }
+
     tile.initGeometry(int(m_scene.styles().size()));
 
     m_styleContext->setTileID(tile.getID());
@@ -115,14 +230,28 @@ void TileBuilder::build(Tile& tile, const TileData& _tileData, const TileSource&
       m_styleContext->setSceneGlobals(m_scene.config()["global"]);
     }
 
+    // decimated geometry is accurate to ~1px for tile drawn at its styling zoom and source tile size
+    float lodResolution = 0;
+    if (m_scene.options().tileGeometryLod) {
+        const auto& id = tile.getID();
+        lodResolution = MapProjection::tileSize() * exp2(_source.zoomBias() + id.s - id.z);
+    }
+    tile.setLodResolution(lodResolution);
+
     for (auto& builder : m_styleBuilder) {
-        if (builder.second) { builder.second->setup(tile); }
+        if (builder.second) {
+            builder.second->setLodResolution(lodResolution);
+            builder.second->setup(tile);
+        }
     }
 
     for (const auto& datalayer : m_scene.layers()) {
 
         if (datalayer.source() != _source.name() || !datalayer.enabled()) { continue; }
 
+        BuildStats::Entry* layerEntry = m_stats ? &m_stats->layers[datalayer.name()] : nullptr;
+        StatsScope layerStats(m_stats, layerEntry);
+
         for (const auto& collection : _tileData.layers) {
 
             if (!collection.name.empty()) {
@@ -136,6 +265,7 @@ void TileBuilder::build(Tile& tile, const TileData& _tileData, const TileSource&
             for (const auto& feat : collection.features) {
                 applyStyling(feat, datalayer);
             }
+            if (layerEntry) { layerEntry->features += collection.features.size(); }
         }
     }
 
@@ -149,10 +279,25 @@ void TileBuilder::build(Tile& tile, const TileData& _tileData, const TileSource&
     m_labelLayout.process(tile.getID(), tile.getInverseScale(), tileSize);
 
     for (auto& builder : m_styleBuilder) {
-        tile.setMesh(builder.second->style(), builder.second->build());
+        BuildStats::Entry* styleEntry = m_stats ? &m_stats->styles[builder.first] : nullptr;
+        StatsScope styleStats(m_stats, styleEntry);
+        auto mesh = builder.second->build();
+        if (mesh && styleEntry) {
+            auto& layout = builder.second->style().vertexLayout();
+            styleEntry->meshBytes += mesh->bufferSize();
+            styleEntry->vertices += mesh->vertexCount();
+            styleEntry->vertexBytes += mesh->vertexBytes();
+            styleEntry->fullVertexBytes += mesh->vertexCount() * (layout ? layout->getStride() : 0);
+        }
+        tile.setMesh(builder.second->style(), std::move(mesh));
     }
 
     tile.setSelectionFeatures(m_selectionFeatures);
+
+    if (m_featureIndex) {
+        m_featureIndex->build();
+        tile.setFeatureIndex(std::move(m_featureIndex));
+    }
 }
 
 }
@@ -6,9 +6,13 @@
 #include "scene/drawRule.h"
 #include "style/style.h"
 
+#include <map>
+#include <string>
+
 namespace Tangram {
 
 class DataLayer;
+class FeatureIndex;
 class Tile;
 class TileSource;
 struct Feature;
@@ -19,6 +23,28 @@ class TileBuilder {
 
 public:
 
+    // Optional time and allocation breakdown of tile builds, for benchmarks
+    struct BuildStats {
+        struct Entry {
+            double seconds = 0;
+            uint64_t allocs = 0;
+            uint64_t allocBytes = 0;
+            uint64_t features = 0;
+            // built meshes (styles only): total buffer size and vertices, with the layout used and
+            //  with the style's full vertex layout (i.e. including selection colors)
+            uint64_t meshBytes = 0;
+            uint64_t vertices = 0;
+            uint64_t vertexBytes = 0;
+            uint64_t fullVertexBytes = 0;
+        };
+        // per scene layer, including styling of its features
+        std::map<std::string, Entry> layers;
+        // per style: addFeature() and mesh build
+        std::map<std::string, Entry> styles;
+        // if set, returns total allocation count and bytes of calling thread
+        void (*allocCounter)(uint64_t& _allocs, uint64_t& _bytes) = nullptr;
+    };
+
     explicit TileBuilder(const Scene& _scene);
 
     StyleBuilder* getStyleBuilder(const std::string& _name);
@@ -32,8 +58,13 @@ public:
 
     void init();
 
+    // Collect stats of subsequent builds into _stats (not owned; nullptr to disable)
+    void setStats(BuildStats* _stats) { m_stats = _stats; }
+
 private:
 
+    struct StatsScope;
+
     // Determine and apply DrawRules for a @_feature
     void applyStyling(const Feature& _feature, const SceneLayer& _layer);
 
@@ -48,6 +79,13 @@ private:
     fastmap<std::string, std::unique_ptr<StyleBuilder>> m_styleBuilder;
 
     fastmap<uint32_t, std::shared_ptr<Properties>> m_selectionFeatures;
+
+    // only created with SceneOptions::cpuFeaturePicking
+    std::unique_ptr<FeatureIndex> m_featureIndex;
+    float m_tileUnitsPerMeter = 0;
+    float m_pickZoom = 0;
+
+    BuildStats* m_stats = nullptr;
 };
 
 }
@@ -0,0 +1,171 @@
+#include "tile/tileDataCache.h"
+
+#include "data/tileData.h"
+#include "util/hash.h"
+
+namespace Tangram {
+
+uint64_t TileDataCache::dataHash(const std::vector<char>& _rawData) {
+    return hash_fnv1a(_rawData.data(), _rawData.size());
+}
+
+size_t TileDataCache::memoryUsage(const TileData& _tileData) {
+    size_t bytes = sizeof(TileData) + _tileData.layers.capacity() * sizeof(Layer);
+
+    for (auto& layer : _tileData.layers) {
+        bytes += layer.name.capacity() + layer.features.capacity() * sizeof(Feature);
+
+        for (auto& feature : layer.features) {
+            bytes += feature.points.capacity() * sizeof(Point);
+            bytes += feature.lines.capacity() * sizeof(Line);
+            for (auto& line : feature.lines) {
+                bytes += line.capacity() * sizeof(Point);
+            }
+            bytes += feature.polygons.capacity() * sizeof(Polygon);
+            for (auto& polygon : feature.polygons) {
+                bytes += polygon.capacity() * sizeof(Line);
+                for (auto& ring : polygon) {
+                    bytes += ring.capacity() * sizeof(Point);
+                }
+            }
+            auto& items = feature.props.items();
+            bytes += items.capacity() * sizeof(Properties::Item);
+            for (auto& item : items) {
+                bytes += item.key.capacity();
+                if (item.value.is<std::string>()) {
+                    bytes += item.value.get<std::string>().capacity();
+                }
+            }
+        }
+    }
+    return bytes;
+}
+
+std::shared_ptr<TileData> TileDataCache::get(int32_t _sourceId, const TileID& _tileId, uint64_t _dataHash) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_cacheMap.find(TileCacheKey(_sourceId, _tileId));
+    if (it == m_cacheMap.end() || it->second->dataHash != _dataHash) {
+        m_misses++;
+        return nullptr;
+    }
+    // move to front
+    m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
+    m_hits++;
+    return it->second->tileData;
+}
+
+std::shared_ptr<TileData> TileDataCache::getLatest(int32_t _sourceId, const TileID& _tileId, int64_t _generation) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_cacheMap.find(TileCacheKey(_sourceId, _tileId));
+    if (it == m_cacheMap.end() || it->second->generation != _generation) { return nullptr; }
+
+    m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
+    m_latestHits++;
+    return it->second->tileData;
+}
+
+std::shared_ptr<TileData> TileDataCache::getOrParse(int32_t _sourceId, const TileID& _tileId, uint64_t _dataHash,
+                                                    int64_t _generation, const Parser& _parse) {
+    TileCacheKey key(_sourceId, _tileId);
+    std::shared_future<std::shared_ptr<TileData>> pending;
+    std::promise<std::shared_ptr<TileData>> promise;
+    bool parsing = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_cacheMap.find(key);
+        if (it != m_cacheMap.end() && it->second->dataHash == _dataHash) {
+            m_cacheList.splice(m_cacheList.begin(), m_cacheList, it->second);
+            m_hits++;
+            return it->second->tileData;
+        }
+        m_misses++;
+
+        auto pit = m_pending.find(key);
+        if (pit == m_pending.end()) {
+            m_pending.emplace(key, Pending{_dataHash, promise.get_future().share()});
+            parsing = true;
+        } else if (pit->second.dataHash == _dataHash) {
+            pending = pit->second.result;
+            m_waits++;
+        }
+    }
+    // another thread is parsing this data
+    if (pending.valid()) { return pending.get(); }
+
+    auto tileData = _parse();
+    if (tileData) { put(_sourceId, _tileId, _dataHash, tileData, _generation); }
+
+    if (parsing) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending.erase(key);
+        }
+        promise.set_value(tileData);
+    }
+    return tileData;
+}
+
+void TileDataCache::put(int32_t _sourceId, const TileID& _tileId, uint64_t _dataHash,
+                        std::shared_ptr<TileData> _tileData, int64_t _generation) {
+
+    size_t bytes = memoryUsage(*_tileData);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (bytes > m_maxBytes) { return; }
+
+    TileCacheKey key(_sourceId, _tileId);
+    auto it = m_cacheMap.find(key);
+    if (it != m_cacheMap.end()) {
+        m_bytes -= it->second->bytes;
+        m_cacheList.erase(it->second);
+        m_cacheMap.erase(it);
+    }
+
+    m_cacheList.push_front({key, _dataHash, _generation, bytes, std::move(_tileData)});
+    m_cacheMap[key] = m_cacheList.begin();
+    m_bytes += bytes;
+
+    limitSize();
+}
+
+void TileDataCache::setMaxBytes(size_t _maxBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_maxBytes = _maxBytes;
+    limitSize();
+}
+
+void TileDataCache::limitSize() {
+    while (m_bytes > m_maxBytes && !m_cacheList.empty()) {
+        auto& entry = m_cacheList.back();
+        m_bytes -= entry.bytes;
+        m_cacheMap.erase(entry.key);
+        m_cacheList.pop_back();
+        m_evictions++;
+    }
+}
+
+void TileDataCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_cacheMap.clear();
+    m_cacheList.clear();
+    m_bytes = 0;
+}
+
+TileDataCache::Stats TileDataCache::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats stats;
+    stats.entries = m_cacheList.size();
+    stats.bytes = m_bytes;
+    stats.maxBytes = m_maxBytes;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.evictions = m_evictions;
+    stats.latestHits = m_latestHits;
+    stats.waits = m_waits;
+    return stats;
+}
+
+}
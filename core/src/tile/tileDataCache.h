@@ -0,0 +1,101 @@
+#pragma once
+
+#include "tile/tileCache.h"
+#include "tile/tileID.h"
+
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Tangram {
+
+struct TileData;
+
+/* Bounded LRU cache of parsed TileData
+ *
+ * Lets tiles rebuilt from unchanged source data (scene updates, pixel scale change, etc.) skip parsing.
+ * Entries are keyed by source and TileID and are only returned for raw data with the same hash as the
+ * data they were parsed from, or, for overzoomed tiles which would load the same data, parsed in the same
+ * source generation. Concurrent parsing of the same data is done once. Shared by TileWorker threads.
+ */
+class TileDataCache {
+public:
+
+    struct Stats {
+        size_t entries = 0;
+        size_t bytes = 0;
+        size_t maxBytes = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t evictions = 0;
+        // hits from getLatest()
+        uint64_t latestHits = 0;
+        // parses shared with another thread
+        uint64_t waits = 0;
+    };
+
+    using Parser = std::function<std::shared_ptr<TileData>()>;
+
+    explicit TileDataCache(size_t _maxBytes) : m_maxBytes(_maxBytes) {}
+
+    static uint64_t dataHash(const std::vector<char>& _rawData);
+
+    // estimated heap memory of parsed tile
+    static size_t memoryUsage(const TileData& _tileData);
+
+    std::shared_ptr<TileData> get(int32_t _sourceId, const TileID& _tileId, uint64_t _dataHash);
+
+    void put(int32_t _sourceId, const TileID& _tileId, uint64_t _dataHash, std::shared_ptr<TileData> _tileData,
+             int64_t _generation = 0);
+
+    // data for tile parsed in source generation _generation from any raw data, without touching miss stats
+    std::shared_ptr<TileData> getLatest(int32_t _sourceId, const TileID& _tileId, int64_t _generation);
+
+    // cached data for tile, calling _parse if not cached and not being parsed from same data by another thread
+    std::shared_ptr<TileData> getOrParse(int32_t _sourceId, const TileID& _tileId, uint64_t _dataHash,
+                                         int64_t _generation, const Parser& _parse);
+
+    void setMaxBytes(size_t _maxBytes);
+
+    void clear();
+
+    Stats stats() const;
+
+private:
+    struct CacheEntry {
+        TileCacheKey key;
+        uint64_t dataHash;
+        int64_t generation;
+        size_t bytes;
+        std::shared_ptr<TileData> tileData;
+    };
+
+    struct Pending {
+        uint64_t dataHash;
+        std::shared_future<std::shared_ptr<TileData>> result;
+    };
+
+    using CacheList = std::list<CacheEntry>;
+
+    void limitSize();
+
+    CacheList m_cacheList;
+    std::unordered_map<TileCacheKey, CacheList::iterator> m_cacheMap;
+    std::unordered_map<TileCacheKey, Pending> m_pending;
+
+    size_t m_bytes = 0;
+    size_t m_maxBytes;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evictions = 0;
+    uint64_t m_latestHits = 0;
+    uint64_t m_waits = 0;
+
+    mutable std::mutex m_mutex;
+};
+
+}
@@ -2,10 +2,12 @@
 
 #include "data/tileSource.h"
 #include "data/rasterSource.h"
+#include "gl/uploadScheduler.h"
 #include "map.h"
 #include "platform.h"
 #include "tile/tile.h"
 #include "tile/tileCache.h"
+#include "tile/tileDataCache.h"
 #include "util/mapProjection.h"
 #include "view/view.h"
 
@@ -187,6 +189,9 @@ void TileManager::clearTileSets(bool clearSourceCaches) {
             tileSet.source->clearData();
         }
     }
+    if (clearSourceCaches && m_tileDataCache) {
+        m_tileDataCache->clear();
+    }
 
     m_tileCache->clear();
 }
@@ -202,11 +207,24 @@ void TileManager::clearTileSet(int32_t _sourceId) {
     m_tileSetChanged = true;
 }
 
-bool TileManager::updateTileSets(const View& _view) {
+void TileManager::rebuildTileSets(const std::set<std::string>& _sourceNames) {
+    for (auto& tileSet : m_tileSets) {
+        if (!_sourceNames.count(tileSet.source->name())) { continue; }
+        // tiles of older generation are reloaded by updateTileSet() and not taken from cache
+        tileSet.source->invalidateTiles();
+        m_tileSetChanged = true;
+    }
+}
+
+bool TileManager::updateTileSets(const View& _view, UploadScheduler* _uploads) {
 
     m_tiles.clear();
     m_tilesInProgress = 0;
-    m_tileSetChanged = false;
+    m_culledTiles = 0;
+    // tiles pending upload last frame may have been uploaded since
+    m_tileSetChanged = !m_pendingUploads.empty();
+    m_pendingUploads.clear();
+    m_scheduleUploads = _uploads && _uploads->enabled();
 
     if (!getDebugFlag(DebugFlags::freeze_tiles)) {
 
@@ -218,7 +236,7 @@ bool TileManager::updateTileSets(const View& _view) {
         auto getVisibleTiles = [&](auto&& self, TileID tileId, TileSetMask active){
             // if pitch == 0, this will only return 0 or FLT_MAX
             float area = _view.getTileScreenArea(tileId);
-            if (area <= 0) { return; }  // offscreen
+            if (area <= 0) { m_culledTiles++; return; }  // offscreen
 
             TileSetMask nextActive = active;
             for (size_t ii = 0; ii < m_tileSets.size(); ++ii) {
@@ -279,6 +297,13 @@ bool TileManager::updateTileSets(const View& _view) {
 
     loadTiles();
 
+    if (_uploads) {
+        _uploads->clearQueue();
+        for (auto& tile : m_pendingUploads) {
+            _uploads->enqueue(tile, _view.getTileScreenArea(tile->getID()));
+        }
+    }
+
     // no longer need to sort or dedup m_tiles since it is populated in order from TileSet.tiles (std::map)
 
     // grow tile cache if needed - goal is to cache about 1 screen worth of tiles
@@ -397,6 +422,11 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
         }
     }
 
+    // with scheduled uploads, tile is not drawn (and so needs a proxy) until it is on the GPU
+    auto hasTile = [this](const TileEntry& entry) {
+        return entry.tile && (!m_scheduleUploads || entry.tile->isUploaded());
+    };
+
     int minCurS = tiles.rbegin()->first.s; //, maxCurS = tiles.begin()->first.s;
     auto zoomBias = _tileSet.source->zoomBias();
     // find proxy tiles
@@ -409,17 +439,17 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
                 auto it = tiles.find(id);
                 if (it == tiles.end()) { continue; }
                 // visible tile w/ tile (so no proxy needed) or a better proxy found before visible tile?
-                if (it->second.tile) { break; }
+                if (hasTile(it->second)) { break; }
                 // found visible tile (w/o tile) to proxy for?
                 if (it->second.isVisible()) { entry.m_proxyCounter++; break; }
             }
-        } else if (!entry.tile) {
+        } else if (!hasTile(entry)) {
             // visible tile w/o tile - look for parents which can be proxy
             for (auto id = tileId.getParent(zoomBias); id.s >= minCurS; id = id.getParent(zoomBias)) {
                 auto it = tiles.find(id);
                 if (it != tiles.end()) {
                     it->second.m_proxyCounter++;
-                    if (it->second.tile) { break; }
+                    if (hasTile(it->second)) { break; }
                 }
             }
         }
@@ -446,7 +476,11 @@ void TileManager::updateTileSet(TileSet& _tileSet, const ViewState& _view) {
 
         bool canLoad = entry.isInProgress() && (tileId.z < maxProxyZ && tileId.z > minProxyZ);
         if (entry.isVisible() || (entry.m_proxyCounter > 0 && (entry.tile || canLoad))) {
-            if (entry.tile) {
+            if (entry.tile && !hasTile(entry)) {
+                // built but not yet on GPU - proxies are drawn until UploadScheduler uploads it
+                m_pendingUploads.push_back(entry.tile);
+                if (entry.isVisible()) { m_tilesInProgress++; }
+            } else if (entry.tile) {
                 entry.tile->setProxyDepth(entry.m_proxyCounter > 0 ? std::max(maxVisS - tileId.s, 1) : 0);
                 m_tiles.push_back(entry.tile);
                 // check to see if a replacement is now available for missing raster
@@ -555,6 +589,7 @@ void TileManager::loadTiles() {
         ++tileTask->shareCount;
 
         tileTask->setScenePrana(m_scenePrana);
+        if (m_tileDataCache) { tileTask->setDataCache(m_tileDataCache); }
         tileSet->source->loadTileData(tileTask, m_dataCallback);
 
         LOGTO("Load Tile: %s %s", tileSet->source->name().c_str(), loadTask.tileID.toString().c_str());
@@ -619,6 +654,16 @@ void TileManager::setCacheSize(size_t _cacheSize) {
     }
 }
 
+void TileManager::setTileDataCacheSize(size_t _cacheSize) {
+    if (_cacheSize == 0) {
+        m_tileDataCache.reset();
+    } else if (m_tileDataCache) {
+        m_tileDataCache->setMaxBytes(_cacheSize);
+    } else {
+        m_tileDataCache = std::make_shared<TileDataCache>(_cacheSize);
+    }
+}
+
 int TileManager::numTotalTiles() const {
     int tot = 0;
     for (const auto& tileSet : m_tileSets) { tot += tileSet.visibleTiles.size(); }
@@ -19,6 +19,8 @@ namespace Tangram {
 class Platform;
 class TileSource;
 class TileCache;
+class TileDataCache;
+class UploadScheduler;
 class View;
 struct ViewState;
 
@@ -40,17 +42,24 @@ public:
     /* Sets the tile TileSources */
     void setTileSources(const std::vector<std::shared_ptr<TileSource>>& _sources);
 
-    /* Updates visible tile set and load missing tiles */
-    bool updateTileSets(const View& _view);
+    /* Updates visible tile set and load missing tiles; if _uploads is enabled, tiles are only made
+     * visible once their meshes have been uploaded and the others are queued for upload */
+    bool updateTileSets(const View& _view, UploadScheduler* _uploads = nullptr);
 
     void clearTileSets(bool clearSourceCaches = false);
 
     void clearTileSet(int32_t _sourceId);
 
+    /* Rebuild tiles of the named sources from (cached) source data; current tiles are drawn until
+     * their replacements are ready */
+    void rebuildTileSets(const std::set<std::string>& _sourceNames);
+
     /* Returns the set of currently visible tiles */
     const auto& getVisibleTiles() const { return m_tiles; }
 
     int numLoadingTiles() const { return m_tilesInProgress; }
+    // tiles rejected as offscreen in last update
+    int numCulledTiles() const { return m_culledTiles; }
     int numTotalTiles() const;
 
     std::shared_ptr<TileSource> getTileSource(int32_t _sourceId);
@@ -66,6 +75,13 @@ public:
      */
     void setCacheSize(size_t _cacheSize);
 
+    /* @_cacheSize: Set size of in-memory cache of parsed TileData in bytes, used when tiles are rebuilt
+     * from unchanged source data; 0 disables the cache.
+     */
+    void setTileDataCacheSize(size_t _cacheSize);
+
+    const std::shared_ptr<TileDataCache>& getTileDataCache() const { return m_tileDataCache; }
+
 protected:
 
     enum class ProxyID : uint8_t;
@@ -104,6 +120,7 @@ protected:
     TileSet* findTileSet(int64_t sourceId);
 
     int32_t m_tilesInProgress = 0;
+    int32_t m_culledTiles = 0;
 
     std::vector<TileSet> m_tileSets;
     std::vector<TileSet> m_auxTileSets;
@@ -111,7 +128,12 @@ protected:
     /* Current tiles ready for rendering */
     std::vector<std::shared_ptr<Tile>> m_tiles;
 
+    /* Tiles ready except for GPU upload (only used with UploadScheduler) */
+    std::vector<std::shared_ptr<Tile>> m_pendingUploads;
+    bool m_scheduleUploads = false;
+
     std::unique_ptr<TileCache> m_tileCache;
+    std::shared_ptr<TileDataCache> m_tileDataCache;
     size_t m_maxCacheLimit = DEFAULT_CACHE_SIZE;
 
     TileTaskQueue& m_workers;
@@ -1,9 +1,11 @@
 #include "tile/tileTask.h"
 
 #include "data/tileSource.h"
+#include "debug/trace.h"
 #include "scene/scene.h"
 #include "tile/tile.h"
 #include "tile/tileBuilder.h"
+#include "tile/tileDataCache.h"
 #include "util/mapProjection.h"
 
 namespace Tangram {
@@ -32,9 +34,14 @@ void TileTask::setTile(std::unique_ptr<Tile>&& _tile) {
 
 void TileTask::process(TileBuilder& _tileBuilder) {
 
-    auto tileData = m_source->parse(*this);
+    std::shared_ptr<TileData> tileData;
+    {
+        TRACE_SCOPE_TILE("parse", m_tileId);
+        tileData = parseTileData();
+    }
 
     if (tileData) {
+        TRACE_SCOPE_TILE("build", m_tileId);
         m_tile = std::make_unique<Tile>(m_tileId, m_source->id(), m_source->generation());
         _tileBuilder.build(*m_tile, *tileData, *m_source);
         m_ready = true;
@@ -43,6 +50,30 @@ void TileTask::process(TileBuilder& _tileBuilder) {
     }
 }
 
+std::shared_ptr<TileData> TileTask::parseTileData() {
+    return m_source->parse(*this);
+}
+
+// parsing only depends on x,y,z, so all styling zooms of a data tile share one entry
+static TileID dataTileId(const TileID& _tileId) { return TileID(_tileId.x, _tileId.y, _tileId.z); }
+
+bool BinaryTileTask::loadFromDataCache() {
+    if (!m_dataCache) { return false; }
+    tileData = m_dataCache->getLatest(m_sourceId, dataTileId(m_tileId), m_sourceGeneration);
+    if (!tileData) { return false; }
+    startedLoading();
+    return true;
+}
+
+std::shared_ptr<TileData> BinaryTileTask::parseTileData() {
+    if (tileData) { return tileData; }
+    if (!m_dataCache || !hasData()) { return m_source->parse(*this); }
+
+    uint64_t hash = TileDataCache::dataHash(*rawTileData);
+    return m_dataCache->getOrParse(m_sourceId, dataTileId(m_tileId), hash, m_sourceGeneration,
+                                   [this]() { return m_source->parse(*this); });
+}
+
 void TileTask::complete() {
 
     for (auto& subTask : m_subTasks) {
@@ -1,6 +1,7 @@
 #include "tile/tileWorker.h"
 
 #include "data/tileSource.h"
+#include "debug/trace.h"
 #include "log.h"
 #include "map.h"
 #include "platform.h"
@@ -34,6 +35,7 @@ TileWorker::~TileWorker(){
 void TileWorker::run(Worker* instance) {
 
     setCurrentThreadPriority(WORKER_NICENESS);
+    Trace::setThreadName("TileWorker");
 
     std::unique_ptr<TileBuilder> builder;
 
@@ -6,8 +6,9 @@
 #include <thread>
 #include <functional>
 #include <atomic>
-#ifdef DEBUG
 #include <string>
+#include "debug/trace.h"
+#ifdef DEBUG
 #include <cassert>
 #endif
 
@@ -15,15 +16,13 @@ namespace Tangram {
 
 class AsyncWorker {
 public:
-#ifdef DEBUG
-        std::string m_tag;
-#endif
+    std::string m_tag;
 
     AsyncWorker(const char* _tag) {
 #ifdef DEBUG
         assert(_tag && _tag[0] && "AsyncWorker requires identifying tag!");
-        m_tag = _tag;
 #endif
+        m_tag = _tag;
         thread = std::thread(&AsyncWorker::run, this);
     }
 
@@ -52,6 +51,7 @@ public:
 private:
 
     void run() {
+        Trace::setThreadName(m_tag.c_str());
         while (true) {
             std::function<void()> task;
             {
@@ -69,6 +69,7 @@ private:
                 task = std::move(m_queue.front());
                 m_queue.pop_front();
             }
+            TRACE_SCOPE("AsyncWorker task");
             task();
         }
     }
@@ -2,8 +2,10 @@
 
 #include "scene/scene.h"
 #include "util/asyncWorker.h"
+#include "util/elevationPyramid.h"
 #include "data/rasterSource.h"
 #include "style/rasterStyle.h"
+#include "tile/tile.h"
 #include "gl/framebuffer.h"
 #include "gl/renderState.h"
 #include "gl/shaderProgram.h"
@@ -11,6 +13,7 @@
 #include "marker/marker.h"
 #include "log.h"
 #include "debug/frameInfo.h"
+#include "debug/trace.h"
 
 #include "../../platforms/common/platform_gl.h"
 
@@ -32,8 +35,8 @@ void main(void) {
 
 namespace Tangram {
 
-// smaller target greatly improves FPS
-static float bufferScale = 2;
+// grid resolution per tile for CPU depth; GPU mesh uses 64, but depth buffer is lower resolution than screen
+static constexpr int cpuDepthGridRes = 32;
 std::unique_ptr<RenderState> ElevationManager::m_renderState;
 std::unique_ptr<AsyncWorker> ElevationManager::offscreenWorker;
 
@@ -116,6 +119,128 @@ double ElevationManager::elevationLerp(const Texture& tex, TileID tileId, Projec
   return elevationLerp(tex, glm::vec2(ox, oy));
 }
 
+void ElevationManager::elevationLerp(const Texture& tex, const glm::vec2* pos, size_t count, float* elevOut,
+                                     glm::vec2* gradOut)
+{
+  // structure of arrays blocks: coordinates and interpolation are vectorized, only texel fetch is scalar
+  constexpr size_t B = 16;
+  const int w = tex.width(), h = tex.height();
+  const bool isFloat = tex.getOptions().pixelFormat == PixelFormat::FLOAT;
+  const float* fdata = (const float*)tex.bufferData();
+  const GLubyte* bdata = tex.bufferData();
+  int i00[B], i01[B], i10[B], i11[B];
+  float fx[B], fy[B], t00[B], t01[B], t10[B], t11[B];
+
+  for(size_t base = 0; base < count; base += B) {
+    size_t n = std::min(B, count - base);
+    const glm::vec2* p = pos + base;
+    // same clamping as scalar elevationLerp() for positions within tile; floor and ceil via truncation of
+    //  positive values to avoid library calls which prevent vectorization
+    for(size_t ii = 0; ii < n; ++ii) {
+      float x0 = std::min(std::max(p[ii].x*w - 0.5f, -0.5f), w - 0.5f);
+      float y0 = std::min(std::max(p[ii].y*h - 0.5f, -0.5f), h - 0.5f);
+      int xf = int(x0 + 1) - 1, yf = int(y0 + 1) - 1;
+      int ix0 = std::max(0, xf), iy0 = std::max(0, yf);
+      int ix1 = std::min(xf + (x0 > xf), w-1), iy1 = std::min(yf + (y0 > yf), h-1);
+      fx[ii] = x0 - ix0;
+      fy[ii] = y0 - iy0;
+      i00[ii] = iy0*w + ix0;
+      i01[ii] = iy1*w + ix0;
+      i10[ii] = iy0*w + ix1;
+      i11[ii] = iy1*w + ix1;
+    }
+    if(isFloat) {
+      for(size_t ii = 0; ii < n; ++ii) {
+        t00[ii] = fdata[i00[ii]]; t01[ii] = fdata[i01[ii]]; t10[ii] = fdata[i10[ii]]; t11[ii] = fdata[i11[ii]];
+      }
+    } else {
+      auto decode = [&](int idx) {
+        const GLubyte* q = bdata + size_t(idx)*4;
+        return (q[0]*256.0f + q[1] + q[2]/256.0f) - 32768.0f;
+      };
+      for(size_t ii = 0; ii < n; ++ii) {
+        t00[ii] = decode(i00[ii]); t01[ii] = decode(i01[ii]); t10[ii] = decode(i10[ii]); t11[ii] = decode(i11[ii]);
+      }
+    }
+    float* out = elevOut + base;
+    for(size_t ii = 0; ii < n; ++ii) {
+      float e0 = t00[ii] + fx[ii]*(t10[ii] - t00[ii]);
+      float e1 = t01[ii] + fx[ii]*(t11[ii] - t01[ii]);
+      out[ii] = e0 + fy[ii]*(e1 - e0);
+    }
+    if(gradOut) {
+      glm::vec2* grad = gradOut + base;
+      for(size_t ii = 0; ii < n; ++ii) {
+        float dx0 = t10[ii] - t00[ii], dx1 = t11[ii] - t01[ii];
+        float dy0 = t01[ii] - t00[ii], dy1 = t11[ii] - t10[ii];
+        grad[ii] = glm::vec2((dx0 + fy[ii]*(dx1 - dx0))*w, (dy0 + fx[ii]*(dy1 - dy0))*h);
+      }
+    }
+  }
+}
+
+size_t ElevationManager::getElevations(const ProjectedMeters* _pos, size_t _count, float* _elevOut,
+                                       glm::vec2* _gradOut, bool* _okOut)
+{
+  return getElevations(*m_elevationSource->m_textures, m_elevationSource->maxZoom(), _pos, _count,
+                       _elevOut, _gradOut, _okOut);
+}
+
+size_t ElevationManager::getElevations(RasterCache& _dems, int _maxZoom, const ProjectedMeters* _pos,
+                                       size_t _count, float* _elevOut, glm::vec2* _gradOut, bool* _okOut)
+{
+  // sort points by tile at source max zoom; each such tile is covered by a single DEM texture, the finest
+  //  one containing it (a coarser DEM found for one such tile can't be reused for the next since a finer
+  //  one may be loaded for it)
+  std::vector<std::pair<TileID, uint32_t>> order;
+  order.reserve(_count);
+  for(size_t ii = 0; ii < _count; ++ii) {
+    order.emplace_back(MapProjection::projectedMetersTile(_pos[ii], _maxZoom), uint32_t(ii));
+  }
+  std::sort(order.begin(), order.end(), [](auto& a, auto& b){
+    return a.first.y != b.first.y ? a.first.y < b.first.y : a.first.x < b.first.x; });
+
+  std::vector<glm::vec2> texPos;
+  std::vector<float> elev;
+  std::vector<glm::vec2> grad;
+  size_t found = 0;
+  for(size_t start = 0, end = 0; start < _count; start = end) {
+    TileID tileId = order[start].first;
+    for(end = start + 1; end < _count && order[end].first == tileId; ++end) {}
+
+    TileID demId = NOT_A_TILE;
+    auto dem = _dems.find(_pos[order[start].second], demId);
+    if(!dem || !dem->bufferData()) {
+      for(size_t ii = start; ii < end; ++ii) {
+        uint32_t idx = order[ii].second;
+        _elevOut[idx] = 0;
+        if(_gradOut) { _gradOut[idx] = glm::vec2(0); }
+        if(_okOut) { _okOut[idx] = false; }
+      }
+      continue;
+    }
+
+    double scale = MapProjection::metersPerTileAtZoom(demId.z);
+    ProjectedMeters origin = MapProjection::tileSouthWestCorner(demId);
+    size_t n = end - start;
+    texPos.resize(n);
+    elev.resize(n);
+    if(_gradOut) { grad.resize(n); }
+    for(size_t ii = 0; ii < n; ++ii) {
+      texPos[ii] = glm::vec2((_pos[order[start + ii].second] - origin)/scale);
+    }
+    elevationLerp(*dem, texPos.data(), n, elev.data(), _gradOut ? grad.data() : nullptr);
+    for(size_t ii = 0; ii < n; ++ii) {
+      uint32_t idx = order[start + ii].second;
+      _elevOut[idx] = elev[ii];
+      if(_gradOut) { _gradOut[idx] = grad[ii]/float(scale); }
+      if(_okOut) { _okOut[idx] = true; }
+    }
+    found += n;
+  }
+  return found;
+}
+
 double ElevationManager::getElevation(ProjectedMeters pos, bool& ok)
 {
   static std::weak_ptr<Texture> prevTex;
@@ -149,43 +274,32 @@ bool ElevationManager::hasTile(TileID tileId)
   return ok;
 }
 
-glm::vec2 ElevationManager::getMinMaxElev(TileID tileId, int ancestors)
+std::shared_ptr<Texture> ElevationManager::findTexture(TileID tileId, TileID& srcIdOut, int ancestors)
 {
-  struct ElevTexInfo {
-    float min, max;
-  };
-
-  while(tileId.z > m_elevationSource->zoomOptions().maxZoom) { tileId = tileId.getParent(); }
-  auto tex = m_elevationSource->getTexture(tileId);
-  while(!tex && (tileId.z > 14 || (ancestors-- > 0 && tileId.z > 1))) {
-    tileId = tileId.getParent();
-    tex = m_elevationSource->getTexture(tileId);
+  // called for every tile every frame, so don't touch raster cache LRU order
+  TileID srcId = tileId;
+  while(srcId.z > m_elevationSource->zoomOptions().maxZoom) { srcId = srcId.getParent(); }
+  auto tex = m_elevationSource->peekTexture(srcId);
+  while(!tex && (srcId.z > 14 || (ancestors-- > 0 && srcId.z > 1))) {
+    srcId = srcId.getParent();
+    tex = m_elevationSource->peekTexture(srcId);
   }
-  if(!tex) { return {0, 9000}; }
-
-  if(!tex->userData) {
-    ElevTexInfo info = {FLT_MAX, -FLT_MAX};
-    size_t npix = tex->width()*tex->height();
-    if(tex->getOptions().pixelFormat == PixelFormat::FLOAT) {
-      float* texbuff = (float*)tex->bufferData();
-      for(size_t ii = 0; ii < npix; ++ii) {
-        info.min = std::min(texbuff[ii], info.min);
-        info.max = std::max(texbuff[ii], info.max);
-      }
-    }
-    else {
-      uint8_t* texbuff = tex->bufferData();
-      for(size_t ii = 0; ii < npix; ++ii) {
-        uint8_t* p = &texbuff[ii*4];
-        float elev = (p[0]*256 + p[1] + p[2]/256.0f) - 32768;
-        info.min = std::min(elev, info.min);
-        info.max = std::max(elev, info.max);
-      }
-    }
-    tex->userData = std::make_shared<ElevTexInfo>(info);
+  srcIdOut = srcId;
+  return tex;
+}
+
+bool ElevationManager::getMinMaxElev(TileID tileId, glm::vec2& minMaxOut, int ancestors)
+{
+  TileID srcId = tileId;
+  auto tex = findTexture(tileId, srcId, ancestors);
+  // pyramid is built when texture is decoded (if CPU data is kept), so it is counted in raster cache size
+  if(!tex || !tex->userData) {
+    minMaxOut = {0, 9000};
+    return false;
   }
-  auto* info = static_cast<ElevTexInfo*>(tex->userData.get());
-  return {info->min, info->max};
+  auto* pyramid = static_cast<ElevationPyramid*>(tex->userData.get());
+  minMaxOut = pyramid->minMax(srcId, tileId);
+  return true;
 }
 
 void ElevationManager::renderTerrainDepth(RenderState& _rs, const View& _view,
@@ -193,12 +307,18 @@ void ElevationManager::renderTerrainDepth(RenderState& _rs, const View& _view,
 {
   static std::atomic_bool isRunning{false};
   FrameInfo::scope _trace("renderTerrainDepth");
+  TRACE_SCOPE("renderTerrainDepth");
+
+  if(m_cpuDepth) {
+    renderTerrainDepthCpu(_view, _tiles);
+    return;
+  }
 
   //offscreenWorker.reset();
   if(!offscreenWorker) {
     LOGE("Offscreen worker has not been created!");
 
-    int w = _view.getWidth()/bufferScale, h = _view.getHeight()/bufferScale;
+    int w = _view.getWidth()/m_bufferScale, h = _view.getHeight()/m_bufferScale;
     if (!m_frameBuffer || m_frameBuffer->getWidth() != w || m_frameBuffer->getHeight() != h) {
       m_frameBuffer = std::make_unique<FrameBuffer>(w, h, false, GL_R32UI);
       //_rs.m_terrainDepthTexture = m_frameBuffer->getTextureHandle();
@@ -241,7 +361,7 @@ void ElevationManager::renderTerrainDepth(RenderState& _rs, const View& _view,
 
     isRunning = true;
     m_renderState->flushResourceDeletion();
-    int w = _view.getWidth()/bufferScale, h = _view.getHeight()/bufferScale;
+    int w = _view.getWidth()/m_bufferScale, h = _view.getHeight()/m_bufferScale;
     if (!m_frameBuffer || m_frameBuffer->getWidth() != w || m_frameBuffer->getHeight() != h)
       m_frameBuffer = std::make_unique<FrameBuffer>(w, h, false, GL_R32UI);
     m_frameBuffer->applyAsRenderTarget(*m_renderState);  // this does the glClear()
@@ -272,11 +392,81 @@ void ElevationManager::renderTerrainDepth(RenderState& _rs, const View& _view,
   drawCond.wait(mainLock, [&]{ return drawFinished; });
 }
 
+void ElevationManager::renderTerrainDepthCpu(const View& _view,
+                                             const std::vector<std::shared_ptr<Tile>>& _tiles)
+{
+  // as with GPU path, depth lags by one frame: results of previous job are swapped in and next job queued
+  if(m_cpuDepthRunning) { return; }
+  if(m_cpuDepthReady) {
+    std::swap(m_depthData[0], m_depthData[1]);
+    m_cpuDepthReady = false;
+  }
+  if(!m_cpuDepthWorker) {
+    m_cpuDepthWorker = std::make_unique<AsyncWorker>("TerrainDepthWorker");
+  }
+
+  auto& d = m_depthData[1];
+  d.w = _view.getWidth()/m_bufferScale;
+  d.h = _view.getHeight()/m_bufferScale;
+  d.zoom = _view.getBaseZoom();
+  d.viewPos = _view.getPosition();
+  d.viewProj = _view.getViewProjectionMatrix();
+
+  // textures from last job are released here on main thread
+  m_cpuDepthTiles.clear();
+  glm::mat4 view = _view.getViewMatrix();
+  for(auto& tile : _tiles) {
+    // only tiles drawn with terrain
+    if(!tile->getMesh(*m_style)) { continue; }
+    TileID srcId = tile->getID();
+    auto tex = findTexture(tile->getID(), srcId, 3);
+    if(!tex || !tex->bufferData()) { continue; }
+    // model matrix scales z by tile size, as for label elevation
+    m_cpuDepthTiles.push_back({tex, tile->getID(), srcId, view * tile->getModelMatrix(),
+                               float(m_terrainScale/tile->getScale())});
+  }
+  m_cpuDepthGrids.resize(m_cpuDepthTiles.size());
+
+  m_cpuDepthRunning = true;
+  m_cpuDepthWorker->enqueue([this, proj = _view.getProjectionMatrix()](){
+    TRACE_SCOPE("renderTerrainDepthCpu");
+    int n = cpuDepthGridRes + 1;
+    for(size_t ii = 0; ii < m_cpuDepthTiles.size(); ++ii) {
+      auto& src = m_cpuDepthTiles[ii];
+      auto& grid = m_cpuDepthGrids[ii];
+      // position of tile within DEM tile; tile y increases to south, DEM rows to north
+      int dz = src.tileId.z - src.srcId.z;
+      float scale = 1.0f/float(1 << dz);
+      glm::vec2 offset((src.tileId.x - (src.srcId.x << dz))*scale,
+                       1.0f - (src.tileId.y - (src.srcId.y << dz) + 1)*scale);
+      grid.modelView = src.modelView;
+      grid.resolution = cpuDepthGridRes;
+      grid.heights.resize(n*n);
+      for(int row = 0; row < n; ++row) {
+        for(int col = 0; col < n; ++col) {
+          glm::vec2 pos = offset + glm::vec2(col, row)*(scale/cpuDepthGridRes);
+          grid.heights[row*n + col] = src.heightScale * elevationLerp(*src.dem, pos);
+        }
+      }
+    }
+    auto& d = m_depthData[1];
+    m_rasterizer.rasterize(d.depth, d.w, d.h, proj, m_cpuDepthGrids);
+    m_cpuDepthReady = true;
+    m_cpuDepthRunning = false;
+  });
+}
+
+void ElevationManager::setDepthOptions(bool _cpuDepth, float _resolution)
+{
+  m_cpuDepth = _cpuDepth;
+  if(_resolution > 0) { m_bufferScale = 1/_resolution; }
+}
+
 float ElevationManager::getDepth(glm::vec2 screenpos)
 {
   auto& d = m_depthData[0];
   if(d.depth.empty()) { return 0; }
-  glm::vec2 pos = glm::floor(screenpos/bufferScale);
+  glm::vec2 pos = glm::floor(screenpos/m_bufferScale);
   if(pos.x < 0 || pos.y < 0 || pos.x >= d.w || pos.y >= d.h) { return 0; }
   //return 2*depth[int(pos.x) + int(h - pos.y - 1)*w] - 1;  // convert from 0..1 (glDepthRange) to -1..1 (NDC)
   return m_depthData[0].depth[int(pos.x) + int(d.h - pos.y - 1)*d.w];
@@ -4,9 +4,11 @@
 #include <mutex>
 #include <atomic>
 #include "util/mapProjection.h"
+#include "util/terrainDepthRasterizer.h"
 
 namespace Tangram {
 
+class RasterCache;
 class RasterSource;
 class Style;
 class FrameBuffer;
@@ -30,17 +32,32 @@ public:
   ElevationManager(std::shared_ptr<RasterSource> src, Style& style);
   ~ElevationManager();
   double getElevation(ProjectedMeters pos, bool& ok);
-  glm::vec2 getMinMaxElev(TileID tileId, int ancestors = 0);
+  // elevation at each of _count points, grouped by tile so each DEM is looked up once; where no DEM is
+  //  loaded, elevation is 0 and _okOut (if given) is false. Gradient is per projected meter. Unlike
+  //  getElevation(), can be called from any thread. Returns number of points with elevation.
+  size_t getElevations(const ProjectedMeters* _pos, size_t _count, float* _elevOut,
+                       glm::vec2* _gradOut = nullptr, bool* _okOut = nullptr);
+  // getElevations() from the DEM textures in _dems, for elevation source with max zoom _maxZoom
+  static size_t getElevations(RasterCache& _dems, int _maxZoom, const ProjectedMeters* _pos, size_t _count,
+                              float* _elevOut, glm::vec2* _gradOut = nullptr, bool* _okOut = nullptr);
+  // min, max elevation of tile from its DEM tile or ancestor's; false if none available
+  bool getMinMaxElev(TileID tileId, glm::vec2& minMaxOut, int ancestors = 0);
   float getDepth(glm::vec2 screenpos);
   DepthData& getDepthData() { return m_depthData[0]; }
   bool hasTile(TileID tileId);
   void setMinZoom(int z) { m_minZoom = z; }
+  // rasterize depth on CPU worker instead of GPU; _resolution is depth buffer size relative to viewport
+  void setDepthOptions(bool _cpuDepth, float _resolution);
 
   void renderTerrainDepth(RenderState& _rs, const View& _view,
                           const std::vector<std::shared_ptr<Tile>>& _tiles);
+  void renderTerrainDepthCpu(const View& _view, const std::vector<std::shared_ptr<Tile>>& _tiles);
 
   static double elevationLerp(const Texture& tex, glm::vec2 pos, glm::vec2* gradOut = nullptr);
   static double elevationLerp(const Texture& tex, TileID tileId, ProjectedMeters meters);
+  // batch version of elevationLerp() for normalized positions; processed in blocks so arithmetic vectorizes
+  static void elevationLerp(const Texture& tex, const glm::vec2* pos, size_t count, float* elevOut,
+                            glm::vec2* gradOut = nullptr);
 
   static void shutdown();
 
@@ -52,9 +69,30 @@ public:
   DepthData m_depthData[2];
   int m_minZoom = 0;
   float m_terrainScale = 1.0f;
+  float m_bufferScale = 2;  // smaller target greatly improves FPS
+
+  struct CpuDepthTile {
+    std::shared_ptr<Texture> dem;
+    TileID tileId;
+    TileID srcId;
+    glm::mat4 modelView;
+    float heightScale;
+  };
+  bool m_cpuDepth = false;
+  std::vector<CpuDepthTile> m_cpuDepthTiles;
+  std::vector<TerrainDepthRasterizer::TileGrid> m_cpuDepthGrids;
+  TerrainDepthRasterizer m_rasterizer;
+  std::atomic_bool m_cpuDepthRunning{false};
+  std::atomic_bool m_cpuDepthReady{false};
 
   static std::unique_ptr<RenderState> m_renderState;
   static std::unique_ptr<AsyncWorker> offscreenWorker;
+
+private:
+  std::shared_ptr<Texture> findTexture(TileID tileId, TileID& srcIdOut, int ancestors);
+
+  // declared last so pending depth job finishes before other members are destroyed
+  std::unique_ptr<AsyncWorker> m_cpuDepthWorker;
 };
 
 }
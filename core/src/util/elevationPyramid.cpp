@@ -0,0 +1,169 @@
+#include "util/elevationPyramid.h"
+
+#include "gl/texture.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+
+namespace Tangram {
+
+static std::atomic<uint64_t> s_builds{0};
+static std::atomic<uint64_t> s_buildMicros{0};
+
+ElevationPyramid::ElevationPyramid(const float* _elev, int _width, int _height)
+    : m_width(_width), m_height(_height) {
+
+    buildLevels([&](int y, float*) { return _elev + size_t(y)*_width; });
+}
+
+ElevationPyramid::ElevationPyramid(const uint8_t* _rgba, int _width, int _height)
+    : m_width(_width), m_height(_height) {
+
+    buildLevels([&](int y, float* buffer) {
+        const uint8_t* p = _rgba + size_t(y)*_width*4;
+        for (int x = 0; x < _width; x++) {
+            buffer[x] = (p[4*x]*256.0f + p[4*x+1] + p[4*x+2]/256.0f) - 32768.0f;
+        }
+        return (const float*)buffer;
+    });
+}
+
+std::unique_ptr<ElevationPyramid> ElevationPyramid::build(const Texture& _texture) {
+    if (!_texture.bufferData() || _texture.width() <= 0 || _texture.height() <= 0) { return nullptr; }
+
+    if (_texture.getOptions().pixelFormat == PixelFormat::FLOAT) {
+        return std::make_unique<ElevationPyramid>(
+            reinterpret_cast<const float*>(_texture.bufferData()), _texture.width(), _texture.height());
+    }
+    return std::make_unique<ElevationPyramid>(
+        static_cast<const uint8_t*>(_texture.bufferData()), _texture.width(), _texture.height());
+}
+
+// _readRow(y, buffer) returns pointer to row y of elevation, using buffer if decoding is needed
+template<typename RowFn>
+void ElevationPyramid::buildLevels(RowFn _readRow) {
+    auto t0 = std::chrono::steady_clock::now();
+
+    int w = m_width, h = m_height;
+    Level level0;
+    level0.width = (w + cellSize - 1)/cellSize;
+    level0.height = (h + cellSize - 1)/cellSize;
+    level0.min.resize(level0.width * level0.height);
+    level0.max.resize(level0.width * level0.height);
+
+    // reduce cellSize rows elementwise, then reduce columns of each cell
+    std::vector<float> buffer(w), rowMin(w), rowMax(w);
+    for (int cy = 0; cy < level0.height; cy++) {
+        std::fill(rowMin.begin(), rowMin.end(), FLT_MAX);
+        std::fill(rowMax.begin(), rowMax.end(), -FLT_MAX);
+        for (int y = cy*cellSize; y < std::min((cy + 1)*cellSize, h); y++) {
+            const float* row = _readRow(y, buffer.data());
+            for (int x = 0; x < w; x++) {
+                rowMin[x] = std::min(rowMin[x], row[x]);
+                rowMax[x] = std::max(rowMax[x], row[x]);
+            }
+        }
+        for (int cx = 0; cx < level0.width; cx++) {
+            int x0 = cx*cellSize, x1 = std::min(x0 + cellSize, w);
+            float lo = rowMin[x0], hi = rowMax[x0];
+            for (int x = x0 + 1; x < x1; x++) {
+                lo = std::min(lo, rowMin[x]);
+                hi = std::max(hi, rowMax[x]);
+            }
+            level0.min[cy*level0.width + cx] = lo;
+            level0.max[cy*level0.width + cx] = hi;
+        }
+    }
+    m_levels.push_back(std::move(level0));
+
+    while (m_levels.back().width > 1 || m_levels.back().height > 1) {
+        const Level& prev = m_levels.back();
+        Level next;
+        next.width = (prev.width + 1)/2;
+        next.height = (prev.height + 1)/2;
+        next.min.resize(next.width * next.height);
+        next.max.resize(next.width * next.height);
+        for (int cy = 0; cy < next.height; cy++) {
+            int y0 = 2*cy, y1 = std::min(2*cy + 1, prev.height - 1);
+            for (int cx = 0; cx < next.width; cx++) {
+                int x0 = 2*cx, x1 = std::min(2*cx + 1, prev.width - 1);
+                next.min[cy*next.width + cx] = std::min(
+                    std::min(prev.min[y0*prev.width + x0], prev.min[y0*prev.width + x1]),
+                    std::min(prev.min[y1*prev.width + x0], prev.min[y1*prev.width + x1]));
+                next.max[cy*next.width + cx] = std::max(
+                    std::max(prev.max[y0*prev.width + x0], prev.max[y0*prev.width + x1]),
+                    std::max(prev.max[y1*prev.width + x0], prev.max[y1*prev.width + x1]));
+            }
+        }
+        m_levels.push_back(std::move(next));
+    }
+
+    auto dt = std::chrono::steady_clock::now() - t0;
+    s_builds++;
+    s_buildMicros += std::chrono::duration_cast<std::chrono::microseconds>(dt).count();
+}
+
+glm::vec2 ElevationPyramid::minMax(glm::vec2 _min, glm::vec2 _max) const {
+    // expand by one pixel since elevation is interpolated between pixel centers
+    int px0 = std::max(0, int(std::floor(_min.x*m_width)) - 1);
+    int py0 = std::max(0, int(std::floor(_min.y*m_height)) - 1);
+    int px1 = std::min(m_width, int(std::ceil(_max.x*m_width)) + 1);
+    int py1 = std::min(m_height, int(std::ceil(_max.y*m_height)) + 1);
+    if (px1 <= px0 || py1 <= py0) { return minMax(); }
+
+    // choose finest level where rect touches at most 3x3 cells
+    size_t lvl = 0;
+    auto spansMore = [&](int cell) {
+        return (px1 - 1)/cell - px0/cell > 2 || (py1 - 1)/cell - py0/cell > 2;
+    };
+    while (lvl + 1 < m_levels.size() && spansMore(cellSize << lvl)) { lvl++; }
+
+    const Level& level = m_levels[lvl];
+    int cell = cellSize << lvl;
+    int cx1 = std::min((px1 - 1)/cell, level.width - 1);
+    int cy1 = std::min((py1 - 1)/cell, level.height - 1);
+    glm::vec2 result(FLT_MAX, -FLT_MAX);
+    for (int cy = py0/cell; cy <= cy1; cy++) {
+        for (int cx = px0/cell; cx <= cx1; cx++) {
+            result.x = std::min(result.x, level.min[cy*level.width + cx]);
+            result.y = std::max(result.y, level.max[cy*level.width + cx]);
+        }
+    }
+    return result;
+}
+
+glm::vec2 ElevationPyramid::minMax(TileID _tile, TileID _descendant) const {
+    int dz = _descendant.z - _tile.z;
+    if (dz <= 0) { return minMax(); }
+
+    float scale = 1.0f/float(1 << dz);
+    float x0 = (_descendant.x - (_tile.x << dz))*scale;
+    // tile y increases to south, texture rows to north
+    float y0 = 1.0f - (_descendant.y - (_tile.y << dz) + 1)*scale;
+    return minMax(glm::vec2(x0, y0), glm::vec2(x0 + scale, y0 + scale));
+}
+
+glm::vec2 ElevationPyramid::minMax() const {
+    const Level& top = m_levels.back();
+    return glm::vec2(top.min[0], top.max[0]);
+}
+
+size_t ElevationPyramid::memoryUsage() const {
+    size_t bytes = sizeof(*this);
+    for (auto& level : m_levels) {
+        bytes += (level.min.capacity() + level.max.capacity())*sizeof(float);
+    }
+    return bytes;
+}
+
+ElevationPyramid::Stats ElevationPyramid::stats() {
+    Stats stats;
+    stats.builds = s_builds;
+    stats.buildMicros = s_buildMicros;
+    return stats;
+}
+
+}
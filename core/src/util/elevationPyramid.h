@@ -0,0 +1,65 @@
+#pragma once
+
+#include "tile/tileID.h"
+#include "glm/vec2.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+
+class Texture;
+
+/* Min/max elevation pyramid for a DEM tile
+ *
+ * Level 0 cells hold min and max elevation of cellSize x cellSize pixel blocks, each following level halves
+ * resolution down to a single cell, so bounds of any sub-rectangle or descendant tile can be found by
+ * reading at most 3x3 cells. Built on tile worker when DEM texture is decoded.
+ */
+class ElevationPyramid {
+public:
+
+    static constexpr int cellSize = 4;
+
+    struct Stats {
+        uint64_t builds = 0;
+        uint64_t buildMicros = 0;
+    };
+
+    // 32-bit float elevation
+    ElevationPyramid(const float* _elev, int _width, int _height);
+    // Terrarium RGB(A) encoded elevation: (R * 256 + G + B / 256) - 32768
+    ElevationPyramid(const uint8_t* _rgba, int _width, int _height);
+
+    // nullptr if texture has no CPU data
+    static std::unique_ptr<ElevationPyramid> build(const Texture& _texture);
+
+    // min and max elevation for normalized rect; y is up from south edge like texture rows
+    glm::vec2 minMax(glm::vec2 _min, glm::vec2 _max) const;
+
+    // min and max elevation for _descendant of (or same as) _tile, the tile of this DEM
+    glm::vec2 minMax(TileID _tile, TileID _descendant) const;
+
+    // min and max elevation of whole tile
+    glm::vec2 minMax() const;
+
+    size_t memoryUsage() const;
+
+    static Stats stats();
+
+private:
+
+    struct Level {
+        int width, height;
+        std::vector<float> min, max;
+    };
+
+    template<typename RowFn>
+    void buildLevels(RowFn _readRow);
+
+    int m_width, m_height;
+    std::vector<Level> m_levels;
+};
+
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <functional> // for hash function
 
 // The generic hash_combine used in Boost
@@ -10,3 +12,12 @@ inline void hash_combine(std::size_t & seed, const T & v) {
     seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
+
+// 64-bit FNV-1a; unlike std::hash, stable across runs and platforms, e.g. for keys of persistent caches
+inline uint64_t hash_fnv1a(const void* data, size_t len, uint64_t seed = 0xcbf29ce484222325ull) {
+    auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < len; ++i) {
+        seed = (seed ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return seed;
+}
@@ -6,6 +6,8 @@
 
 namespace Tangram {
 
+// Decode image with rows in OpenGL order (bottom row first) to a buffer of width*height*bpp bytes from
+//  PixelBufferPool, which must be returned with PixelBufferPool::release() (done by Texture)
 uint8_t* loadImage(const uint8_t* data, size_t length, int* width, int* height, GLint* pixelfmt, int channels);
 
 }
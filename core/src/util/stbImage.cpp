@@ -1,5 +1,8 @@
 #include "imageLoader.h"
+#include "gl/pixelBufferPool.h"
 #include "log.h"
+#include <algorithm>
+#include <cstring>
 #include <memory>
 
 #ifndef TANGRAM_NO_WUFFS
@@ -38,22 +41,109 @@
 
 namespace Tangram {
 
-static uint8_t* flipImage(const uint8_t* data, int width, int height, int bpp) {
-    // need to flip image vertically for OpenGL coordinate system
-    // stbi_set_flip_vertically_on_load flips image in place, requiring 3x memcpy per row; we'd also need to
-    //  switch to stbi_set_flip_vertically_on_load_thread to avoid conflict w/ other users of stb_image
-    uint8_t* flipped = reinterpret_cast<uint8_t*>(std::malloc(width*height*bpp));
-    int rowSize = width*bpp;
+// Images are returned in OpenGL row order (bottom row first) in buffers from PixelBufferPool, so decoders
+//  write into the final buffer where possible instead of decoding to a temporary buffer and flipping to a copy
+
+static uint8_t* allocPixels(int width, int height, int bpp) {
+    return PixelBufferPool::shared().acquire(size_t(width)*height*bpp);
+}
+
+static void freePixels(uint8_t* pixels, int width, int height, int bpp) {
+    PixelBufferPool::shared().release(pixels, size_t(width)*height*bpp);
+}
+
+// flip image decoded top-down in place by swapping rows
+static void flipRows(uint8_t* data, int width, int height, int bpp) {
+    size_t rowSize = size_t(width)*bpp;
+    for (int y = 0; y < height/2; ++y) {
+        uint8_t* top = &data[y*rowSize];
+        std::swap_ranges(top, top + rowSize, &data[(height - y - 1)*rowSize]);
+    }
+}
+
+// copy top-down rows of decoder output to pooled buffer in GL order
+static uint8_t* copyFlipped(const uint8_t* data, int width, int height, int bpp) {
+    uint8_t* flipped = allocPixels(width, height, bpp);
+    size_t rowSize = size_t(width)*bpp;
     for (int y = 0; y < height; ++y) {
-        const uint8_t* src = &data[y*rowSize];
-        uint8_t* dst = &flipped[(height - y - 1)*rowSize];
-        std::memcpy(dst, src, rowSize);
+        std::memcpy(&flipped[(height - y - 1)*rowSize], &data[y*rowSize], rowSize);
     }
     return flipped;
 }
 
+// convert single channel integer samples to float, flipping rows; simple loop over restrict pointers so
+//  compiler can vectorize it
+template<typename T>
+static uint8_t* convertFlipped(const uint8_t* data, int width, int height) {
+    uint8_t* pixels = allocPixels(width, height, sizeof(float));
+    for (int y = 0; y < height; ++y) {
+        const T* __restrict src = reinterpret_cast<const T*>(data) + size_t(y)*width;
+        float* __restrict dst = reinterpret_cast<float*>(pixels) + size_t(height - y - 1)*width;
+        for (int x = 0; x < width; ++x) { dst[x] = float(src[x]); }
+    }
+    return pixels;
+}
+
 struct malloc_deleter { void operator()(void* x) { std::free(x); } };
 
+#ifndef TANGRAM_NO_WUFFS
+// Decode PNG, JPEG or WebP to RGBA with WUFFS directly into pooled buffer (instead of the buffer malloc'd by
+//  WUFFS' stb_image API); WUFFS only writes rows top-down, so buffer is flipped in place
+static uint8_t* wuffsLoadRGBA(const uint8_t* data, size_t length, int* width, int* height, bool* handled) {
+    wuffs_base__image_decoder* dec = nullptr;
+    if (length > 8 && memcmp(data, "\x89PNG", 4) == 0) {
+        dec = wuffs_png__decoder__alloc_as__wuffs_base__image_decoder();
+    } else if (length > 4 && data[0] == 0xFF && data[1] == 0xD8) {
+        dec = wuffs_jpeg__decoder__alloc_as__wuffs_base__image_decoder();
+    } else if (length > 12 && memcmp(data, "RIFF", 4) == 0 && memcmp(data + 8, "WEBP", 4) == 0) {
+        dec = wuffs_webp__decoder__alloc_as__wuffs_base__image_decoder();
+    }
+    *handled = bool(dec);
+    if (!dec) { return nullptr; }
+    std::unique_ptr<wuffs_base__image_decoder, malloc_deleter> decoder(dec);
+
+    wuffs_base__io_buffer src = wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(data), length, true);
+    wuffs_base__image_config config = wuffs_base__null_image_config();
+    wuffs_base__status status = wuffs_base__image_decoder__decode_image_config(dec, &config, &src);
+    if (!wuffs_base__status__is_ok(&status)) {
+        LOGE("Error loading image header: %s", wuffs_base__status__message(&status));
+        return nullptr;
+    }
+    uint32_t w = wuffs_base__pixel_config__width(&config.pixcfg);
+    uint32_t h = wuffs_base__pixel_config__height(&config.pixcfg);
+    if (w == 0 || h == 0 || w > 0x4000 || h > 0x4000) {
+        LOGE("Invalid image size: %dx%d", int(w), int(h));
+        return nullptr;
+    }
+    wuffs_base__pixel_config__set(&config.pixcfg, WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+                                  WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, w, h);
+
+    size_t size = size_t(w)*h*4;
+    uint8_t* pixels = allocPixels(w, h, 4);
+    // work buffer (e.g. for JPEG coefficients) is pooled too
+    size_t workLen = size_t(wuffs_base__image_decoder__workbuf_len(dec).max_incl);
+    uint8_t* work = workLen ? PixelBufferPool::shared().acquire(workLen) : nullptr;
+
+    wuffs_base__pixel_buffer pixbuf = wuffs_base__null_pixel_buffer();
+    status = wuffs_base__pixel_buffer__set_from_slice(&pixbuf, &config.pixcfg, wuffs_base__make_slice_u8(pixels, size));
+    if (wuffs_base__status__is_ok(&status)) {
+        status = wuffs_base__image_decoder__decode_frame(dec, &pixbuf, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                                                         wuffs_base__make_slice_u8(work, workLen), nullptr);
+    }
+    if (work) { PixelBufferPool::shared().release(work, workLen); }
+    if (!wuffs_base__status__is_ok(&status)) {
+        LOGE("Error loading image data: %dx%d - %s", int(w), int(h), wuffs_base__status__message(&status));
+        freePixels(pixels, w, h, 4);
+        return nullptr;
+    }
+
+    flipRows(pixels, w, h, 4);
+    *width = w;
+    *height = h;
+    return pixels;
+}
+#endif
+
 uint8_t* loadImage(const uint8_t* data, size_t length, int* width, int* height, GLint* pixelfmt, int channels) {
     if (length < 2) return nullptr;
     // check for TIFF
@@ -84,18 +174,21 @@ uint8_t* loadImage(const uint8_t* data, size_t length, int* width, int* height,
             else if (image.samples_per_pixel == 4) fmt = GL_RGBA8;
         } else if (image.samples_per_pixel == 1) {
             // convert int16 and int32 images to float
-            std::vector<float> fdata(image.width*image.height);
+            uint8_t* pixels = nullptr;
+            bool isSigned = image.sample_format == tinydng::SAMPLEFORMAT_INT;
             if (image.bits_per_sample == 16) {
-                int16_t* src = (int16_t*)image.data.data();
-                for (size_t ii = 0; ii < fdata.size(); ++ii) { fdata[ii] = float(src[ii]); }
+                pixels = isSigned ? convertFlipped<int16_t>(image.data.data(), image.width, image.height)
+                    : convertFlipped<uint16_t>(image.data.data(), image.width, image.height);
             } else if (image.bits_per_sample == 32) {
-                int32_t* src = (int32_t*)image.data.data();
-                for (size_t ii = 0; ii < fdata.size(); ++ii) { fdata[ii] = float(src[ii]); }
+                pixels = isSigned ? convertFlipped<int32_t>(image.data.data(), image.width, image.height)
+                    : convertFlipped<uint32_t>(image.data.data(), image.width, image.height);
+            }
+            if (pixels) {
+                *width = image.width;
+                *height = image.height;
+                *pixelfmt = GL_R32F;
+                return pixels;
             }
-            *width = image.width;
-            *height = image.height;
-            *pixelfmt = GL_R32F;
-            return flipImage((uint8_t*)fdata.data(), image.width, image.height, 4);
         }
         if (!fmt) {
             LOGE("Unsupported TIFF: %d bits per sample, %d samples per pixel",
@@ -107,7 +200,7 @@ uint8_t* loadImage(const uint8_t* data, size_t length, int* width, int* height,
         *height = image.height;
         *pixelfmt = fmt;
         int bpp = image.samples_per_pixel*image.bits_per_sample/8;
-        return flipImage(image.data.data(), image.width, image.height, bpp);
+        return copyFlipped(image.data.data(), image.width, image.height, bpp);
 #else
         LOGE("TIFF support disabled - recompile with TANGRAM_TIFF_SUPPORT defined.");
         return nullptr;
@@ -160,43 +253,59 @@ uint8_t* loadImage(const uint8_t* data, size_t length, int* width, int* height,
         }
 
         int w = info.nCols, h = info.nRows;
-        //std::unique_ptr<uint8_t, malloc_deleter> pixels((uint8_t*)std::malloc(w * h * bpp));
-        std::vector<uint8_t> pixels(w * h * bpp, 0);
+        // decode directly into pooled buffer; pixels excluded by mask are not written, so must be cleared
+        uint8_t* pixels = allocPixels(w, h, bpp);
+        if (info.nMasks > 0) { std::memset(pixels, 0, size_t(w)*h*bpp); }
 
         // Lerc::Decode requires mask output if masks present, but we ignore for now
         std::vector<Byte> masks(info.nMasks * w * h, 0);
         Byte* pMasks = info.nMasks > 0 ? masks.data() : nullptr;
 
         if (info.dt == Lerc::DT_Float) {
-            float* fp = (float*)pixels.data();
+            float* fp = (float*)pixels;
             err = Lerc::DecodeTempl(fp, data, length, info.nDepth, w, h,
                                     info.nBands, info.nMasks, pMasks, nullptr, nullptr);
             // Tile of all zeros (very small compressed) may be returned instead of 404 - which is actually
             //  helpful since it is deduped in cache and saves us from repeating request for missing tile
             if (err == ErrCode::Ok && std::all_of(fp, fp + w*h, [](float x){ return x == 0.f; })) {
                 //LOGD("Discarding all zero LERC tile.");
+                freePixels(pixels, w, h, bpp);
                 return nullptr;
             }
         } else {
-            err = Lerc::DecodeTempl(pixels.data(), data, length, info.nDepth, w, h,
+            err = Lerc::DecodeTempl(pixels, data, length, info.nDepth, w, h,
                               info.nBands, info.nMasks, pMasks, nullptr, nullptr);
         }
 
         if (err != ErrCode::Ok) {
             LOGE("Lerc::Decode() failed with error %d", err);
+            freePixels(pixels, w, h, bpp);
             return nullptr;
         }
 
+        flipRows(pixels, w, h, bpp);
         *width = w;
         *height = h;
         *pixelfmt = fmt;
-        return flipImage(pixels.data(), w, h, bpp);
+        return pixels;
 #else
         LOGE("LERC support disabled - recompile with TANGRAM_LERC_SUPPORT defined.");
         return nullptr;
 #endif
     }
 
+#ifndef TANGRAM_NO_WUFFS
+    if (channels == 4) {
+        bool handled = false;
+        uint8_t* pixels = wuffsLoadRGBA(data, length, width, height, &handled);
+        if (handled) {
+            if (pixels) { *pixelfmt = GL_RGBA8; }
+            return pixels;
+        }
+    }
+#endif
+
+    // stb_image API allocates its own output, so rows are copied to pooled buffer
     int channelsInFile = 0;
     std::unique_ptr<uint8_t, malloc_deleter> pixels(
         stbi_load_from_memory(data, int(length), width, height, &channelsInFile, channels));
@@ -210,7 +319,7 @@ uint8_t* loadImage(const uint8_t* data, size_t length, int* width, int* height,
     else if (channels == 3) *pixelfmt = GL_RGB8;
     else if (channels == 4) *pixelfmt = GL_RGBA8;
 
-    return flipImage(pixels.get(), *width, *height, channels);
+    return copyFlipped(pixels.get(), *width, *height, channels);
 }
 
 }
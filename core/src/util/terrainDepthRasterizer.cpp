@@ -0,0 +1,176 @@
+#include "util/terrainDepthRasterizer.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+
+namespace Tangram {
+
+enum ClipCode : uint8_t {
+    CLIP_LEFT = 1, CLIP_RIGHT = 2, CLIP_BOTTOM = 4, CLIP_TOP = 8, CLIP_NEAR = 16, CLIP_FAR = 32
+};
+
+static uint8_t clipCode(const glm::vec4& _p) {
+    return (_p.x < -_p.w ? CLIP_LEFT : 0) | (_p.x > _p.w ? CLIP_RIGHT : 0)
+        | (_p.y < -_p.w ? CLIP_BOTTOM : 0) | (_p.y > _p.w ? CLIP_TOP : 0)
+        | (_p.z < -_p.w ? CLIP_NEAR : 0) | (_p.z > _p.w ? CLIP_FAR : 0);
+}
+
+void TerrainDepthRasterizer::rasterize(std::vector<float>& _depth, int _width, int _height,
+                                       const glm::mat4& _proj, const std::vector<TileGrid>& _tiles) {
+    m_width = std::max(_width, 0);
+    m_height = std::max(_height, 0);
+    _depth.assign(size_t(m_width) * m_height, FLT_MAX);
+    m_buffer = _depth.data();
+    if (_depth.empty()) { return; }
+
+    std::vector<uint8_t> codes;
+    for (auto& tile : _tiles) {
+        int res = tile.resolution;
+        int n = res + 1;
+        if (res <= 0 || int(tile.heights.size()) != n*n) { continue; }
+
+        glm::mat4 mvp = _proj * tile.modelView;
+        const glm::mat4& mv = tile.modelView;
+        m_vertices.resize(n*n);
+        codes.resize(n*n);
+        uint8_t tileCodeAnd = 0xFF;
+        for (int row = 0; row < n; row++) {
+            for (int col = 0; col < n; col++) {
+                int idx = row*n + col;
+                glm::vec4 pos(col/float(res), row/float(res), tile.heights[idx], 1.0f);
+                auto& v = m_vertices[idx];
+                v.clip = mvp * pos;
+                v.depth = -(mv[0][2]*pos.x + mv[1][2]*pos.y + mv[2][2]*pos.z + mv[3][2]);
+                codes[idx] = clipCode(v.clip);
+                tileCodeAnd &= codes[idx];
+                // vertices in front of near plane are projected once for all their triangles
+                if (!(codes[idx] & (CLIP_NEAR | CLIP_FAR))) { project(v); }
+            }
+        }
+        // whole tile outside one frustum plane
+        if (tileCodeAnd) { continue; }
+
+        // same triangulation as RasterStyle mesh
+        for (int row = 0; row < res; row++) {
+            for (int col = 0; col < res; col++) {
+                int i00 = row*n + col, i10 = i00 + 1, i01 = i00 + n, i11 = i01 + 1;
+                const int tris[2][3] = {{i00, i10, i01}, {i10, i11, i01}};
+                for (auto& t : tris) {
+                    uint8_t c0 = codes[t[0]], c1 = codes[t[1]], c2 = codes[t[2]];
+                    if (c0 & c1 & c2) { continue; }
+                    if ((c0 | c1 | c2) & (CLIP_NEAR | CLIP_FAR)) {
+                        drawTriangle(m_vertices[t[0]], m_vertices[t[1]], m_vertices[t[2]]);
+                    } else {
+                        fillTriangle(m_vertices[t[0]], m_vertices[t[1]], m_vertices[t[2]]);
+                    }
+                }
+            }
+        }
+    }
+
+    // empty pixels are 0, as for cleared framebuffer
+    for (float& d : _depth) { d = d == FLT_MAX ? 0.0f : d; }
+    m_buffer = nullptr;
+}
+
+void TerrainDepthRasterizer::project(Vertex& _v) const {
+    // window coords with pixel (0,0) at bottom left
+    _v.invW = 1.0f/_v.clip.w;
+    _v.sx = (_v.clip.x*_v.invW*0.5f + 0.5f)*m_width;
+    _v.sy = (_v.clip.y*_v.invW*0.5f + 0.5f)*m_height;
+    _v.depthW = _v.depth*_v.invW;
+}
+
+// clip against near and far planes, then fill resulting polygon as a fan
+void TerrainDepthRasterizer::drawTriangle(const Vertex& _v0, const Vertex& _v1, const Vertex& _v2) {
+    Vertex polyA[5] = {_v0, _v1, _v2}, polyB[5];
+    int count = 3;
+
+    auto clipPlane = [&](const Vertex* in, int nin, Vertex* out, float sign) {
+        int nout = 0;
+        for (int i = 0; i < nin; i++) {
+            const Vertex& a = in[i];
+            const Vertex& b = in[(i + 1) % nin];
+            // signed distance: z >= -w for near (sign = 1), z <= w for far (sign = -1)
+            float da = sign*a.clip.z + a.clip.w;
+            float db = sign*b.clip.z + b.clip.w;
+            if (da >= 0) { out[nout++] = a; }
+            if ((da >= 0) != (db >= 0)) {
+                float t = da/(da - db);
+                Vertex& v = out[nout++];
+                v.clip = a.clip + t*(b.clip - a.clip);
+                v.depth = a.depth + t*(b.depth - a.depth);
+            }
+        }
+        return nout;
+    };
+
+    count = clipPlane(polyA, count, polyB, 1.0f);
+    if (count < 3) { return; }
+    count = clipPlane(polyB, count, polyA, -1.0f);
+    for (int i = 0; i < count; i++) { project(polyA[i]); }
+    for (int i = 1; i + 1 < count; i++) {
+        fillTriangle(polyA[0], polyA[i], polyA[i + 1]);
+    }
+}
+
+void TerrainDepthRasterizer::fillTriangle(const Vertex& _v0, const Vertex& _v1, const Vertex& _v2) {
+    float sx[3] = {_v0.sx, _v1.sx, _v2.sx}, sy[3] = {_v0.sy, _v1.sy, _v2.sy};
+
+    // pixels with centers in bounding box; most triangles of a distant tile cover none
+    int x0 = std::max(0, int(std::ceil(std::min(sx[0], std::min(sx[1], sx[2])) - 0.5f)));
+    int x1 = std::min(m_width - 1, int(std::floor(std::max(sx[0], std::max(sx[1], sx[2])) - 0.5f)));
+    if (x0 > x1) { return; }
+    int y0 = std::max(0, int(std::ceil(std::min(sy[0], std::min(sy[1], sy[2])) - 0.5f)));
+    int y1 = std::min(m_height - 1, int(std::floor(std::max(sy[0], std::max(sy[1], sy[2])) - 0.5f)));
+    if (y0 > y1) { return; }
+
+    float invW[3] = {_v0.invW, _v1.invW, _v2.invW}, depthW[3] = {_v0.depthW, _v1.depthW, _v2.depthW};
+    float area = (sx[1] - sx[0])*(sy[2] - sy[0]) - (sx[2] - sx[0])*(sy[1] - sy[0]);
+    if (!(std::abs(area) > 0)) { return; }
+    // make counter-clockwise so inside has all edge functions >= 0
+    if (area < 0) {
+        std::swap(sx[1], sx[2]);
+        std::swap(sy[1], sy[2]);
+        std::swap(invW[1], invW[2]);
+        std::swap(depthW[1], depthW[2]);
+    }
+
+    // edge function i is opposite vertex i, i.e., its barycentric weight (times area)
+    float ex[3], ey[3], ec[3];
+    for (int i = 0; i < 3; i++) {
+        int a = (i + 1) % 3, b = (i + 2) % 3;
+        ex[i] = sy[a] - sy[b];
+        ey[i] = sx[b] - sx[a];
+        ec[i] = sx[a]*sy[b] - sx[b]*sy[a];
+    }
+    // numerator (depth/w) and denominator (1/w), both unnormalized by area which cancels
+    float nx = ex[0]*depthW[0] + ex[1]*depthW[1] + ex[2]*depthW[2];
+    float ny = ey[0]*depthW[0] + ey[1]*depthW[1] + ey[2]*depthW[2];
+    float nc = ec[0]*depthW[0] + ec[1]*depthW[1] + ec[2]*depthW[2];
+    float dx = ex[0]*invW[0] + ex[1]*invW[1] + ex[2]*invW[2];
+    float dy = ey[0]*invW[0] + ey[1]*invW[1] + ey[2]*invW[2];
+    float dc = ec[0]*invW[0] + ec[1]*invW[1] + ec[2]*invW[2];
+
+    float cx0 = x0 + 0.5f;
+    for (int y = y0; y <= y1; y++) {
+        float cy = y + 0.5f;
+        float e0 = ex[0]*cx0 + ey[0]*cy + ec[0];
+        float e1 = ex[1]*cx0 + ey[1]*cy + ec[1];
+        float e2 = ex[2]*cx0 + ey[2]*cy + ec[2];
+        float num = nx*cx0 + ny*cy + nc;
+        float den = dx*cx0 + dy*cy + dc;
+        float* row = m_buffer + size_t(y)*m_width;
+        // branch-free span loop so compiler can vectorize it
+        for (int x = x0; x <= x1; x++) {
+            float t = float(x - x0);
+            bool inside = (e0 + t*ex[0] >= 0) & (e1 + t*ex[1] >= 0) & (e2 + t*ex[2] >= 0);
+            float depth = (num + t*nx)/(den + t*dx);
+            row[x] = inside ? std::min(row[x], depth) : row[x];
+        }
+    }
+}
+
+}
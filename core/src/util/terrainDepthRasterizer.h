@@ -0,0 +1,51 @@
+#pragma once
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec4.hpp"
+
+#include <vector>
+
+namespace Tangram {
+
+/* Software rasterizer for terrain depth
+ *
+ * Draws the height grids of terrain tiles into a low resolution buffer of camera space depth (-z, as written
+ * by the terrain depth shader), so label and marker occlusion can be computed without a GL context or
+ * readback. Depth is interpolated perspective-correctly and the nearest surface is kept, as with a GPU
+ * depth test. No GL calls, so it can run on any thread.
+ */
+class TerrainDepthRasterizer {
+public:
+
+    struct TileGrid {
+        // tile model space (unit square, y north, z up in tile units) to camera space
+        glm::mat4 modelView;
+        // (resolution + 1)^2 heights in tile units, row 0 at south edge
+        std::vector<float> heights;
+        int resolution = 0;
+    };
+
+    // resize _depth to _width x _height (row 0 at bottom, like glReadPixels) and fill with depth of _tiles;
+    //  0 where there is no terrain
+    void rasterize(std::vector<float>& _depth, int _width, int _height, const glm::mat4& _proj,
+                   const std::vector<TileGrid>& _tiles);
+
+private:
+
+    struct Vertex {
+        glm::vec4 clip;
+        float depth;
+        // window coords, 1/w and depth/w, which are linear in screen space
+        float sx, sy, invW, depthW;
+    };
+
+    void project(Vertex& _v) const;
+    void drawTriangle(const Vertex& _v0, const Vertex& _v1, const Vertex& _v2);
+    void fillTriangle(const Vertex& _v0, const Vertex& _v1, const Vertex& _v2);
+
+    std::vector<Vertex> m_vertices;
+    float* m_buffer = nullptr;
+    int m_width = 0, m_height = 0;
+};
+
+}
@@ -0,0 +1,408 @@
+#include "util/textureCompression.h"
+
+#include "gl/hardware.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace Tangram {
+namespace TextureCompression {
+
+static const char MAGIC[4] = {'T', 'G', 'C', 'T'};
+
+// 4x4 block of RGB pixels; edge blocks repeat last row/column of image
+struct Block {
+    int px[16][3];  // index y*4 + x
+};
+
+static bool loadBlock(const uint8_t* _rgba, int _width, int _height, int _bx, int _by, Block& _block) {
+    for (int y = 0; y < 4; ++y) {
+        int iy = std::min(_by*4 + y, _height - 1);
+        for (int x = 0; x < 4; ++x) {
+            int ix = std::min(_bx*4 + x, _width - 1);
+            const uint8_t* p = &_rgba[(size_t(iy)*_width + ix)*4];
+            if (p[3] != 255) { return false; }
+            int* dst = _block.px[y*4 + x];
+            dst[0] = p[0]; dst[1] = p[1]; dst[2] = p[2];
+        }
+    }
+    return true;
+}
+
+static void storeBlock(const int (&_px)[16][3], uint8_t* _rgba, int _width, int _height, int _bx, int _by) {
+    for (int y = 0; y < 4 && _by*4 + y < _height; ++y) {
+        for (int x = 0; x < 4 && _bx*4 + x < _width; ++x) {
+            uint8_t* p = &_rgba[(size_t(_by*4 + y)*_width + _bx*4 + x)*4];
+            p[0] = _px[y*4 + x][0]; p[1] = _px[y*4 + x][1]; p[2] = _px[y*4 + x][2]; p[3] = 255;
+        }
+    }
+}
+
+static int colorError(const int* _a, const int* _b) {
+    int dr = _a[0] - _b[0], dg = _a[1] - _b[1], db = _a[2] - _b[2];
+    return dr*dr + dg*dg + db*db;
+}
+
+static int clamp255(int _v) { return std::min(std::max(_v, 0), 255); }
+
+// BC1 (S3TC DXT1): two RGB565 endpoints and 2 bit index per pixel into endpoints and 1/3, 2/3 blends
+
+static uint16_t pack565(const float* _c) {
+    int r = std::min(std::max(int(_c[0]*31/255 + 0.5f), 0), 31);
+    int g = std::min(std::max(int(_c[1]*63/255 + 0.5f), 0), 63);
+    int b = std::min(std::max(int(_c[2]*31/255 + 0.5f), 0), 31);
+    return uint16_t((r << 11) | (g << 5) | b);
+}
+
+static void unpack565(uint16_t _c, int* _rgb) {
+    int r = _c >> 11, g = (_c >> 5) & 0x3F, b = _c & 0x1F;
+    _rgb[0] = (r << 3) | (r >> 2);
+    _rgb[1] = (g << 2) | (g >> 4);
+    _rgb[2] = (b << 3) | (b >> 2);
+}
+
+static void bc1Palette(uint16_t _c0, uint16_t _c1, int (&_pal)[4][3]) {
+    unpack565(_c0, _pal[0]);
+    unpack565(_c1, _pal[1]);
+    for (int i = 0; i < 3; ++i) {
+        _pal[2][i] = (2*_pal[0][i] + _pal[1][i])/3;
+        _pal[3][i] = (_pal[0][i] + 2*_pal[1][i])/3;
+    }
+}
+
+// choose nearest palette entry for each pixel; returns total error
+static int bc1Indices(const Block& _block, uint16_t _c0, uint16_t _c1, uint8_t (&_idx)[16]) {
+    int pal[4][3];
+    bc1Palette(_c0, _c1, pal);
+    int total = 0;
+    for (int i = 0; i < 16; ++i) {
+        int best = INT_MAX;
+        for (int j = 0; j < 4; ++j) {
+            int err = colorError(_block.px[i], pal[j]);
+            if (err < best) { best = err; _idx[i] = j; }
+        }
+        total += best;
+    }
+    return total;
+}
+
+static void bc1EncodeBlock(const Block& _block, uint8_t* _out) {
+    // endpoints at extremes of pixels projected onto principal axis (by power iteration on covariance)
+    float mean[3] = {0, 0, 0};
+    for (auto& p : _block.px) { for (int i = 0; i < 3; ++i) { mean[i] += p[i]/16.f; } }
+    float cov[6] = {0, 0, 0, 0, 0, 0};
+    for (auto& p : _block.px) {
+        float d[3] = {p[0] - mean[0], p[1] - mean[1], p[2] - mean[2]};
+        cov[0] += d[0]*d[0]; cov[1] += d[0]*d[1]; cov[2] += d[0]*d[2];
+        cov[3] += d[1]*d[1]; cov[4] += d[1]*d[2]; cov[5] += d[2]*d[2];
+    }
+    float axis[3] = {1, 1, 1};
+    for (int iter = 0; iter < 4; ++iter) {
+        float v[3] = {cov[0]*axis[0] + cov[1]*axis[1] + cov[2]*axis[2],
+                      cov[1]*axis[0] + cov[3]*axis[1] + cov[4]*axis[2],
+                      cov[2]*axis[0] + cov[4]*axis[1] + cov[5]*axis[2]};
+        float len = std::max(std::max(std::abs(v[0]), std::abs(v[1])), std::abs(v[2]));
+        if (len < 1e-6f) { break; }
+        for (int i = 0; i < 3; ++i) { axis[i] = v[i]/len; }
+    }
+    float tmin = 0, tmax = 0;
+    for (auto& p : _block.px) {
+        float t = (p[0] - mean[0])*axis[0] + (p[1] - mean[1])*axis[1] + (p[2] - mean[2])*axis[2];
+        tmin = std::min(tmin, t);
+        tmax = std::max(tmax, t);
+    }
+    float axisLen2 = axis[0]*axis[0] + axis[1]*axis[1] + axis[2]*axis[2];
+    // inset endpoints slightly since extremes are rarely hit exactly by all channels
+    float inset = (tmax - tmin)/16;
+    float e0[3], e1[3];
+    for (int i = 0; i < 3; ++i) {
+        e0[i] = mean[i] + axis[i]*(tmax - inset)/axisLen2;
+        e1[i] = mean[i] + axis[i]*(tmin + inset)/axisLen2;
+    }
+    uint16_t c0 = pack565(e0), c1 = pack565(e1);
+    uint8_t idx[16];
+    int err = bc1Indices(_block, c0, c1, idx);
+
+    // refine endpoints by least squares fit for chosen indices
+    if (err > 0 && c0 != c1) {
+        static const float weights[4] = {1, 0, 2/3.f, 1/3.f};
+        float aa = 0, ab = 0, bb = 0, ax[3] = {0, 0, 0}, bx[3] = {0, 0, 0};
+        for (int i = 0; i < 16; ++i) {
+            float w = weights[idx[i]];
+            aa += w*w; ab += w*(1 - w); bb += (1 - w)*(1 - w);
+            for (int k = 0; k < 3; ++k) { ax[k] += w*_block.px[i][k]; bx[k] += (1 - w)*_block.px[i][k]; }
+        }
+        float det = aa*bb - ab*ab;
+        if (std::abs(det) > 1e-6f) {
+            float r0[3], r1[3];
+            for (int k = 0; k < 3; ++k) {
+                r0[k] = (ax[k]*bb - bx[k]*ab)/det;
+                r1[k] = (bx[k]*aa - ax[k]*ab)/det;
+            }
+            uint16_t d0 = pack565(r0), d1 = pack565(r1);
+            uint8_t idx2[16];
+            int err2 = bc1Indices(_block, d0, d1, idx2);
+            if (err2 < err && d0 != d1) {
+                c0 = d0; c1 = d1; err = err2;
+                std::memcpy(idx, idx2, 16);
+            }
+        }
+    }
+
+    // c0 > c1 selects 4 color mode; c0 == c1 is 3 color mode, where index 0 is still c0
+    if (c0 < c1) {
+        std::swap(c0, c1);
+        for (auto& i : idx) { i ^= 1; }
+    } else if (c0 == c1) {
+        std::memset(idx, 0, 16);
+    }
+    uint32_t bits = 0;
+    for (int i = 0; i < 16; ++i) { bits |= uint32_t(idx[i]) << (2*i); }
+    _out[0] = c0 & 0xFF; _out[1] = c0 >> 8;
+    _out[2] = c1 & 0xFF; _out[3] = c1 >> 8;
+    for (int i = 0; i < 4; ++i) { _out[4 + i] = (bits >> (8*i)) & 0xFF; }
+}
+
+static void bc1DecodeBlock(const uint8_t* _in, int (&_px)[16][3]) {
+    uint16_t c0 = _in[0] | (_in[1] << 8), c1 = _in[2] | (_in[3] << 8);
+    uint32_t bits = _in[4] | (_in[5] << 8) | (_in[6] << 16) | (uint32_t(_in[7]) << 24);
+    int pal[4][3];
+    bc1Palette(c0, c1, pal);
+    if (c0 <= c1) {
+        // 3 color mode (never written by encoder, except for solid blocks using only index 0)
+        for (int i = 0; i < 3; ++i) { pal[2][i] = (pal[0][i] + pal[1][i])/2; pal[3][i] = 0; }
+    }
+    for (int i = 0; i < 16; ++i) {
+        std::memcpy(_px[i], pal[(bits >> (2*i)) & 3], sizeof(_px[i]));
+    }
+}
+
+// ETC1 (valid ETC2 RGB8): block split into two 2x4 or 4x2 subblocks, each with a base color (RGB444 each,
+//  or RGB555 + 3 bit signed delta for second subblock) and one of 8 modifier tables; each pixel adds one of
+//  4 table modifiers to all channels of base color
+
+static const int etcModifiers[8][2] = {
+    {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}
+};
+
+// index 0, 1: +small, +large; 2, 3: -small, -large
+static int etcModifier(int _table, int _idx) {
+    int m = etcModifiers[_table][_idx & 1];
+    return _idx & 2 ? -m : m;
+}
+
+// pixel index (y*4 + x) of _i-th pixel of _sub-th subblock
+static int etcSubblockPixel(bool _flip, int _sub, int _i) {
+    return _flip ? (_sub*2 + _i/4)*4 + _i%4 : (_i%4)*4 + _sub*2 + _i/4;
+}
+
+// best table and per-pixel modifier indices for subblock with base color; returns error
+static int etcFitSubblock(const Block& _block, bool _flip, int _sub, const int* _base,
+                          int& _table, uint8_t (&_idx)[16]) {
+    // modifier is added to all channels, so (ignoring clamping) the best one is nearest to the mean offset of
+    //  pixel from base color; 3x mean offset is compared to 3x modifiers to stay in integers
+    const int* px[8];
+    int offset3[8];
+    for (int i = 0; i < 8; ++i) {
+        px[i] = _block.px[etcSubblockPixel(_flip, _sub, i)];
+        offset3[i] = px[i][0] - _base[0] + px[i][1] - _base[1] + px[i][2] - _base[2];
+    }
+    int bestErr = INT_MAX;
+    for (int t = 0; t < 8; ++t) {
+        int colors[4][3];
+        for (int j = 0; j < 4; ++j) {
+            int m = etcModifier(t, j);
+            for (int k = 0; k < 3; ++k) { colors[j][k] = clamp255(_base[k] + m); }
+        }
+        int small3 = 3*etcModifiers[t][0], large3 = 3*etcModifiers[t][1];
+        int err = 0;
+        uint8_t idx[8];
+        for (int i = 0; i < 8 && err < bestErr; ++i) {
+            int d = offset3[i];
+            int j = d >= 0 ? (2*d > small3 + large3 ? 1 : 0) : (-2*d > small3 + large3 ? 3 : 2);
+            idx[i] = j;
+            err += colorError(px[i], colors[j]);
+        }
+        if (err < bestErr) {
+            bestErr = err;
+            _table = t;
+            for (int i = 0; i < 8; ++i) { _idx[etcSubblockPixel(_flip, _sub, i)] = idx[i]; }
+        }
+    }
+    return bestErr;
+}
+
+static void etcEncodeBlock(const Block& _block, uint8_t* _out) {
+    int bestErr = INT_MAX;
+    uint32_t bestHigh = 0;
+    uint8_t bestIdx[16] = {0};
+
+    for (int flip = 0; flip < 2; ++flip) {
+        float avg[2][3] = {{0, 0, 0}, {0, 0, 0}};
+        for (int sub = 0; sub < 2; ++sub) {
+            for (int i = 0; i < 8; ++i) {
+                const int* p = _block.px[etcSubblockPixel(flip, sub, i)];
+                for (int k = 0; k < 3; ++k) { avg[sub][k] += p[k]/8.f; }
+            }
+        }
+        // use differential mode if second base color is within delta range of first
+        int q[2][3], base[2][3];
+        bool diff = true;
+        for (int k = 0; k < 3; ++k) {
+            q[0][k] = std::min(int(avg[0][k]*31/255 + 0.5f), 31);
+            q[1][k] = std::min(int(avg[1][k]*31/255 + 0.5f), 31);
+            int d = q[1][k] - q[0][k];
+            if (d < -4 || d > 3) { diff = false; }
+        }
+        for (int sub = 0; sub < 2; ++sub) {
+            for (int k = 0; k < 3; ++k) {
+                if (diff) {
+                    base[sub][k] = (q[sub][k] << 3) | (q[sub][k] >> 2);
+                } else {
+                    q[sub][k] = std::min(int(avg[sub][k]*15/255 + 0.5f), 15);
+                    base[sub][k] = q[sub][k]*17;
+                }
+            }
+        }
+        int table[2];
+        uint8_t idx[16];
+        int err = etcFitSubblock(_block, flip, 0, base[0], table[0], idx);
+        if (err >= bestErr) { continue; }
+        err += etcFitSubblock(_block, flip, 1, base[1], table[1], idx);
+        if (err >= bestErr) { continue; }
+
+        uint32_t high = 0;
+        for (int k = 0; k < 3; ++k) {
+            int shift = 24 - 8*k;
+            if (diff) {
+                high |= uint32_t(q[0][k]) << (shift + 3) | uint32_t((q[1][k] - q[0][k]) & 7) << shift;
+            } else {
+                high |= uint32_t(q[0][k]) << (shift + 4) | uint32_t(q[1][k]) << shift;
+            }
+        }
+        high |= uint32_t(table[0]) << 5 | uint32_t(table[1]) << 2 | uint32_t(diff) << 1 | uint32_t(flip);
+        bestErr = err;
+        bestHigh = high;
+        std::memcpy(bestIdx, idx, 16);
+    }
+
+    // pixel indices are stored column major: bit x*4 + y of MSB and LSB halves
+    uint32_t low = 0;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            int bit = x*4 + y;
+            uint32_t i = bestIdx[y*4 + x];
+            low |= ((i >> 1) << (16 + bit)) | ((i & 1) << bit);
+        }
+    }
+    for (int i = 0; i < 4; ++i) {
+        _out[i] = (bestHigh >> (24 - 8*i)) & 0xFF;
+        _out[4 + i] = (low >> (24 - 8*i)) & 0xFF;
+    }
+}
+
+static void etcDecodeBlock(const uint8_t* _in, int (&_px)[16][3]) {
+    uint32_t high = uint32_t(_in[0]) << 24 | _in[1] << 16 | _in[2] << 8 | _in[3];
+    uint32_t low = uint32_t(_in[4]) << 24 | _in[5] << 16 | _in[6] << 8 | _in[7];
+    bool diff = high & 2, flip = high & 1;
+    int table[2] = {int(high >> 5) & 7, int(high >> 2) & 7};
+    int base[2][3];
+    for (int k = 0; k < 3; ++k) {
+        int shift = 24 - 8*k;
+        if (diff) {
+            int c0 = (high >> (shift + 3)) & 0x1F;
+            int d = (high >> shift) & 7;
+            int c1 = c0 + (d >= 4 ? d - 8 : d);
+            base[0][k] = (c0 << 3) | (c0 >> 2);
+            base[1][k] = (c1 << 3) | (c1 >> 2);
+        } else {
+            base[0][k] = ((high >> (shift + 4)) & 0xF)*17;
+            base[1][k] = ((high >> shift) & 0xF)*17;
+        }
+    }
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            int bit = x*4 + y;
+            int idx = ((low >> (16 + bit)) & 1) << 1 | ((low >> bit) & 1);
+            int sub = flip ? y/2 : x/2;
+            int m = etcModifier(table[sub], idx);
+            for (int k = 0; k < 3; ++k) { _px[y*4 + x][k] = clamp255(base[sub][k] + m); }
+        }
+    }
+}
+
+PixelFormat formatForHardware() {
+    // prefer S3TC since desktop drivers exposing ETC2 often decompress it to RGBA8
+    if (Hardware::supportsS3TC) { return PixelFormat::BC1_RGB; }
+    if (Hardware::supportsETC2) { return PixelFormat::ETC2_RGB; }
+    return PixelFormat::RGBA;
+}
+
+bool compress(PixelFormat _format, const uint8_t* _rgba, int _width, int _height, uint8_t* _out) {
+    if (_format != PixelFormat::BC1_RGB && _format != PixelFormat::ETC2_RGB) { return false; }
+    int bw = (_width + 3)/4, bh = (_height + 3)/4;
+    Block block;
+    for (int by = 0; by < bh; ++by) {
+        for (int bx = 0; bx < bw; ++bx) {
+            if (!loadBlock(_rgba, _width, _height, bx, by, block)) { return false; }
+            uint8_t* out = &_out[(size_t(by)*bw + bx)*8];
+            if (_format == PixelFormat::BC1_RGB) {
+                bc1EncodeBlock(block, out);
+            } else {
+                etcEncodeBlock(block, out);
+            }
+        }
+    }
+    return true;
+}
+
+void decompress(PixelFormat _format, const uint8_t* _blocks, int _width, int _height, uint8_t* _rgba) {
+    int bw = (_width + 3)/4, bh = (_height + 3)/4;
+    int px[16][3];
+    for (int by = 0; by < bh; ++by) {
+        for (int bx = 0; bx < bw; ++bx) {
+            const uint8_t* in = &_blocks[(size_t(by)*bw + bx)*8];
+            if (_format == PixelFormat::BC1_RGB) {
+                bc1DecodeBlock(in, px);
+            } else {
+                etcDecodeBlock(in, px);
+            }
+            storeBlock(px, _rgba, _width, _height, bx, by);
+        }
+    }
+}
+
+std::vector<char> encode(PixelFormat _format, const uint8_t* _rgba, int _width, int _height) {
+    TextureOptions options;
+    options.pixelFormat = _format;
+    std::vector<char> data(sizeof(Header) + options.imageSize(_width, _height));
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.format = uint32_t(_format);
+    header.width = _width;
+    header.height = _height;
+    std::memcpy(data.data(), &header, sizeof(Header));
+    if (!compress(_format, _rgba, _width, _height, reinterpret_cast<uint8_t*>(&data[sizeof(Header)]))) {
+        return {};
+    }
+    return data;
+}
+
+const uint8_t* parse(const std::vector<char>& _data, Header& _header) {
+    if (_data.size() < sizeof(Header) || std::memcmp(_data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        return nullptr;
+    }
+    std::memcpy(&_header, _data.data(), sizeof(Header));
+    TextureOptions options;
+    options.pixelFormat = PixelFormat(_header.format);
+    if (!options.isCompressed() || _header.width == 0 || _header.height == 0 ||
+            _data.size() != sizeof(Header) + options.imageSize(_header.width, _header.height)) {
+        return nullptr;
+    }
+    return reinterpret_cast<const uint8_t*>(&_data[sizeof(Header)]);
+}
+
+}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "gl/texture.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Tangram {
+
+/* CPU block compression of opaque RGBA8 raster textures
+ *
+ * Raster tiles can be transcoded on tile workers to a GPU block compressed format (8 bytes per 4x4 block, so
+ * 1/8 the size of RGBA8 in GPU memory and upload bandwidth): S3TC/BC1 or ETC2 RGB8 (encoded in the ETC1
+ * subset of ETC2). Encoders are fast single pass fits suitable for imagery and hillshading, not for
+ * offline quality compression. Images with any transparent pixels are not compressed.
+ */
+namespace TextureCompression {
+
+// header of compressed image kept beside raw data in memory tile cache, followed by blocks
+struct Header {
+    char magic[4];
+    uint32_t format;
+    uint32_t width;
+    uint32_t height;
+};
+
+// block compressed format supported by current GL context, or PixelFormat::RGBA if none
+PixelFormat formatForHardware();
+
+// Compress _width x _height RGBA8 image to _format, writing _format's imageSize() bytes to _out; returns
+//  false if image is not opaque
+bool compress(PixelFormat _format, const uint8_t* _rgba, int _width, int _height, uint8_t* _out);
+
+// Decompress blocks to RGBA8 (to check encoder quality without a GPU)
+void decompress(PixelFormat _format, const uint8_t* _blocks, int _width, int _height, uint8_t* _rgba);
+
+// Compress to Header + blocks; empty if image cannot be compressed
+std::vector<char> encode(PixelFormat _format, const uint8_t* _rgba, int _width, int _height);
+
+// Blocks of data from encode(), filling _header, or nullptr if _data is not a valid compressed image
+const uint8_t* parse(const std::vector<char>& _data, Header& _header);
+
+}
+
+}
@@ -622,40 +622,48 @@ float View::getTileScreenArea(TileID tile) const {
     if (dx > hc) { tc.x -= 1 << tc.z; }
     else if (dx < -hc) { tc.x += 1 << tc.z; }
 
-    // doesn't seem to significantly reduce number of tiles visible, so hold off for now (also need to do memcheck!)
-    //glm::vec2 elevlims = m_elevationManager && tile.z + 4 > int(m_zoom) ?
-    //    m_elevationManager->getMinMaxElev(tile, 3) : glm::vec2(0, 9000);
+    // clip space coords of tile corners (as rows x, y, z, w) at given elevations
+    auto clipQuad = [&](float e00, float e01, float e10, float e11) {
+        return glm::transpose(glm::mat4(tileCoordsToClipSpace(tc, e00),
+                                        tileCoordsToClipSpace({tc.x, tc.y + 1, tc.z}, e01),
+                                        tileCoordsToClipSpace({tc.x + 1, tc.y, tc.z}, e10),
+                                        tileCoordsToClipSpace({tc.x + 1, tc.y + 1, tc.z}, e11)));
+    };
+
+    // min/max elevation of tile from DEM pyramid, if DEM for tile or close ancestor is loaded
+    glm::vec2 elevLims;
+    bool hasElevLims = m_elevationManager && m_elevationManager->getMinMaxElev(tile, elevLims, 3);
 
     // use elevation at center of screen (used to calc m_zoom) for tile bottom
     // 1 - 2^(base_z - z) gives normalized distance along pos -> eye vector of terrain intersection, so
     //  multiplying by eye elev gives terrain elev (similar triangles)
     float elev0 = m_elevationManager ? m_eye.z * (1 - std::exp2(m_baseZoom - m_zoom)) : 0;
-    auto a00 = tileCoordsToClipSpace(tc, elev0);
-    auto a01 = tileCoordsToClipSpace({tc.x, tc.y + 1, tc.z}, elev0);
-    auto a10 = tileCoordsToClipSpace({tc.x + 1, tc.y, tc.z}, elev0);
-    auto a11 = tileCoordsToClipSpace({tc.x + 1, tc.y + 1, tc.z}, elev0);
-    auto a = glm::transpose(glm::mat4(a00, a01, a10, a11));
+    if (hasElevLims) { elev0 = glm::clamp(elev0, elevLims.x, elevLims.y); }
+    auto a = clipQuad(elev0, elev0, elev0, elev0);
     auto wa = glm::abs(a[3]);
 
     if (m_elevationManager) {  //&& m_pitch != 0) {
-        glm::dvec3 eye(m_pos.x + m_eye.x, m_pos.y + m_eye.y, m_eye.z);
-        double dist = glm::distance(eye, glm::dvec3(MapProjection::tileCenter(tile), 0.));
-        //if(dist - std::abs(bounds.max.x - bounds.min.x)/M_SQRT2 > maxTileDistance) { return; } ... only covers ~30% of tiles
-        float elev1 = (dist < m_pos.z) ? std::min(9000.f, m_eye.z) : 0;  // Mt. Everest
-
-        auto b00 = tileCoordsToClipSpace(tc, elev1);
-        auto b01 = tileCoordsToClipSpace({tc.x, tc.y + 1, tc.z}, 0);  //elev1);
-        auto b10 = tileCoordsToClipSpace({tc.x + 1, tc.y, tc.z}, 0);  //elev1);
-        auto b11 = tileCoordsToClipSpace({tc.x + 1, tc.y + 1, tc.z}, elev1);
-        auto b = glm::transpose(glm::mat4(b00, b01, b10, b11));
-        auto wb = glm::abs(b[3]);
-
-        if (allLess(a[0], -wa) && allLess(b[0], -wb))     { return 0; }
-        if (allGreater(a[0], wa) && allGreater(b[0], wb)) { return 0; }
-        if (allLess(a[1], -wa) && allLess(b[1], -wb))     { return 0; }
-        if (allGreater(a[1], wa) && allGreater(b[1], wb)) { return 0; }
-        if (allLess(a[2], -wa) && allLess(b[2], -wb))     { return 0; }
-        if (allGreater(a[2], wa) && allGreater(b[2], wb)) { return 0; }
+        // tile is culled if bottom and top of its bounding box are outside the same clip plane
+        glm::mat4 lo = a, hi;
+        if (hasElevLims) {
+            lo = clipQuad(elevLims.x, elevLims.x, elevLims.x, elevLims.x);
+            hi = clipQuad(elevLims.y, elevLims.y, elevLims.y, elevLims.y);
+        } else {
+            glm::dvec3 eye(m_pos.x + m_eye.x, m_pos.y + m_eye.y, m_eye.z);
+            double dist = glm::distance(eye, glm::dvec3(MapProjection::tileCenter(tile), 0.));
+            //if(dist - std::abs(bounds.max.x - bounds.min.x)/M_SQRT2 > maxTileDistance) { return; } ... only covers ~30% of tiles
+            float elev1 = (dist < m_pos.z) ? std::min(9000.f, m_eye.z) : 0;  // Mt. Everest
+            hi = clipQuad(elev1, 0, 0, elev1);
+        }
+        auto wlo = glm::abs(lo[3]);
+        auto whi = glm::abs(hi[3]);
+
+        if (allLess(lo[0], -wlo) && allLess(hi[0], -whi))     { return 0; }
+        if (allGreater(lo[0], wlo) && allGreater(hi[0], whi)) { return 0; }
+        if (allLess(lo[1], -wlo) && allLess(hi[1], -whi))     { return 0; }
+        if (allGreater(lo[1], wlo) && allGreater(hi[1], whi)) { return 0; }
+        if (allLess(lo[2], -wlo) && allLess(hi[2], -whi))     { return 0; }
+        if (allGreater(lo[2], wlo) && allGreater(hi[2], whi)) { return 0; }
     } else {
         if (allLess(a[0], -wa) || allGreater(a[0], wa)) { return 0; }
         if (allLess(a[1], -wa) || allGreater(a[1], wa)) { return 0; }
@@ -664,11 +672,13 @@ float View::getTileScreenArea(TileID tile) const {
 
     if (m_pitch == 0 || !allGreater(a[3], glm::vec4(0))) return FLT_MAX;
 
+    // columns of transposed a are clip space corners
+    auto corners = glm::transpose(a);
     glm::vec2 screenSize(m_vpWidth, m_vpHeight);
-    auto r00 = ndcToScreenSpace(clipSpaceToNdc(a00), screenSize);
-    auto r01 = ndcToScreenSpace(clipSpaceToNdc(a01), screenSize);
-    auto r10 = ndcToScreenSpace(clipSpaceToNdc(a10), screenSize);
-    auto r11 = ndcToScreenSpace(clipSpaceToNdc(a11), screenSize);
+    auto r00 = ndcToScreenSpace(clipSpaceToNdc(corners[0]), screenSize);
+    auto r01 = ndcToScreenSpace(clipSpaceToNdc(corners[1]), screenSize);
+    auto r10 = ndcToScreenSpace(clipSpaceToNdc(corners[2]), screenSize);
+    auto r11 = ndcToScreenSpace(clipSpaceToNdc(corners[3]), screenSize);
     auto pts = {r00, r01, r11, r10};
     return std::abs(signedArea(pts.begin(), pts.end()));
 }
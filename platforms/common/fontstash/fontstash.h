@@ -119,6 +119,8 @@ void fonsGetAtlasSize(FONScontext* s, int* width, int* height, int* atlasFontPx)
 int fonsExpandAtlas(FONScontext* s, int width, int height);
 // Resets the whole stash.
 int fonsResetAtlas(FONScontext* stash, int width, int height, int atlasFontPx);
+// Discards glyphs in atlas rows [y0, y1) and restricts new glyphs to these rows (until next reset)
+int fonsResetAtlasRows(FONScontext* stash, int y0, int y1);
 
 // Add fonts
 int fonsAddFont(FONScontext* s, const char* name, const char* path);
@@ -484,6 +486,7 @@ struct FONSatlas
   //int cellw, cellh;
   int rowh;
   int nextx, nexty;
+  int endy;  // if > 0, limit for nexty (set by fonsResetAtlasRows)
 };
 typedef struct FONSatlas FONSatlas;
 
@@ -583,6 +586,7 @@ static void fons__atlasReset(FONSatlas* atlas, int w, int h)  //, int cellw, int
   atlas->nextx = 0;
   atlas->nexty = 0;
   atlas->rowh = 0;
+  atlas->endy = 0;
 }
 
 static int fons__atlasAddCell(FONScontext* stash, int w, int h, int* x, int* y)
@@ -599,7 +603,7 @@ static int fons__atlasAddCell(FONScontext* stash, int w, int h, int* x, int* y)
     atlas->nexty = (atlas->nexty/blockh + 1)*blockh;
     atlas->rowh = 0;
   }
-  if (atlas->nexty + h > atlas->height)
+  if (atlas->nexty + h > (atlas->endy > 0 ? atlas->endy : atlas->height))
     return 0;
 
   *x = atlas->nextx;
@@ -1391,6 +1395,50 @@ int fonsResetAtlas(FONScontext* stash, int width, int height, int atlasFontPx)
   return 1;
 }
 
+static int fons__glyphInRows(FONSglyph* glyph, int y0, int y1)
+{
+  // glyphs w/o bitmap have negative coords
+  return glyph->x0 >= 0 && glyph->y0 >= y0 && glyph->y0 < y1;
+}
+
+int fonsResetAtlasRows(FONScontext* stash, int y0, int y1)
+{
+  int i, j, h, n, notDef, dropNotDef;
+  size_t rowBytes;
+  if (stash == NULL || y0 < 0 || y1 > stash->atlas->height || y0 >= y1) return 0;
+
+  // Remove glyphs in rows from cache, rebuilding hash lookup for remaining glyphs; glyphs referencing
+  //  notdef glyph (index < 0) are also removed if notdef glyph is
+  for (i = 0; i < stash->nfonts; i++) {
+    FONSfont* font = stash->fonts[i];
+    notDef = font->notDef;
+    dropNotDef = notDef >= 0 && fons__glyphInRows(&font->glyphs[notDef], y0, y1);
+    font->notDef = -1;
+    for (j = 0; j < FONS_HASH_LUT_SIZE; j++)
+      font->lut[j] = -1;
+    for (j = 0, n = 0; j < font->nglyphs; j++) {
+      FONSglyph glyph = font->glyphs[j];
+      if (fons__glyphInRows(&glyph, y0, y1) || (dropNotDef && glyph.index < 0)) continue;
+      if (j == notDef) font->notDef = n;
+      h = fons__hashint(glyph.codepoint) & (FONS_HASH_LUT_SIZE-1);
+      glyph.next = font->lut[h];
+      font->lut[h] = n;
+      font->glyphs[n++] = glyph;
+    }
+    font->nglyphs = n;
+  }
+
+  // Clear texture data - glyph rendering assumes cell is zeroed
+  rowBytes = stash->atlas->width * (stash->params.flags & FONS_SUMMED ? sizeof(FONStexelF) : sizeof(FONStexelU8));
+  memset((unsigned char*)stash->texData + y0 * rowBytes, 0, (y1 - y0) * rowBytes);
+
+  stash->atlas->nextx = 0;
+  stash->atlas->nexty = y0;
+  stash->atlas->rowh = 0;
+  stash->atlas->endy = y1;
+  return 1;
+}
+
 // moved here from nanovg.c
 int fonsBreakLines(FONSstate* state, const char* string, const char* end, float breakRowWidth, FONStextRow* rows, int maxRows)
 {
@@ -187,6 +187,10 @@ void GL::texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
                        GLenum format, GLenum type, const GLvoid *pixels) {
     GL_CHECK(glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels)); }
 
+void GL::compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                              GLint border, GLsizei imageSize, const GLvoid *data) {
+    GL_CHECK(glCompressedTexImage2D(target, level, internalFormat, width, height, border, imageSize, data)); }
+
 void GL::generateMipmap(GLenum target) {
     GL_CHECK(glGenerateMipmap(target));
 }
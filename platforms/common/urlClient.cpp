@@ -1,8 +1,11 @@
 #include "urlClient.h"
 #include "log.h"
+#include "debug/trace.h"
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstring>
+#include <vector>
 #include <curl/curl.h>
 #ifndef _MSC_VER
 #include <unistd.h>
@@ -172,9 +175,9 @@ struct UrlClient::Task {
         curl_easy_setopt(handle, CURLOPT_COOKIEFILE, "");  // in-memory cookie store only
         curl_easy_setopt(handle, CURLOPT_SHARE, _parent.m_curlShare);
         if (_options.maxHttpVersion > 1) {
-            // try HTTP/2
-            if (curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_0) != 0) {
-                LOGE("Error setting CURL_HTTP_VERSION_2_0!");
+            // try HTTP/2 for https (plain http stays HTTP/1.1)
+            if (curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS) != 0) {
+                LOGE("Error setting CURL_HTTP_VERSION_2TLS!");
             }
         }
         // building curl with CURL_CA_NATIVE option should work instead
@@ -225,6 +228,7 @@ UrlClient::UrlClient(Options options) : m_options(options) {
     curl_share_setopt(m_curlShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
     curl_share_setopt(m_curlShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
     curl_multi_setopt(m_curlHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    curl_multi_setopt(m_curlHandle, CURLMOPT_MAX_HOST_CONNECTIONS, long(m_options.maxHostConnections));
     m_curlRunning = true;
     m_curlWorker = std::make_unique<std::thread>(&UrlClient::curlLoop, this);
 
@@ -272,14 +276,15 @@ void UrlClient::curlWakeUp() {
 UrlClient::RequestId UrlClient::addRequest(const std::string& _url, const HttpOptions& _options, UrlCallback _onComplete) {
 
     auto id = ++m_requestCount;
-    Request request = {_url, _options, _onComplete, id};
+    Request request = {_url, _options, _onComplete, id, Url(_url).netLocation()};
 
     // Add the request to our list.
     {
         // Lock the mutex to prevent concurrent modification of the
         // list by the curl thread.
         std::lock_guard<std::mutex> lock(m_requestMutex);
-        m_requests.push_back(request);
+        getHost(request.host).stats.pending++;
+        m_requests.push_back(std::move(request));
     }
     curlWakeUp();
 
@@ -295,6 +300,7 @@ void UrlClient::cancelRequest(RequestId _id) {
             auto& request = *it;
             if (request.id == _id) {
                 callback = std::move(request.callback);
+                getHost(request.host).stats.pending--;
                 m_requests.erase(it);
                 break;
             }
@@ -338,14 +344,141 @@ void UrlClient::cancelAllRequests()
         }
     }
     m_requests.clear();
+    for (auto& host : m_hosts) {
+        host.second.stats.pending = 0;
+    }
+}
+
+std::unordered_map<std::string, UrlClient::HostStats> UrlClient::getHostStats() {
+    std::lock_guard<std::mutex> lock(m_requestMutex);
+    std::unordered_map<std::string, HostStats> stats;
+    for (auto& host : m_hosts) {
+        stats.emplace(host.first, host.second.stats);
+    }
+    return stats;
+}
+
+UrlClient::Host& UrlClient::getHost(const std::string& name) {
+    auto it = m_hosts.find(name);
+    if (it != m_hosts.end()) { return it->second; }
+
+    Host& host = m_hosts[name];
+    // start at the usual browser HTTP/1.1 per-host limit
+    host.stats.limit = m_options.adaptiveConcurrency ?
+        float(std::max(m_options.minHostTasks, std::min(m_options.maxHostTasks, m_options.maxHostConnections)))
+        : float(m_options.maxHostTasks);
+    host.windowStart = clock::now();
+    return host;
+}
+
+void UrlClient::updateHostStats(Host& host, void* handle, int resultCode) {
+    // Additive increase / multiplicative decrease of the per-host concurrency limit: while time to first
+    //  byte stays near the baseline or throughput is still growing, allow one more request per round trip
+    //  (limit += 1/limit per completion); when latency inflates without a throughput gain, the link or
+    //  server is saturated and further requests only add queuing delay, so back off.
+    static constexpr float alpha = 0.125f;  // EWMA weight, as used for TCP SRTT
+    static constexpr float decreaseFactor = 0.75f;
+    static constexpr auto windowDuration = std::chrono::milliseconds(1000);
+
+    auto& stats = host.stats;
+    auto now = clock::now();
+    stats.active--;
+
+    if (resultCode != CURLE_OK) {
+        stats.failed++;
+        // HTTP errors (e.g. 404) say nothing about congestion
+        bool timeout = resultCode == CURLE_OPERATION_TIMEDOUT || resultCode == CURLE_COULDNT_CONNECT;
+        if (timeout && m_options.adaptiveConcurrency) {
+            stats.limit = std::max(float(m_options.minHostTasks), stats.limit * 0.5f);
+            host.lastDecrease = now;
+        }
+        return;
+    }
+
+    stats.completed++;
+
+    double ttfb = 0;
+    curl_off_t downloaded = 0;
+    long httpVersion = 0;
+    curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME, &ttfb);
+    curl_easy_getinfo(handle, CURLINFO_SIZE_DOWNLOAD_T, &downloaded);
+    curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &httpVersion);
+    stats.multiplexed = httpVersion == CURL_HTTP_VERSION_2_0;
+
+    float rttMs = float(ttfb * 1000);
+    stats.rttMs = stats.completed == 1 ? rttMs : stats.rttMs + alpha*(rttMs - stats.rttMs);
+    // baseline (uncongested) latency is the minimum observed, as for TCP Vegas
+    stats.minRttMs = stats.completed == 1 ? rttMs : std::min(rttMs, stats.minRttMs);
+
+    host.windowBytes += size_t(downloaded);
+    auto elapsed = now - host.windowStart;
+    if (elapsed >= windowDuration) {
+        float bps = host.windowBytes / std::chrono::duration<float>(elapsed).count();
+        host.prevBytesPerSec = stats.bytesPerSec;
+        stats.bytesPerSec = stats.bytesPerSec == 0 ? bps : stats.bytesPerSec + 0.25f*(bps - stats.bytesPerSec);
+        host.windowBytes = 0;
+        host.windowStart = now;
+    }
+
+    if (!m_options.adaptiveConcurrency) { return; }
+
+    // without HTTP/2, requests beyond the connection limit are queued by curl anyway
+    float maxLimit = float(stats.multiplexed ? m_options.maxHostTasks :
+                           std::min(m_options.maxHostTasks, m_options.maxHostConnections));
+    bool congested = stats.rttMs > m_options.latencyTolerance * std::max(stats.minRttMs, 1.0f);
+    // no growth can be measured before two windows have completed
+    bool throughputGrowing = host.prevBytesPerSec > 0 && stats.bytesPerSec > 1.05f*host.prevBytesPerSec;
+    if (congested && !throughputGrowing) {
+        // at most one decrease per RTT, since completions in flight all saw the same congestion
+        if (now - host.lastDecrease > std::chrono::duration<float, std::milli>(stats.rttMs)) {
+            stats.limit = std::max(float(m_options.minHostTasks), stats.limit * decreaseFactor);
+            host.lastDecrease = now;
+        }
+    } else if (stats.active + 1 >= uint32_t(stats.limit)) {
+        // only grow if the current limit is actually being used
+        stats.limit += 1/stats.limit;
+    }
+    stats.limit = std::min(stats.limit, maxLimit);
 }
 
 void UrlClient::startPendingRequests() {
+    // Query priorities without holding m_requestMutex: callbacks may lock (and so end up releasing)
+    //  objects owned by other threads, e.g. TileTasks
+    std::vector<std::pair<RequestId, std::function<double()>>> priorityFns;
+    {
+        std::lock_guard<std::mutex> lock(m_requestMutex);
+        if (m_activeTasks >= m_options.maxActiveTasks || m_requests.empty()) { return; }
+
+        for (auto& request : m_requests) {
+            if (request.options.priority) { priorityFns.emplace_back(request.id, request.options.priority); }
+        }
+    }
+    std::unordered_map<RequestId, double> priorities;
+    for (auto& fn : priorityFns) { priorities[fn.first] = fn.second(); }
+    priorityFns.clear();
+
     std::unique_lock<std::mutex> lock(m_requestMutex);
 
+    if (m_activeTasks >= m_options.maxActiveTasks || m_requests.empty()) { return; }
+
+    // dispatch most urgent requests first; stable sort keeps FIFO order for equal priority. Requests
+    //  added in the meantime keep their initial (lowest) priority until next call
+    for (auto& request : m_requests) {
+        auto it = priorities.find(request.id);
+        if (it != priorities.end()) { request.priority = it->second; }
+    }
+    std::stable_sort(m_requests.begin(), m_requests.end(),
+                     [](const Request& a, const Request& b) { return a.priority < b.priority; });
+
+    auto next = m_requests.begin();
     while (m_activeTasks < m_options.maxActiveTasks) {
 
-        if (m_requests.empty()) { break; }
+        // skip requests for hosts already at their concurrency limit
+        next = std::find_if(next, m_requests.end(), [&](const Request& r) {
+            auto& stats = m_hosts[r.host].stats;
+            return stats.active < uint32_t(stats.limit);
+        });
+        if (next == m_requests.end()) { break; }
 
         if (m_tasks.front().active) {
             m_tasks.emplace_front(*this, m_options);
@@ -360,12 +493,20 @@ void UrlClient::startPendingRequests() {
 
         task.setup();
 
-        task.request = std::move(m_requests.front());
-        m_requests.erase(m_requests.begin());
+        task.request = std::move(*next);
+        next = m_requests.erase(next);
+
+        auto& hostStats = m_hosts[task.request.host].stats;
+        hostStats.pending--;
+        hostStats.active++;
 
         // Configure the easy handle.
         const char* url = task.request.url.c_str();
         curl_easy_setopt(task.handle, CURLOPT_URL, url);
+        // for HTTP/2, wait for an existing connection to the host so requests are multiplexed instead of
+        //  opening new connections (for HTTP/1.x this would serialize requests)
+        bool pipewait = m_options.maxHttpVersion > 1 && task.request.url.compare(0, 8, "https://") == 0;
+        curl_easy_setopt(task.handle, CURLOPT_PIPEWAIT, long(pipewait));
 
         // set custom request headers
         curl_slist_free_all(task.slist);
@@ -393,12 +534,14 @@ void UrlClient::startPendingRequests() {
         LOGD("Tasks %d - starting request for url: %s", int(m_activeTasks), url);
 
         curl_multi_add_handle(m_curlHandle, task.handle);
+        TRACE_COUNTER("active requests", m_activeTasks);
     }
 }
 
 void UrlClient::curlLoop() {
     // Based on: https://curl.haxx.se/libcurl/c/multi-app.html
 
+    Trace::setThreadName("UrlClient");
     // Loop until the session is destroyed.
     while (m_curlRunning) {
 
@@ -527,6 +670,13 @@ void UrlClient::curlLoop() {
                     response.error = task.curlErrorString;
                 }
 
+                auto& host = m_hosts[task.request.host];
+                if (task.canceled) {
+                    host.stats.active--;
+                } else {
+                    updateHostStats(host, handle, resultCode);
+                }
+
                 // Unset task state, clear content
                 task.clear();
             }
@@ -541,6 +691,7 @@ void UrlClient::curlLoop() {
                 //callback(std::move(response));
             }
             m_activeTasks--;
+            TRACE_COUNTER("active requests", m_activeTasks);
         }
     }
 }
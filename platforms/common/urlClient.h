@@ -4,11 +4,14 @@
 #include "util/asyncWorker.h"
 
 #include <atomic>
+#include <chrono>
+#include <limits>
 #include <list>
 #include <mutex>
 #include <deque>
 #include <string>
 #include <thread>
+#include <unordered_map>
 
 #if defined(_WIN32)
 #include <winsock2.h>
@@ -24,10 +27,33 @@ public:
         uint32_t maxActiveTasks = 20;
         uint32_t connectionTimeoutMs = 3000;
         uint32_t requestTimeoutMs = 30000;
-        uint32_t maxHttpVersion = 1;
+        // HTTP/2 is used for https hosts that support it, allowing requests to be multiplexed
+        uint32_t maxHttpVersion = 2;
+        // max connections per host; additional HTTP/1.x requests would just queue inside curl
+        uint32_t maxHostConnections = 6;
+        // per-host concurrency limit is adjusted (AIMD) between min and max based on measured latency
+        //  and throughput if adaptiveConcurrency is set, otherwise fixed at maxHostTasks
+        bool adaptiveConcurrency = true;
+        uint32_t minHostTasks = 2;
+        uint32_t maxHostTasks = 24;
+        // limit is decreased when time to first byte exceeds this multiple of the baseline RTT
+        float latencyTolerance = 2.5f;
         const char* userAgentString = "tangram";
     };
 
+    // per-host network statistics
+    struct HostStats {
+        float rttMs = 0;  // smoothed time to first byte
+        float minRttMs = 0;  // baseline time to first byte
+        float bytesPerSec = 0;  // smoothed download throughput
+        float limit = 0;  // current concurrency limit
+        uint32_t active = 0;
+        uint32_t pending = 0;
+        uint64_t completed = 0;
+        uint64_t failed = 0;
+        bool multiplexed = false;  // HTTP/2 connection
+    };
+
     UrlClient(Options options);
     ~UrlClient();
 
@@ -38,13 +64,28 @@ public:
     void cancelRequest(RequestId request);
     void cancelAllRequests();
 
+    std::unordered_map<std::string, HostStats> getHostStats();
+
 private:
 
+    using clock = std::chrono::steady_clock;
+
     struct Request {
         std::string url;
         HttpOptions options;
         UrlCallback callback;
         RequestId id;
+        std::string host;
+        // last value returned by options.priority
+        double priority = std::numeric_limits<double>::infinity();
+    };
+
+    struct Host {
+        HostStats stats;
+        clock::time_point lastDecrease;
+        clock::time_point windowStart;
+        size_t windowBytes = 0;
+        float prevBytesPerSec = 0;
     };
 
     class SelfPipe {
@@ -71,6 +112,8 @@ private:
     void curlWakeUp();
 
     void startPendingRequests();
+    void updateHostStats(Host& host, void* handle, int resultCode);
+    Host& getHost(const std::string& name);
 
     Options m_options;
 
@@ -89,7 +132,9 @@ private:
 
     std::deque<Request> m_requests;
 
-    // Synchronize m_tasks and m_requests
+    std::unordered_map<std::string, Host> m_hosts;
+
+    // Synchronize m_tasks, m_requests, and m_hosts
     std::mutex m_requestMutex;
 
     // RequestIds
@@ -166,6 +166,10 @@ void GL::texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset,
                        GLenum format, GLenum type, const GLvoid *pixels) {
     __evas_gl_glapi->glTexSubImage2D(target, level, xoffset, yoffset, width, height, format, type, pixels); }
 
+void GL::compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                              GLint border, GLsizei imageSize, const GLvoid *data) {
+    __evas_gl_glapi->glCompressedTexImage2D(target, level, internalFormat, width, height, border, imageSize, data); }
+
 void GL::generateMipmap(GLenum target) {
     __evas_gl_glapi->glGenerateMipmap(target);
 }
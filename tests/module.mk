@@ -6,11 +6,17 @@ MODULE_BASE = $(MAKE_BASE)
 
 # unit tests
 MODULE_SOURCES = \
+  unit/bufferPoolTests.cpp \
+  unit/contourSourceTests.cpp \
   unit/curlTests.cpp \
   unit/drawRuleTests.cpp \
   unit/dukTests.cpp \
+  unit/elevationManagerTests.cpp \
+  unit/elevationPyramidTests.cpp \
+  unit/featureIndexTests.cpp \
   unit/fileTests.cpp \
   unit/flyToTest.cpp \
+  unit/fontstashTests.cpp \
   unit/jobQueueTests.cpp \
   unit/labelsTests.cpp \
   unit/labelTests.cpp \
@@ -19,17 +25,25 @@ MODULE_SOURCES = \
   unit/mapProjectionTests.cpp \
   unit/meshTests.cpp \
   unit/networkDataSourceTests.cpp \
+  unit/pixelBufferPoolTests.cpp \
+  unit/rasterCacheTests.cpp \
   unit/sceneImportTests.cpp \
   unit/sceneLoaderTests.cpp \
+  unit/sceneSnapshotTests.cpp \
   unit/sceneUpdateTests.cpp \
   unit/stopsTests.cpp \
   unit/styleMixerTests.cpp \
   unit/styleParamTests.cpp \
   unit/styleSortingTests.cpp \
   unit/styleUniformsTests.cpp \
+  unit/terrainDepthRasterizerTests.cpp \
+  unit/textureCompressionTests.cpp \
   unit/textureTests.cpp \
+  unit/tileDataCacheTests.cpp \
   unit/tileIDTests.cpp \
   unit/tileManagerTests.cpp \
+  unit/traceTests.cpp \
+  unit/uploadSchedulerTests.cpp \
   unit/urlTests.cpp \
   unit/yamlFilterTests.cpp \
   unit/yamlUtilTests.cpp
@@ -46,3 +60,4 @@ include $(ADD_MODULE)
 
 # hack until we figure out where to put fontstash.h
 $(OBJDIR)/$(MODULE_BASE)/src/mockPlatform.o: INC_PRIVATE := $(MODULE_BASE)/../../$(STYLUSLABS_DEPS)/nanovgXC/src
+$(OBJDIR)/$(MODULE_BASE)/unit/fontstashTests.o: INC_PRIVATE := $(MODULE_BASE)/../../$(STYLUSLABS_DEPS)/nanovgXC/src
@@ -2,6 +2,14 @@
 
 namespace Tangram {
 
+// bytes of buffer data passed to GL, for tests checking upload budgets
+size_t glMockUploadBytes = 0;
+// buffer object calls, for tests checking buffer churn
+size_t glMockGenBuffers = 0;
+size_t glMockDeleteBuffers = 0;
+size_t glMockBufferData = 0;
+static GLuint glMockNextBuffer = 1;
+
 GLenum GL::getError() {
     return 0;
 }
@@ -92,12 +100,22 @@ void GL::getShaderiv(GLuint shader, GLenum pname, GLint *params) {
 void GL::bindBuffer(GLenum target, GLuint buffer) {
 }
 void GL::deleteBuffers(GLsizei n, const GLuint *buffers) {
+    for (GLsizei i = 0; i < n; i++) {
+        if (buffers[i]) { glMockDeleteBuffers++; }
+    }
 }
 void GL::genBuffers(GLsizei n, GLuint *buffers) {
+    for (GLsizei i = 0; i < n; i++) {
+        buffers[i] = glMockNextBuffer++;
+    }
+    glMockGenBuffers += n;
 }
 void GL::bufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    if (data) { glMockUploadBytes += size; }
+    glMockBufferData++;
 }
 void GL::bufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    if (data) { glMockUploadBytes += size; }
 }
 void GL::readPixels(GLint x, GLint y, GLsizei width, GLsizei height,
                     GLenum format, GLenum type, GLvoid* pixels) {
@@ -120,6 +138,9 @@ void GL::texImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei wi
 void GL::texSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
                        GLenum format, GLenum type, const GLvoid *pixels) {
 }
+void GL::compressedTexImage2D(GLenum target, GLint level, GLenum internalFormat, GLsizei width, GLsizei height,
+                              GLint border, GLsizei imageSize, const GLvoid *data) {
+}
 void GL::generateMipmap(GLenum target) {
 }
 
@@ -0,0 +1,157 @@
+#include "catch.hpp"
+
+#include "gl/bufferPool.h"
+#include "gl/mesh.h"
+#include "gl/renderState.h"
+
+#include <memory>
+#include <vector>
+
+namespace Tangram {
+extern size_t glMockGenBuffers;
+extern size_t glMockDeleteBuffers;
+extern size_t glMockBufferData;
+}
+
+using namespace Tangram;
+
+struct PoolVertex {
+    float x, y, z;
+    uint32_t color;
+};
+
+static std::shared_ptr<VertexLayout> poolLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+    {"a_position", 3, GL_FLOAT, false, 0},
+    {"a_color", 4, GL_UNSIGNED_BYTE, true, 0},
+}));
+
+struct PoolMesh : public Mesh<PoolVertex> {
+    using Base = Mesh<PoolVertex>;
+    using Base::Base;
+
+    void upload(RenderState& rs) { MeshBase::upload(rs); }
+    const BufferPool::Allocation& vertexAlloc() const { return m_vertexAlloc; }
+    const BufferPool::Allocation& indexAlloc() const { return m_indexAlloc; }
+};
+
+static std::unique_ptr<PoolMesh> newPoolMesh(size_t _nVertices) {
+    auto mesh = std::make_unique<PoolMesh>(poolLayout, GL_TRIANGLES);
+    MeshData<PoolVertex> meshData;
+    meshData.vertices.resize(_nVertices);
+    meshData.indices.resize(_nVertices);
+    meshData.offsets.emplace_back(_nVertices, _nVertices);
+    mesh->compile(meshData);
+    return mesh;
+}
+
+static void resetCounters() {
+    glMockGenBuffers = 0;
+    glMockDeleteBuffers = 0;
+    glMockBufferData = 0;
+}
+
+TEST_CASE("Static meshes share pooled buffers", "[Core][BufferPool]") {
+    RenderState rs;
+    resetCounters();
+
+    std::vector<std::unique_ptr<PoolMesh>> meshes;
+    for (int i = 0; i < 200; i++) {
+        meshes.push_back(newPoolMesh(100));
+        meshes.back()->upload(rs);
+    }
+
+    // one vertex and one index block
+    REQUIRE(glMockGenBuffers == 2);
+    REQUIRE(glMockBufferData == 2);
+    REQUIRE(rs.bufferPool.stats().liveAllocations == 400);
+
+    // ranges do not overlap
+    for (size_t i = 1; i < meshes.size(); i++) {
+        auto& a = meshes[i-1]->vertexAlloc();
+        auto& b = meshes[i]->vertexAlloc();
+        REQUIRE(a.buffer == b.buffer);
+        REQUIRE(a.offset + a.size <= b.offset);
+        REQUIRE(meshes[i]->indexAlloc().buffer != a.buffer);
+    }
+
+    meshes.clear();
+    REQUIRE(glMockDeleteBuffers == 0);
+
+    for (uint32_t i = 0; i < BufferPool::FRAME_DELAY; i++) { rs.flushResourceDeletion(); }
+
+    auto stats = rs.bufferPool.stats();
+    REQUIRE(stats.liveAllocations == 0);
+    REQUIRE(stats.usedBytes == 0);
+    // empty blocks are kept for reuse
+    REQUIRE(stats.blocks == 2);
+    REQUIRE(glMockDeleteBuffers == 0);
+
+    // panning: new meshes reuse blocks without creating buffers
+    resetCounters();
+    for (int i = 0; i < 200; i++) {
+        meshes.push_back(newPoolMesh(100));
+        meshes.back()->upload(rs);
+    }
+    REQUIRE(glMockGenBuffers == 0);
+    REQUIRE(glMockBufferData == 0);
+}
+
+TEST_CASE("Unpooled meshes create own buffers", "[Core][BufferPool]") {
+    RenderState rs;
+    rs.bufferPool.setEnabled(false);
+    resetCounters();
+
+    std::vector<std::unique_ptr<PoolMesh>> meshes;
+    for (int i = 0; i < 200; i++) {
+        meshes.push_back(newPoolMesh(100));
+        meshes.back()->upload(rs);
+        REQUIRE(!meshes.back()->vertexAlloc());
+    }
+    REQUIRE(glMockGenBuffers == 400);
+
+    meshes.clear();
+    rs.flushResourceDeletion();
+    REQUIRE(glMockDeleteBuffers == 400);
+}
+
+TEST_CASE("Released ranges are reused after frame delay and merged", "[Core][BufferPool]") {
+    RenderState rs;
+    BufferPool pool;
+    pool.setBlockSize(1024);
+    std::vector<char> data(1024);
+
+    auto a = pool.allocate(rs, GL_ARRAY_BUFFER, 16, data.data(), 256);
+    auto b = pool.allocate(rs, GL_ARRAY_BUFFER, 16, data.data(), 256);
+    auto c = pool.allocate(rs, GL_ARRAY_BUFFER, 16, data.data(), 256);
+    REQUIRE(a.buffer == c.buffer);
+    REQUIRE(b.offset == 256);
+
+    pool.release(b);
+    pool.release(a);
+
+    // released ranges may still be in use by GPU
+    pool.flush(rs);
+    auto d = pool.allocate(rs, GL_ARRAY_BUFFER, 16, data.data(), 512);
+    REQUIRE(d.buffer != a.buffer);
+
+    for (uint32_t i = 1; i < BufferPool::FRAME_DELAY; i++) { pool.flush(rs); }
+
+    // a and b merged into one free range
+    auto e = pool.allocate(rs, GL_ARRAY_BUFFER, 16, data.data(), 512);
+    REQUIRE(e.buffer == a.buffer);
+    REQUIRE(e.offset == 0);
+
+    // different key never shares a block
+    auto f = pool.allocate(rs, GL_ARRAY_BUFFER, 20, data.data(), 64);
+    REQUIRE(f.buffer != a.buffer);
+    REQUIRE(f.buffer != d.buffer);
+
+    // empty extra block is deleted
+    pool.release(d);
+    for (uint32_t i = 0; i < BufferPool::FRAME_DELAY; i++) { pool.flush(rs); }
+    auto stats = pool.stats();
+    REQUIRE(stats.blocks == 2);
+    REQUIRE(stats.buffersDeleted == 1);
+
+    pool.dispose();
+}
@@ -0,0 +1,150 @@
+#include "catch.hpp"
+
+#include "data/contourSource.h"
+#include "data/propertyItem.h"
+#include "data/tileData.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Tangram;
+
+static Layer buildLayer(const std::vector<float>& _elev, int _w, int _h, float _interval, int _index = 5) {
+    Layer layer("");
+    ContourSource::buildContours(_elev.data(), _w, _h, _interval, _index, 0, layer);
+    return layer;
+}
+
+static const Feature* findLevel(const Layer& _layer, double _elev) {
+    for (auto& feature : _layer.features) {
+        if (feature.props.getNumber("elevation") == _elev) { return &feature; }
+    }
+    return nullptr;
+}
+
+TEST_CASE("Contours of a slope cross the tile from edge to edge", "[ContourSource]") {
+    // elevation increases to the east: 0 .. 310 m
+    int w = 32, h = 16;
+    std::vector<float> elev(w*h);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) { elev[y*w + x] = 10.0f*x; }
+    }
+    Layer layer = buildLayer(elev, w, h, 50);
+
+    REQUIRE(layer.features.size() == 6);
+    for (auto& feature : layer.features) {
+        double level = feature.props.getNumber("elevation");
+        CHECK(feature.geometryType == GeometryType::lines);
+        CHECK(feature.props.contains("index") == (std::fmod(level, 250) == 0));
+        REQUIRE(feature.lines.size() == 1);
+
+        // single open line across tile, running south so that higher ground (east) is on the left, at x
+        //  where elevation == level
+        auto& line = feature.lines[0];
+        REQUIRE(line.size() == size_t(h + 2));
+        CHECK(line.front().y == Approx(1.0f));
+        CHECK(line.back().y == Approx(0.0f));
+        float x = (level/10 + 0.5f)/w;
+        for (auto& p : line) { CHECK(p.x == Approx(x)); }
+    }
+}
+
+TEST_CASE("Contours of a peak are closed loops around the summit", "[ContourSource]") {
+    int w = 64, h = 64;
+    std::vector<float> elev(w*h);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            float dx = x - 31.5f, dy = y - 31.5f;
+            elev[y*w + x] = 1000.0f - 30.0f*std::sqrt(dx*dx + dy*dy);
+        }
+    }
+    Layer layer = buildLayer(elev, w, h, 100);
+
+    for (double level : {500.0, 700.0, 900.0}) {
+        const Feature* feature = findLevel(layer, level);
+        REQUIRE(feature);
+        REQUIRE(feature->lines.size() == 1);
+        auto& line = feature->lines[0];
+        REQUIRE(line.size() > 8);
+        CHECK(line.front() == line.back());
+
+        // radius matches level; counter-clockwise since higher ground is on the left
+        float r = (1000.0f - level)/30.0f/w;
+        double area = 0;
+        for (size_t i = 0; i + 1 < line.size(); i++) {
+            glm::vec2 d = line[i] - glm::vec2(0.5f);
+            CHECK(std::sqrt(d.x*d.x + d.y*d.y) == Approx(r).epsilon(0.05));
+            area += line[i].x*line[i+1].y - line[i+1].x*line[i].y;
+        }
+        CHECK(area > 0);
+    }
+    // no levels above summit
+    CHECK(findLevel(layer, 1000.0) == nullptr);
+}
+
+TEST_CASE("Contour saddles and flat tiles", "[ContourSource]") {
+    // 2x2 saddle: high corners at SW and NE
+    std::vector<float> saddle = { 10, 0, 0, 10 };
+    Layer layer = buildLayer(saddle, 2, 2, 4, 1);
+    REQUIRE(layer.features.size() == 2);
+    for (auto& feature : layer.features) {
+        // center average (5) is above 4 and below 8, so lines separate 4 m contour into two pieces around low
+        //  corners, and 8 m contour into two pieces around high corners
+        CHECK(feature.lines.size() == 2);
+        for (auto& line : feature.lines) { CHECK(line.size() >= 2); }
+    }
+
+    std::vector<float> flat(16*16, 120.0f);
+    CHECK(buildLayer(flat, 16, 16, 50).features.empty());
+
+    // no contours when interval is invalid
+    CHECK(buildLayer(saddle, 2, 2, 0).features.empty());
+}
+
+TEST_CASE("Contours of adjacent tiles meet when border is read from neighbors", "[ContourSource]") {
+    // smooth terrain spanning two tiles side by side, with contours crossing their shared edge obliquely
+    int w = 32, h = 32;
+    auto elevAt = [](int gx, int gy) { return 7.0f*gx + 3.0f*gy + 0.02f*gx*gy; };
+
+    // (w + 2) x (h + 2) grid of tile _tx with border from neighbors
+    auto bordered = [&](int _tx) {
+        std::vector<float> grid((w + 2)*(h + 2));
+        for (int j = 0; j < h + 2; j++) {
+            for (int i = 0; i < w + 2; i++) { grid[j*(w + 2) + i] = elevAt(_tx*w + i - 1, j - 1); }
+        }
+        return grid;
+    };
+
+    Layer west(""), east("");
+    ContourSource::buildContoursBordered(bordered(0).data(), w, h, 20, 5, 0, west);
+    ContourSource::buildContoursBordered(bordered(1).data(), w, h, 20, 5, 0, east);
+
+    int crossing = 0;
+    for (auto& feature : west.features) {
+        double level = feature.props.getNumber("elevation");
+        const Feature* other = findLevel(east, level);
+        for (auto& line : feature.lines) {
+            for (auto& p : line) {
+                // clipped to tile bounds
+                CHECK(p.x >= 0.0f);
+                CHECK(p.x <= 1.0f);
+                CHECK(p.y >= 0.0f);
+                CHECK(p.y <= 1.0f);
+            }
+            for (glm::vec2 end : {line.front(), line.back()}) {
+                if (end.x != 1.0f || end.y <= 0.0f || end.y >= 1.0f) { continue; }
+                // same point at east tile's west edge
+                REQUIRE(other);
+                bool found = false;
+                for (auto& l : other->lines) {
+                    for (glm::vec2 p : {l.front(), l.back()}) {
+                        found |= p.x == 0.0f && std::abs(p.y - end.y) < 1e-5f;
+                    }
+                }
+                CHECK(found);
+                crossing++;
+            }
+        }
+    }
+    CHECK(crossing > 3);
+}
@@ -0,0 +1,118 @@
+#include "catch.hpp"
+
+#include "util/elevationManager.h"
+#include "data/rasterCache.h"
+#include "gl/texture.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Tangram;
+
+static void checkBatchLerp(const Texture& _tex) {
+    // include points outside pixel centers at edges, which are clamped
+    std::vector<glm::vec2> pos;
+    for (int i = 0; i < 203; i++) {
+        pos.emplace_back(std::fmod(i*0.137f, 1.0f), std::fmod(i*0.291f + 0.003f, 1.0f));
+    }
+    pos.emplace_back(0.0f, 0.0f);
+    pos.emplace_back(1.0f, 1.0f);
+
+    std::vector<float> elev(pos.size());
+    std::vector<glm::vec2> grad(pos.size());
+    ElevationManager::elevationLerp(_tex, pos.data(), pos.size(), elev.data(), grad.data());
+
+    for (size_t i = 0; i < pos.size(); i++) {
+        glm::vec2 expectedGrad;
+        double expected = ElevationManager::elevationLerp(_tex, pos[i], &expectedGrad);
+        CHECK(elev[i] == Approx(expected).margin(0.01));
+        CHECK(grad[i].x == Approx(expectedGrad.x).margin(0.5));
+        CHECK(grad[i].y == Approx(expectedGrad.y).margin(0.5));
+    }
+}
+
+TEST_CASE("Batch elevation interpolation matches scalar for float DEM", "[ElevationManager]") {
+    int w = 37, h = 23;
+    std::vector<float> data(w*h);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) { data[y*w + x] = 1000*std::sin(0.3f*x) + 20.0f*y - 100; }
+    }
+    TextureOptions options;
+    options.pixelFormat = PixelFormat::FLOAT;
+    Texture tex(options, false);
+    tex.setPixelData(w, h, 4, reinterpret_cast<const GLubyte*>(data.data()), data.size()*4);
+    checkBatchLerp(tex);
+}
+
+TEST_CASE("Batch elevation interpolation matches scalar for terrarium DEM", "[ElevationManager]") {
+    int w = 32, h = 32;
+    std::vector<GLubyte> data(w*h*4, 255);
+    for (int i = 0; i < w*h; i++) {
+        float v = 32768.0f + 2500*std::cos(0.05f*i) + 0.5f*(i % 7);
+        int iv = int(v);
+        data[4*i] = GLubyte(iv/256);
+        data[4*i+1] = GLubyte(iv%256);
+        data[4*i+2] = GLubyte((v - iv)*256);
+    }
+    Texture tex(TextureOptions(), false);
+    tex.setPixelData(w, h, 4, data.data(), data.size());
+    checkBatchLerp(tex);
+
+    // empty batch is a no-op
+    ElevationManager::elevationLerp(tex, nullptr, 0, nullptr);
+}
+
+static std::unique_ptr<Texture> planeDem(float _base, float _dx, float _dy) {
+    int w = 16, h = 16;
+    std::vector<float> data(w*h);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) { data[y*w + x] = _base + _dx*x + _dy*y; }
+    }
+    TextureOptions options;
+    options.pixelFormat = PixelFormat::FLOAT;
+    auto tex = std::make_unique<Texture>(options, false);
+    tex->setPixelData(w, h, 4, reinterpret_cast<const GLubyte*>(data.data()), data.size()*4);
+    return tex;
+}
+
+TEST_CASE("Batch elevation query matches scalar with DEMs at mixed zooms", "[ElevationManager]") {
+    const int maxZoom = 12;
+    TileID coarseId(600, 700, 10);
+    // finer DEM loaded for one z12 tile inside coarse DEM, but not the first one in query order
+    TileID fineId(4*600 + 2, 4*700 + 1, 12);
+    auto dems = std::make_shared<RasterCache>();
+    auto coarse = dems->getOrDecode(coarseId, [](){ return planeDem(100, 3, 7); });
+    auto fine = dems->getOrDecode(fineId, [](){ return planeDem(500, -2, 5); });
+
+    // grid over coarse DEM tile, plus points in tile to the east which has no DEM
+    std::vector<ProjectedMeters> pos;
+    double scale = MapProjection::metersPerTileAtZoom(coarseId.z);
+    ProjectedMeters origin = MapProjection::tileSouthWestCorner(coarseId);
+    for (int j = 0; j < 32; j++) {
+        for (int i = 0; i < 36; i++) { pos.push_back(origin + scale*glm::dvec2((i + 0.5)/32, (j + 0.5)/32)); }
+    }
+
+    std::vector<float> elev(pos.size());
+    std::vector<glm::vec2> grad(pos.size());
+    std::unique_ptr<bool[]> ok(new bool[pos.size()]);
+    size_t found = ElevationManager::getElevations(*dems, maxZoom, pos.data(), pos.size(), elev.data(),
+                                                   grad.data(), ok.get());
+    REQUIRE(found == 32*32);
+
+    size_t numFine = 0;
+    for (size_t i = 0; i < pos.size(); i++) {
+        // as getElevation() for a point without previous tile
+        TileID demId = NOT_A_TILE;
+        auto dem = dems->find(pos[i], demId);
+        REQUIRE(ok[i] == bool(dem));
+        if (!dem) {
+            CHECK(elev[i] == 0);
+            continue;
+        }
+        if (demId == fineId) { numFine++; }
+        double expected = ElevationManager::elevationLerp(*dem, demId, pos[i]);
+        CHECK(elev[i] == Approx(expected).margin(0.01));
+    }
+    // 8x8 grid points in the z12 tile
+    REQUIRE(numFine == 64);
+}
@@ -0,0 +1,57 @@
+#include "catch.hpp"
+
+#include "util/elevationPyramid.h"
+
+#include <vector>
+
+using namespace Tangram;
+
+TEST_CASE("ElevationPyramid min/max of float DEM", "[ElevationPyramid]") {
+    // 32x32 ramp increasing to east, with a peak in the north-west (top rows of texture) corner
+    int w = 32, h = 32;
+    std::vector<float> elev(w*h);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) { elev[y*w + x] = float(x); }
+    }
+    elev[30*w + 1] = 1000;
+
+    ElevationPyramid pyramid(elev.data(), w, h);
+    CHECK(pyramid.minMax().x == 0);
+    CHECK(pyramid.minMax().y == 1000);
+
+    // east half, south half; one pixel border is included
+    auto east = pyramid.minMax(glm::vec2(0.5f, 0.0f), glm::vec2(1.0f, 0.5f));
+    CHECK(east.x <= 15);
+    CHECK(east.x >= 8);
+    CHECK(east.y == 31);
+
+    // north-west and south-east child tiles of tile
+    TileID tile(10, 20, 5);
+    auto nw = pyramid.minMax(tile, TileID(20, 40, 6));
+    CHECK(nw.x == 0);
+    CHECK(nw.y == 1000);
+    auto se = pyramid.minMax(tile, TileID(21, 41, 6));
+    CHECK(se.y == 31);
+    CHECK(se.x >= 8);
+
+    // tile itself
+    CHECK(pyramid.minMax(tile, tile).y == 1000);
+}
+
+TEST_CASE("ElevationPyramid decodes terrarium RGB", "[ElevationPyramid]") {
+    int w = 5, h = 3;  // not a multiple of cell size
+    std::vector<uint8_t> rgba(w*h*4, 0);
+    for (int i = 0; i < w*h; i++) {
+        float e = 100.0f*i;
+        float v = e + 32768.0f;
+        rgba[4*i] = uint8_t(int(v)/256);
+        rgba[4*i+1] = uint8_t(int(v)%256);
+        rgba[4*i+2] = 0;
+        rgba[4*i+3] = 255;
+    }
+
+    ElevationPyramid pyramid(rgba.data(), w, h);
+    CHECK(pyramid.minMax().x == Approx(0));
+    CHECK(pyramid.minMax().y == Approx(100.0f*(w*h - 1)));
+    CHECK(pyramid.memoryUsage() > sizeof(ElevationPyramid));
+}
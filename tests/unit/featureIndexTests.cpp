@@ -0,0 +1,270 @@
+#include "catch.hpp"
+
+#include "data/propertyItem.h"
+#include "selection/featureIndex.h"
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+
+using namespace Tangram;
+
+static Feature polygonFeature(std::vector<Line> _rings) {
+    Feature feature;
+    feature.geometryType = GeometryType::polygons;
+    feature.polygons.push_back(std::move(_rings));
+    return feature;
+}
+
+static Feature lineFeature(Line _line) {
+    Feature feature;
+    feature.geometryType = GeometryType::lines;
+    feature.lines.push_back(std::move(_line));
+    return feature;
+}
+
+static Feature pointFeature(Point _point) {
+    Feature feature;
+    feature.geometryType = GeometryType::points;
+    feature.points.push_back(_point);
+    return feature;
+}
+
+static Line square(glm::vec2 _min, glm::vec2 _max) {
+    return { _min, {_max.x, _min.y}, _max, {_min.x, _max.y} };
+}
+
+TEST_CASE("FeatureIndex picks polygons containing the position", "[FeatureIndex]") {
+    FeatureIndex index;
+    // square with a hole
+    index.add(polygonFeature({ square({.1f, .1f}, {.6f, .6f}), square({.3f, .3f}, {.4f, .4f}) }), 1, 0);
+    index.build();
+
+    REQUIRE(index.pick({.2f, .2f}, 0, 0) == 1);
+    REQUIRE(index.pick({.35f, .35f}, 0, 0) == 0);
+    REQUIRE(index.pick({.7f, .2f}, 0, 0) == 0);
+    // edge within pick radius
+    REQUIRE(index.pick({.65f, .2f}, .06f, 0) == 1);
+}
+
+TEST_CASE("FeatureIndex applies line width and pick radius", "[FeatureIndex]") {
+    FeatureIndex index;
+    index.add(lineFeature({{.1f, .5f}, {.9f, .5f}}), 1, 0, .02f);
+    index.add(lineFeature({{.5f, .1f}, {.5f, .3f}}), 2, 0, 0, 4.f);
+    index.build();
+
+    REQUIRE(index.pick({.5f, .51f}, 0, 0) == 1);
+    REQUIRE(index.pick({.5f, .55f}, 0, 0) == 0);
+    REQUIRE(index.pick({.5f, .55f}, .04f, 0) == 1);
+
+    // 4 pixel half width at 1/256 tile units per pixel
+    REQUIRE(index.pick({.51f, .2f}, 0, 1.f/256) == 2);
+    REQUIRE(index.pick({.51f, .2f}, 0, 1.f/4096) == 0);
+}
+
+TEST_CASE("FeatureIndex prefers nearest, then topmost feature", "[FeatureIndex]") {
+    FeatureIndex index;
+    index.add(pointFeature({.5f, .5f}), 1, 0);
+    index.add(pointFeature({.52f, .5f}), 2, 0);
+    index.add(polygonFeature({ square({.2f, .2f}, {.8f, .8f}) }), 3, 1);
+    index.add(polygonFeature({ square({.2f, .2f}, {.8f, .8f}) }), 4, 2);
+    index.add(polygonFeature({ square({.2f, .2f}, {.8f, .8f}) }), 5, 2);
+    index.build();
+
+    // inside polygons: highest order, later feature on ties
+    REQUIRE(index.pick({.5f, .5f}, .1f, 0) == 5);
+
+    FeatureIndex points;
+    points.add(pointFeature({.5f, .5f}), 1, 0);
+    points.add(pointFeature({.52f, .5f}), 2, 0);
+    points.build();
+    float distance = -1;
+    REQUIRE(points.pick({.515f, .5f}, .1f, 0, &distance) == 2);
+    REQUIRE(distance == Approx(.005f));
+    REQUIRE(points.pick({.2f, .2f}, .1f, 0) == 0);
+}
+
+TEST_CASE("FeatureIndex grid lookup matches linear search", "[FeatureIndex]") {
+    std::srand(1);
+    auto rnd = []() { return float(std::rand()) / RAND_MAX; };
+
+    FeatureIndex index;
+    std::vector<FeatureIndex> single(200);
+
+    for (uint32_t i = 0; i < single.size(); i++) {
+        glm::vec2 p(rnd() * 1.2f - .1f, rnd() * 1.2f - .1f);
+        Feature feature;
+        switch (i % 3) {
+        case 0: feature = pointFeature(p); break;
+        case 1: feature = lineFeature({p, p + glm::vec2(rnd() * .2f, rnd() * .2f - .1f)}); break;
+        default: feature = polygonFeature({ square(p, p + glm::vec2(rnd() * .1f, rnd() * .1f)) }); break;
+        }
+        // distinct orders so result does not depend on insertion order
+        index.add(feature, i + 1, i, .005f, 1.f);
+        single[i].add(feature, i + 1, i, .005f, 1.f);
+        single[i].build();
+    }
+    index.build();
+
+    for (int q = 0; q < 500; q++) {
+        glm::vec2 pos(rnd(), rnd());
+        float radius = rnd() * .05f;
+
+        uint32_t expected = 0;
+        float minDistance = std::numeric_limits<float>::max();
+        for (uint32_t i = 0; i < single.size(); i++) {
+            float distance = 0;
+            if (!single[i].pick(pos, radius, 1.f/256, &distance)) { continue; }
+            if (distance <= minDistance) {
+                minDistance = distance;
+                expected = i + 1;
+            }
+        }
+        REQUIRE(index.pick(pos, radius, 1.f/256) == expected);
+    }
+}
+
+TEST_CASE("FeatureIndex matches point size", "[FeatureIndex]") {
+    FeatureIndex index;
+    // 16 px point at 256 px per tile
+    index.add(pointFeature({.5f, .5f}), 1, 0, 0, 8.f);
+    index.build();
+
+    REQUIRE(index.pick({.5f + 7.f/256, .5f}, 0, 1.f/256) == 1);
+    REQUIRE(index.pick({.5f + 9.f/256, .5f}, 0, 1.f/256) == 0);
+    REQUIRE(index.pick({.5f + 9.f/256, .5f}, 2.f/256, 1.f/256) == 1);
+}
+
+// Reference for the selection buffer: features drawn in order into a tile of SIZE pixels, then the color
+//  nearest to the pick position read as in SelectionQuery::process, but within a circle of _radius (the
+//  selection buffer read also reaches the corners of the enclosing square)
+struct SelectionRaster {
+    static constexpr int SIZE = 256;
+    std::vector<uint32_t> pixels = std::vector<uint32_t>(SIZE * SIZE, 0);
+
+    template<typename F>
+    void draw(uint32_t _color, F _covers) {
+        for (int y = 0; y < SIZE; y++) {
+            for (int x = 0; x < SIZE; x++) {
+                if (_covers(glm::vec2(x + .5f, y + .5f) / float(SIZE))) { pixels[y * SIZE + x] = _color; }
+            }
+        }
+    }
+
+    uint32_t read(glm::vec2 _pos, float _radius) const {
+        glm::vec2 p = _pos * float(SIZE);
+        uint32_t color = 0;
+        float minDistance = _radius;
+        for (int y = int(std::floor(p.y - _radius)); y < int(std::ceil(p.y + _radius)); y++) {
+            for (int x = int(std::floor(p.x - _radius)); x < int(std::ceil(p.x + _radius)); x++) {
+                if (x < 0 || y < 0 || x >= SIZE || y >= SIZE) { continue; }
+                uint32_t sample = pixels[y * SIZE + x];
+                float distance = glm::distance(glm::vec2(x + .5f, y + .5f), p);
+                if (sample != 0 && distance < minDistance) {
+                    color = sample;
+                    minDistance = distance;
+                }
+            }
+        }
+        return color;
+    }
+};
+
+static float lineDistance(const Line& _line, glm::vec2 _p) {
+    float d = std::numeric_limits<float>::max();
+    for (size_t i = 1; i < _line.size(); i++) {
+        glm::vec2 a = _line[i-1], ab = _line[i] - a;
+        float t = glm::clamp(glm::dot(_p - a, ab) / glm::dot(ab, ab), 0.f, 1.f);
+        d = std::min(d, glm::distance(_p, a + t * ab));
+    }
+    return d;
+}
+
+static bool contains(const Line& _ring, glm::vec2 _p) {
+    bool inside = false;
+    for (size_t i = 0, j = _ring.size() - 1; i < _ring.size(); j = i++) {
+        glm::vec2 a = _ring[j], b = _ring[i];
+        if (((a.y > _p.y) != (b.y > _p.y)) && (_p.x < (b.x - a.x) * (_p.y - a.y) / (b.y - a.y) + a.x)) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+TEST_CASE("FeatureIndex picks agree with the selection buffer", "[FeatureIndex]") {
+    const float pixel = 1.f / SelectionRaster::SIZE;
+    const float radius = 3.f;
+
+    std::srand(2);
+    auto rnd = []() { return float(std::rand()) / RAND_MAX; };
+
+    FeatureIndex index;
+    std::vector<FeatureIndex> single;
+    struct Drawn { uint32_t order; uint32_t color; std::function<bool(glm::vec2)> covers; };
+    std::vector<Drawn> drawn;
+
+    for (uint32_t i = 0; i < 60; i++) {
+        glm::vec2 p(rnd(), rnd());
+        uint32_t color = i + 1, order = std::rand() % 4;
+        Feature feature;
+        float halfWidth = 0, pixelHalfWidth = 0;
+        if (i % 2) {
+            Line ring = square(p, p + glm::vec2(rnd() * .2f, rnd() * .2f));
+            feature = polygonFeature({ring});
+            // every third polygon with an outline
+            if (i % 3 == 0) { pixelHalfWidth = 2.f; }
+            Line outline = ring;
+            outline.push_back(ring.front());
+            float extent = pixelHalfWidth * pixel;
+            drawn.push_back({order, color, [=](glm::vec2 q) {
+                return contains(ring, q) || (extent > 0 && lineDistance(outline, q) <= extent);
+            }});
+        } else {
+            glm::vec2 p1 = p + glm::vec2(rnd() - .5f, rnd() - .5f) * .3f;
+            Line line = {p, p1, p1 + glm::vec2(rnd() - .5f, rnd() - .5f) * .3f};
+            feature = lineFeature(line);
+            // width in tile units (meters) plus pixels (width and outline)
+            halfWidth = rnd() * 2 * pixel;
+            pixelHalfWidth = 1.f + rnd() * 5;
+            float extent = halfWidth + pixelHalfWidth * pixel;
+            drawn.push_back({order, color, [=](glm::vec2 q) { return lineDistance(line, q) <= extent; }});
+        }
+        index.add(feature, color, order, halfWidth, pixelHalfWidth);
+        single.emplace_back();
+        single.back().add(feature, color, order, halfWidth, pixelHalfWidth);
+        single.back().build();
+    }
+    index.build();
+
+    // draw order: order, then build order
+    std::stable_sort(drawn.begin(), drawn.end(), [](auto& a, auto& b) { return a.order < b.order; });
+    SelectionRaster raster;
+    for (auto& d : drawn) { raster.draw(d.color, d.covers); }
+
+    auto distanceTo = [&](uint32_t _color, glm::vec2 _pos) {
+        float distance = radius * pixel;
+        if (_color) { single[_color - 1].pick(_pos, radius * pixel, pixel, &distance); }
+        return distance;
+    };
+
+    int hits = 0, mismatches = 0;
+    const int numQueries = 2000;
+    for (int q = 0; q < numQueries; q++) {
+        glm::vec2 pos(rnd(), rnd());
+        uint32_t cpu = index.pick(pos, radius * pixel, pixel);
+        uint32_t gpu = raster.read(pos, radius);
+        if (cpu) { hits++; }
+        if (cpu == gpu) { continue; }
+        mismatches++;
+        // only where pixel sampling makes the nearest feature ambiguous: the edge of the pick radius, or two
+        //  features at nearly the same distance
+        REQUIRE(std::abs(distanceTo(cpu, pos) - distanceTo(gpu, pos)) <= 1.5f * pixel);
+    }
+    REQUIRE(hits > numQueries / 2);
+    REQUIRE(mismatches < numQueries / 20);
+}
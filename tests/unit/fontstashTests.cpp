@@ -0,0 +1,213 @@
+#include "catch.hpp"
+
+#include "fontstash.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define TEST_FONT "res/fonts/NotoSans-Regular.ttf"
+
+// same setup as FontContext, which uses one GPU texture per block of atlas rows
+static const int blockSize = 512;
+static const int atlasFontPx = 32;
+
+struct AtlasGlyph {
+    bool ok = false;
+    int x = 0, y = 0;  // atlas pixel coords of quad origin
+};
+
+static std::string utf8(unsigned int cp) {
+    std::string s;
+    if (cp < 0x80) {
+        s += char(cp);
+    } else if (cp < 0x800) {
+        s += char(0xC0 | (cp >> 6));
+        s += char(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        s += char(0xE0 | (cp >> 12));
+        s += char(0x80 | ((cp >> 6) & 0x3F));
+        s += char(0x80 | (cp & 0x3F));
+    } else {
+        s += char(0xF0 | (cp >> 18));
+        s += char(0x80 | ((cp >> 12) & 0x3F));
+        s += char(0x80 | ((cp >> 6) & 0x3F));
+        s += char(0x80 | (cp & 0x3F));
+    }
+    return s;
+}
+
+static FONScontext* createStash(int& _font) {
+    FONSparams params;
+    memset(&params, 0, sizeof(FONSparams));
+    params.flags = FONS_SDF | FONS_ZERO_TOPLEFT;
+    params.sdfPadding = 12;
+    params.sdfPixelDist = 128.0f/12;
+    params.atlasBlockHeight = blockSize;
+    params.notDefCodePt = 0xFE56;
+    FONScontext* fons = fonsCreateInternal(&params);
+    fonsResetAtlas(fons, blockSize, blockSize, atlasFontPx);
+    _font = fonsAddFont(fons, "default", TEST_FONT);
+    return fons;
+}
+
+// render glyph into atlas (if not already present) and return its position
+static AtlasGlyph getGlyph(FONScontext* _fons, int _font, unsigned int _cp) {
+    FONSstate state;
+    FONStextIter iter;
+    FONSquad q;
+    AtlasGlyph glyph;
+    std::string str = utf8(_cp);
+    fonsInitState(_fons, &state);
+    fonsSetFont(&state, _font);
+    fonsSetSize(&state, atlasFontPx);
+    fonsTextIterInit(&state, &iter, 0, 0, str.c_str(), str.c_str() + str.size(), FONS_GLYPH_BITMAP_REQUIRED);
+    if (!fonsTextIterNext(&state, &iter, &q) || iter.prevGlyphIndex == -1) { return glyph; }
+    int iw, ih;
+    fonsGetAtlasSize(_fons, &iw, &ih, NULL);
+    glyph.ok = true;
+    glyph.x = int(q.s0 * iw + 0.5f);
+    glyph.y = int(q.t0 * ih + 0.5f);
+    return glyph;
+}
+
+// Latin, Greek, Cyrillic - plenty of distinct glyphs to fill a block
+static std::vector<unsigned int> testCodepoints() {
+    std::vector<unsigned int> cps;
+    for (unsigned int cp = 0x0021; cp < 0x007F; cp++) { cps.push_back(cp); }
+    for (unsigned int cp = 0x00A1; cp < 0x0100; cp++) { if (cp != 0x00AD) { cps.push_back(cp); } }
+    for (unsigned int cp = 0x0100; cp < 0x0180; cp++) { cps.push_back(cp); }
+    for (unsigned int cp = 0x0391; cp < 0x03CA; cp++) { if (cp != 0x03A2) { cps.push_back(cp); } }
+    for (unsigned int cp = 0x0410; cp < 0x0450; cp++) { cps.push_back(cp); }
+    return cps;
+}
+
+// fill rows [y0, y0 + blockSize) starting from _cps[_start]; returns index of first glyph that didn't fit
+static size_t fillBlock(FONScontext* _fons, int _font, const std::vector<unsigned int>& _cps, size_t _start,
+                        std::vector<AtlasGlyph>& _glyphs) {
+    size_t ii = _start;
+    for (; ii < _cps.size(); ii++) {
+        AtlasGlyph glyph = getGlyph(_fons, _font, _cps[ii]);
+        if (!glyph.ok) { break; }
+        _glyphs.push_back(glyph);
+    }
+    return ii;
+}
+
+// same as FontContext::addTexture when no texture can be reused
+static void expandAtlas(FONScontext* _fons) {
+    int iw, ih;
+    fonsGetAtlasSize(_fons, &iw, &ih, NULL);
+    fonsExpandAtlas(_fons, iw, ih + blockSize);
+    fonsResetAtlasRows(_fons, ih, ih + blockSize);
+}
+
+static std::vector<unsigned char> atlasRows(FONScontext* _fons, int _y0, int _y1) {
+    int iw, ih;
+    auto data = (const unsigned char*)fonsGetTextureData(_fons, &iw, &ih);
+    return std::vector<unsigned char>(data + iw*_y0, data + iw*_y1);
+}
+
+TEST_CASE("Resetting atlas rows keeps glyphs in other rows", "[fontstash]") {
+    int font = -1;
+    FONScontext* fons = createStash(font);
+    REQUIRE(font >= 0);
+    auto cps = testCodepoints();
+
+    std::vector<AtlasGlyph> block0, block1;
+    size_t end0 = fillBlock(fons, font, cps, 0, block0);
+    REQUIRE(end0 < cps.size());  // block 0 is full
+    expandAtlas(fons);
+    size_t end1 = fillBlock(fons, font, cps, end0, block1);
+    REQUIRE(end1 > end0);
+    for (auto& glyph : block0) { REQUIRE((glyph.y >= 0 && glyph.y < blockSize)); }
+    for (auto& glyph : block1) { REQUIRE((glyph.y >= blockSize && glyph.y < 2*blockSize)); }
+
+    int dirty[4];
+    fonsValidateTexture(fons, dirty);
+    auto pixels1 = atlasRows(fons, blockSize, 2*blockSize);
+
+    // reuse block 0, as FontContext::addTexture does for an unreferenced texture
+    REQUIRE(fonsResetAtlasRows(fons, 0, blockSize));
+
+    // glyphs in block 1 are found through the rebuilt lookup with unchanged coords and are not rendered again
+    for (size_t ii = end0; ii < end1; ii++) {
+        AtlasGlyph glyph = getGlyph(fons, font, cps[ii]);
+        REQUIRE(glyph.ok);
+        REQUIRE(glyph.x == block1[ii - end0].x);
+        REQUIRE(glyph.y == block1[ii - end0].y);
+    }
+    REQUIRE(fonsValidateTexture(fons, dirty) == 0);
+    REQUIRE(atlasRows(fons, blockSize, 2*blockSize) == pixels1);
+    REQUIRE(atlasRows(fons, 0, blockSize) == std::vector<unsigned char>(blockSize*blockSize, 0));
+
+    // glyphs dropped from block 0 are rendered again, only into block 0
+    for (size_t ii = 0; ii < end0; ii++) {
+        AtlasGlyph glyph = getGlyph(fons, font, cps[ii]);
+        REQUIRE(glyph.ok);
+        REQUIRE((glyph.y >= 0 && glyph.y < blockSize));
+    }
+    REQUIRE(fonsValidateTexture(fons, dirty) == 1);
+    REQUIRE(dirty[3] <= blockSize);
+    REQUIRE(atlasRows(fons, blockSize, 2*blockSize) == pixels1);
+
+    // new glyphs are never drawn into block 1 until it is reset
+    for (size_t ii = end1; ii < cps.size(); ii++) { getGlyph(fons, font, cps[ii]); }
+    if (fonsValidateTexture(fons, dirty)) { REQUIRE(dirty[3] <= blockSize); }
+    REQUIRE(atlasRows(fons, blockSize, 2*blockSize) == pixels1);
+
+    fonsDeleteInternal(fons);
+}
+
+TEST_CASE("Missing glyphs follow the notdef glyph when its rows are reset", "[fontstash]") {
+    int font = -1;
+    FONScontext* fons = createStash(font);
+    REQUIRE(font >= 0);
+    // unassigned codepoints, rendered with the single notdef bitmap
+    const unsigned int missing0 = 0x0378, missing1 = 0x0379;
+
+    SECTION("notdef in reset rows") {
+        AtlasGlyph notDef0 = getGlyph(fons, font, missing0);
+        REQUIRE(notDef0.ok);
+        REQUIRE(notDef0.y < blockSize);
+        expandAtlas(fons);
+        AtlasGlyph a = getGlyph(fons, font, 'A');
+        REQUIRE(a.y >= blockSize);
+
+        REQUIRE(fonsResetAtlasRows(fons, 0, blockSize));
+        // the missing glyph's entry referenced the dropped notdef glyph, so it is dropped too and notdef
+        //  is rendered again in the reset rows
+        AtlasGlyph notDef1 = getGlyph(fons, font, missing0);
+        REQUIRE(notDef1.ok);
+        REQUIRE(notDef1.y < blockSize);
+        int dirty[4];
+        REQUIRE(fonsValidateTexture(fons, dirty) == 1);
+        AtlasGlyph other = getGlyph(fons, font, missing1);
+        REQUIRE(other.ok);
+        REQUIRE(other.x == notDef1.x);
+        REQUIRE(other.y == notDef1.y);
+        REQUIRE(getGlyph(fons, font, 'A').y == a.y);
+    }
+
+    SECTION("notdef in retained rows") {
+        AtlasGlyph a = getGlyph(fons, font, 'A');
+        REQUIRE(a.y < blockSize);
+        expandAtlas(fons);
+        AtlasGlyph notDef0 = getGlyph(fons, font, missing0);
+        REQUIRE(notDef0.ok);
+        REQUIRE(notDef0.y >= blockSize);
+
+        int dirty[4];
+        fonsValidateTexture(fons, dirty);
+        REQUIRE(fonsResetAtlasRows(fons, 0, blockSize));
+        AtlasGlyph notDef1 = getGlyph(fons, font, missing0);
+        REQUIRE(notDef1.x == notDef0.x);
+        REQUIRE(notDef1.y == notDef0.y);
+        AtlasGlyph other = getGlyph(fons, font, missing1);
+        REQUIRE(other.x == notDef0.x);
+        REQUIRE(other.y == notDef0.y);
+        REQUIRE(fonsValidateTexture(fons, dirty) == 0);
+    }
+
+    fonsDeleteInternal(fons);
+}
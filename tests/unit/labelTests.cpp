@@ -10,6 +10,8 @@
 #include "glm/mat4x4.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 
+#include <new>
+
 #define EPSILON 0.00001
 
 using namespace Tangram;
@@ -151,6 +153,22 @@ TEST_CASE( "Ensure debug labels are always visible and cannot occlude", "[Core][
     REQUIRE(!l.canOcclude());
 }
 
+TEST_CASE( "Labels get a new serial even at the address of a deleted label", "[Core][Label]" ) {
+    // LabelManager caches collision results by serial
+    alignas(TextLabel) unsigned char storage[sizeof(TextLabel)];
+    auto* a = new (storage) TextLabel(makeLabel({screenSize/2.f}, Label::Type::point));
+    uint64_t serialA = a->serial();
+    TextLabel copy(*a);
+    REQUIRE(copy.serial() != serialA);
+    a->~TextLabel();
+
+    auto* b = new (storage) TextLabel(makeLabel({screenSize/2.f}, Label::Type::point));
+    REQUIRE(static_cast<void*>(b) == static_cast<void*>(a));
+    REQUIRE(b->serial() != serialA);
+    REQUIRE(b->serial() != copy.serial());
+    b->~TextLabel();
+}
+
 TEST_CASE( "Linear interpolation", "[Core][Label][Fade]" ) {
     FadeEffect fadeOut(false, FadeEffect::Interpolation::linear, 1.0);
 
@@ -11,7 +11,9 @@
 #include "tile/tile.h"
 #include "view/view.h"
 
+#include <algorithm>
 #include <memory>
+#include <random>
 
 namespace Tangram {
 
@@ -216,4 +218,107 @@ TEST_CASE( "Test anchor fallback behavior", "[Labels][AnchorFallback]" ) {
     }
 
 }
+
+TEST_CASE( "Incremental label collision matches full collision", "[Labels][Collision]" ) {
+
+    View view(256, 256);
+    view.setConstrainToWorldBounds(false);
+    view.setPosition(0, 0);
+    view.setZoom(0);
+    view.update();
+
+    Tile tile({0,0,0});
+    tile.update(view, 0);
+
+    struct TestTransform {
+        ScreenTransform transform;
+        TestTransform(ScreenTransform::Buffer& _buffer, Range& _range) : transform(_buffer, _range) {}
+    };
+
+    class TestLabels : public LabelManager {
+    public:
+        TestLabels(View& _v, float _threshold) {
+            m_isect2d.resize({4, 4}, {_v.getWidth(), _v.getHeight()});
+            setCollisionThreshold(_threshold);
+        }
+
+        void addLabel(Label* _l, Tile* _t, View& _v) {
+            m_labels.push_back({_l, nullptr, _t, nullptr, false, {}});
+            tmpTransforms.emplace_back(m_transforms, m_labels.back().transformRange);
+            _l->update(_t->mvp(), _v.state(), bounds, tmpTransforms.back().transform);
+        }
+        void run(View& _v) { handleOcclusions(_v.state()); }
+        void clear() {
+            m_labels.clear();
+            m_transforms.clear();
+            m_obbs.clear();
+            tmpTransforms.clear();
+        }
+
+        std::vector<TestTransform> tmpTransforms;
+    };
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> pos(0.3f, 0.7f);
+    auto makeLabel = [&]() {
+        return std::make_unique<TextLabel>(makeLabelWithAnchorFallbacks(glm::vec2{pos(rng), pos(rng)}));
+    };
+
+    // same labels in both managers; full collision for reference
+    const size_t numLabels = 80;
+    std::vector<std::unique_ptr<TextLabel>> full, incremental;
+    for (size_t i = 0; i < numLabels; i++) {
+        full.push_back(makeLabel());
+        incremental.push_back(std::make_unique<TextLabel>(*full.back()));
+    }
+    std::vector<size_t> order(numLabels);
+    for (size_t i = 0; i < numLabels; i++) { order[i] = i; }
+
+    TestLabels fullLabels(view, -1);
+    TestLabels incrementalLabels(view, 0);
+
+    for (int frame = 0; frame < 12; frame++) {
+        if (frame == 3 || frame == 7) {
+            // replace some labels
+            for (size_t i = 0; i < numLabels; i += 7) {
+                full[i] = makeLabel();
+                incremental[i] = std::make_unique<TextLabel>(*full[i]);
+            }
+        } else if (frame == 5) {
+            // change collision order of a few labels
+            std::swap(order[3], order[40]);
+            std::swap(order[10], order[11]);
+        } else if (frame == 9) {
+            view.setPosition(1000, -500);
+            view.update();
+            tile.update(view, 0);
+        }
+        // some labels absent in alternate frames
+        size_t count = frame % 2 ? numLabels - 5 : numLabels;
+
+        fullLabels.clear();
+        incrementalLabels.clear();
+        fullLabels.tmpTransforms.reserve(count);
+        incrementalLabels.tmpTransforms.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            fullLabels.addLabel(full[order[i]].get(), &tile, view);
+            incrementalLabels.addLabel(incremental[order[i]].get(), &tile, view);
+        }
+
+        fullLabels.run(view);
+        incrementalLabels.run(view);
+
+        size_t numOccluded = 0;
+        for (size_t i = 0; i < count; i++) {
+            auto& a = *full[order[i]];
+            auto& b = *incremental[order[i]];
+            REQUIRE(a.isOccluded() == b.isOccluded());
+            REQUIRE(a.anchorType() == b.anchorType());
+            numOccluded += a.isOccluded();
+        }
+        // collisions and anchor fallbacks are exercised
+        REQUIRE(numOccluded > 0);
+        REQUIRE(numOccluded < count);
+    }
+}
 }
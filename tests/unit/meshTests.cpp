@@ -2,6 +2,12 @@
 
 #include <iostream>
 #include "gl/mesh.h"
+#include "style/polylineStyle.h"
+#include "util/builders.h"
+
+#include <cmath>
+#include <map>
+#include <tuple>
 
 using namespace Tangram;
 
@@ -170,3 +176,207 @@ TEST_CASE( "Check overflow", "[Core][TypedMesh]" ) {
 
     checkBounds(mesh);
 }
+
+struct LodVertex {
+    struct { short x, y, z, w; } pos;
+    short side;
+};
+
+struct LodTestMesh : public Mesh<LodVertex> {
+    using Base = Mesh<LodVertex>;
+    using Base::Base;
+
+    int numIndices() const { return m_nIndices; }
+    int numLodIndices() const { return m_nLodIndices; }
+    const std::vector<uint32_t>& lodIndexCounts() const { return m_lodIndexCounts; }
+    const GLushort* indexData() const { return m_glIndexData; }
+};
+
+// line of _n points _spacing apart along x, as a strip of two vertices per point (like polyline builder)
+static MeshData<LodVertex> lineStrip(int _n, short _spacing) {
+    MeshData<LodVertex> meshData;
+    for (int i = 0; i < _n; i++) {
+        for (short side : {0, 1}) {
+            meshData.vertices.push_back({{short(i*_spacing), 0, 0, 0}, side});
+        }
+    }
+    for (int i = 0; i + 1 < _n; i++) {
+        uint16_t v = 2*i;
+        meshData.indices.insert(meshData.indices.end(), {v, uint16_t(v+1), uint16_t(v+2)});
+        meshData.indices.insert(meshData.indices.end(), {uint16_t(v+1), uint16_t(v+3), uint16_t(v+2)});
+    }
+    meshData.offsets.emplace_back(meshData.indices.size(), meshData.vertices.size());
+    return meshData;
+}
+
+TEST_CASE( "Decimated indices merge vertices in same cell", "[Core][TypedMesh]" ) {
+    auto meshData = lineStrip(10, 4);
+    auto side = [](const LodVertex& v) { return v.side; };
+
+    // full precision cells keep all triangles
+    meshData.buildLodIndices(1, side);
+    REQUIRE(meshData.lodIndices == meshData.indices);
+    REQUIRE(meshData.lodOffsets == std::vector<uint32_t>{ uint32_t(meshData.indices.size()) });
+
+    // 4 points per cell: only quads crossing cell boundaries remain
+    meshData.buildLodIndices(16, side);
+    REQUIRE(meshData.lodIndices.size() == 4*3);
+    REQUIRE(meshData.lodOffsets == std::vector<uint32_t>{ 12 });
+    for (size_t i = 0; i < meshData.lodIndices.size(); i += 3) {
+        auto* t = &meshData.lodIndices[i];
+        REQUIRE((t[0] != t[1] && t[1] != t[2] && t[0] != t[2]));
+        // sides are not merged
+        int sides = meshData.vertices[t[0]].side + meshData.vertices[t[1]].side + meshData.vertices[t[2]].side;
+        REQUIRE((sides == 1 || sides == 2));
+    }
+}
+
+TEST_CASE( "Decimated indices are compiled after full indices", "[Core][TypedMesh]" ) {
+    auto lodLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+        {"pos", 4, GL_SHORT, false, 0},
+        {"side", 1, GL_SHORT, false, 0},
+    }));
+    std::vector<MeshData<LodVertex>> meshes = { lineStrip(10, 4), lineStrip(3, 4) };
+    meshes[0].buildLodIndices(16, [](const LodVertex& v) { return v.side; });
+
+    LodTestMesh mesh(lodLayout, GL_TRIANGLES);
+    mesh.compile(meshes);
+
+    // second mesh has no decimated indices, so uses its full indices
+    size_t nFull = meshes[0].indices.size() + meshes[1].indices.size();
+    REQUIRE(mesh.numIndices() == int(nFull));
+    REQUIRE(mesh.numLodIndices() == int(meshes[0].lodIndices.size() + meshes[1].indices.size()));
+    REQUIRE(mesh.lodIndexCounts() == std::vector<uint32_t>{ uint32_t(mesh.numLodIndices()) });
+
+    const GLushort* lod = mesh.indexData() + nFull;
+    for (size_t i = 0; i < meshes[0].lodIndices.size(); i++) {
+        REQUIRE(lod[i] == meshes[0].lodIndices[i]);
+    }
+    // shifted by vertices of first mesh
+    lod += meshes[0].lodIndices.size();
+    for (size_t i = 0; i < meshes[1].indices.size(); i++) {
+        REQUIRE(lod[i] == meshes[1].indices[i] + meshes[0].vertices.size());
+    }
+}
+
+struct LineVertex {
+    struct { short x, y, z, w; } pos;
+    struct { short x, y, z, w; } extrude;
+};
+
+// largest per-axis distance in pixels between a vertex and the one it is merged into by buildLodIndices
+template<class F>
+static float maxClusterError(const MeshData<LineVertex>& _mesh, int _cellSize, float _pixels, F _clusterKey) {
+    // packed as by PolylineStyle
+    const float positionScale = 8192, extrusionScale = 4096;
+    auto screenPos = [&](const LineVertex& v) {
+        glm::vec2 pos(v.pos.x/positionScale, v.pos.y/positionScale);
+        glm::vec2 extrude(v.extrude.x/extrusionScale, v.extrude.y/extrusionScale);
+        return (pos + extrude*(v.extrude.z/extrusionScale)) * _pixels;
+    };
+    std::map<std::tuple<int, int, uint32_t>, size_t> clusters;
+    float maxError = 0;
+    for (size_t i = 0; i < _mesh.vertices.size(); i++) {
+        auto& v = _mesh.vertices[i];
+        auto key = std::make_tuple((v.pos.x + 32768)/_cellSize, (v.pos.y + 32768)/_cellSize, uint32_t(_clusterKey(v)));
+        auto& first = _mesh.vertices[clusters.emplace(key, i).first->second];
+        glm::vec2 d = screenPos(v) - screenPos(first);
+        maxError = std::max(maxError, std::max(std::abs(d.x), std::abs(d.y)));
+    }
+    return maxError;
+}
+
+// polyline with round joins and caps, packed as by PolylineStyle
+static MeshData<LineVertex> roundJoinLine(float _halfWidth) {
+    MeshData<LineVertex> meshData;
+    PolyLineBuilder builder([&](const glm::vec2& coord, const glm::vec2& normal, const glm::vec2& uv) {
+        meshData.vertices.push_back({{short(std::nearbyint(coord.x*8192)), short(std::nearbyint(coord.y*8192)), 0, 0},
+                                     {short(normal.x*4096), short(normal.y*4096), short(std::nearbyint(_halfWidth*4096)), 0}});
+    }, CapTypes::round, JoinTypes::round);
+    // right angle and sharp turns; fan vertices of the round joins are all at the turn points
+    Builders::buildPolyLine({{0.2f, 0.2f}, {0.5f, 0.2f}, {0.5f, 0.5f}, {0.3f, 0.52f}}, builder);
+    meshData.indices = builder.indices;
+    meshData.offsets.emplace_back(builder.indices.size(), builder.numVertices);
+    return meshData;
+}
+
+TEST_CASE( "Decimated round joins and caps stay within about a pixel", "[Core][TypedMesh]" ) {
+    const float pixels = 256;  // tile size at styling zoom
+    const int cellSize = 8192/pixels;
+    auto key = [&](const LineVertex& v) {
+        return PolylineStyle::lodClusterKey(v.extrude.x, v.extrude.y, v.extrude.z, pixels);
+    };
+
+    // 40 px wide line
+    auto wide = roundJoinLine(20/pixels);
+    wide.buildLodIndices(cellSize, key);
+    REQUIRE(maxClusterError(wide, cellSize, pixels, key) < 1.5f);
+    REQUIRE(!wide.lodIndices.empty());
+
+    // clustering by extrusion octant alone moves join corners by a good part of the line width
+    auto octant = [](const LineVertex& v) {
+        int x = v.extrude.x, y = v.extrude.y;
+        return (x == 0 && y == 0) ? 8 : (x < 0) << 2 | (y < 0) << 1 | (std::abs(x) < std::abs(y));
+    };
+    REQUIRE(maxClusterError(wide, cellSize, pixels, octant) > 5.f);
+
+    // 1 px wide line: fans collapse but both sides of the line are kept
+    auto thin = roundJoinLine(0.5f/pixels);
+    thin.buildLodIndices(cellSize, key);
+    REQUIRE(maxClusterError(thin, cellSize, pixels, key) < 1.5f);
+    REQUIRE(thin.lodIndices.size() < thin.indices.size());
+    REQUIRE(!thin.lodIndices.empty());
+}
+
+struct SelectionVertex {
+    struct { short x, y, z, w; } pos;
+    GLuint abgr;
+    GLuint selection;
+};
+
+struct CompactTestMesh : public Mesh<SelectionVertex> {
+    using Base = Mesh<SelectionVertex>;
+    using Base::Base;
+
+    const GLbyte* vertexData() const { return m_glVertexData; }
+};
+
+TEST_CASE( "Vertex layout without trailing selection color", "[Core][TypedMesh]" ) {
+    auto fullLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+        {"a_position", 4, GL_SHORT, false, 0},
+        {"a_color", 4, GL_UNSIGNED_BYTE, true, 0},
+        {"a_selection_color", 4, GL_UNSIGNED_BYTE, true, 0},
+    }));
+    auto attribs = fullLayout->getAttribs();
+    attribs.pop_back();
+    auto compactLayout = std::make_shared<VertexLayout>(attribs);
+    REQUIRE(fullLayout->getStride() == sizeof(SelectionVertex));
+    REQUIRE(compactLayout->getStride() == 12);
+
+    std::vector<MeshData<SelectionVertex>> meshes(2);
+    for (short i = 0; i < 5; i++) {
+        meshes[i % 2].vertices.push_back({{i, short(-i), 0, 1}, 0xff000000u + i, 0});
+    }
+    for (auto& m : meshes) { m.offsets.emplace_back(0, m.vertices.size()); }
+
+    CompactTestMesh full(fullLayout, GL_TRIANGLES);
+    full.compile(meshes);
+    REQUIRE(full.hasSelection());
+    REQUIRE(full.vertexBytes() == 5 * sizeof(SelectionVertex));
+
+    CompactTestMesh compact(compactLayout, GL_TRIANGLES);
+    compact.compile(meshes);
+    REQUIRE(!compact.hasSelection());
+    REQUIRE(compact.vertexCount() == 5);
+    REQUIRE(compact.vertexBytes() == 5 * 12);
+    REQUIRE(compact.bufferSize() == 5 * 12);
+
+    // vertices are packed without selection color, in order of meshes
+    const GLbyte* data = compact.vertexData();
+    for (auto& m : meshes) {
+        for (auto& v : m.vertices) {
+            REQUIRE(std::memcmp(data, &v, 12) == 0);
+            data += 12;
+        }
+    }
+}
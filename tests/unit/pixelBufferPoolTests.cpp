@@ -0,0 +1,71 @@
+#include "catch.hpp"
+
+#include "gl/pixelBufferPool.h"
+
+using namespace Tangram;
+
+TEST_CASE("Pixel buffer sizes are rounded to size classes", "[Core][PixelBufferPool]") {
+    // small buffers are not pooled
+    REQUIRE(PixelBufferPool::capacity(1000) == 1000);
+    // exact classes
+    REQUIRE(PixelBufferPool::capacity(256*256*4) == 256*256*4);
+    REQUIRE(PixelBufferPool::capacity(512*512*4) == 512*512*4);
+    REQUIRE(PixelBufferPool::capacity(3*65536) == 3*65536);
+    // rounded up by at most 1/4 power of two
+    REQUIRE(PixelBufferPool::capacity(256*256*4 + 1) == 5*65536);
+    REQUIRE(PixelBufferPool::capacity(258*258*4) == 5*65536);
+}
+
+TEST_CASE("Released pixel buffers are reused", "[Core][PixelBufferPool]") {
+    PixelBufferPool pool;
+    size_t bytes = 256*256*4;
+
+    GLubyte* a = pool.acquire(bytes);
+    REQUIRE(a != nullptr);
+    REQUIRE(pool.stats().misses == 1);
+    pool.release(a, bytes);
+    REQUIRE(pool.stats().pooledBuffers == 1);
+    REQUIRE(pool.stats().pooledBytes == bytes);
+
+    // same size class reuses buffer
+    GLubyte* b = pool.acquire(bytes - 100);
+    REQUIRE(b == a);
+    REQUIRE(pool.stats().hits == 1);
+    REQUIRE(pool.stats().pooledBuffers == 0);
+
+    // different size class allocates
+    GLubyte* c = pool.acquire(2*bytes);
+    REQUIRE(pool.stats().misses == 2);
+    pool.release(b, bytes - 100);
+    pool.release(c, 2*bytes);
+    REQUIRE(pool.stats().pooledBytes == 3*bytes);
+
+    // small buffers are not kept
+    pool.release(pool.acquire(100), 100);
+    REQUIRE(pool.stats().pooledBuffers == 2);
+}
+
+TEST_CASE("Pixel buffer pool respects memory limit", "[Core][PixelBufferPool]") {
+    size_t bytes = 256*256*4;
+    PixelBufferPool pool(3*bytes);
+
+    GLubyte* large = pool.acquire(2*bytes);
+    GLubyte* small1 = pool.acquire(bytes);
+    GLubyte* small2 = pool.acquire(bytes);
+    pool.release(large, 2*bytes);
+    pool.release(small1, bytes);
+    // over limit - freed instead of pooled
+    pool.release(small2, bytes);
+    REQUIRE(pool.stats().pooledBytes == 3*bytes);
+    REQUIRE(pool.stats().pooledBuffers == 2);
+
+    // largest buffers are trimmed first
+    pool.setMaxBytes(2*bytes);
+    REQUIRE(pool.stats().pooledBytes == bytes);
+    REQUIRE(pool.acquire(bytes) == small1);
+
+    pool.setMaxBytes(0);
+    REQUIRE(pool.stats().pooledBytes == 0);
+    pool.release(small1, bytes);
+    REQUIRE(pool.stats().pooledBuffers == 0);
+}
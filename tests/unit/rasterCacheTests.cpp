@@ -0,0 +1,126 @@
+#include "catch.hpp"
+
+#include "data/rasterCache.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace Tangram;
+
+static std::unique_ptr<Texture> makeTexture(bool _keepData = false) {
+    auto texture = std::make_unique<Texture>(TextureOptions(), !_keepData);
+    std::vector<GLubyte> pixels(16 * 16 * 4, 0);
+    texture->setPixelData(16, 16, 4, pixels.data(), pixels.size());
+    return texture;
+}
+
+TEST_CASE("RasterCache shares textures in use", "[RasterCache]") {
+    auto cache = std::make_shared<RasterCache>();
+    TileID tileId(1, 2, 3);
+
+    int decodes = 0;
+    auto decode = [&]() { decodes++; return makeTexture(); };
+
+    auto texture = cache->getOrDecode(tileId, decode);
+    REQUIRE(texture);
+    CHECK(cache->getOrDecode(tileId, decode) == texture);
+    CHECK(cache->get(TileID(1, 2, 3, 5)) == texture);
+    CHECK(decodes == 1);
+
+    auto stats = cache->stats();
+    CHECK(stats.entries == 1);
+    CHECK(stats.bytes == 16 * 16 * 4);
+    CHECK(stats.decodes == 1);
+    CHECK(stats.hits == 2);
+
+    // CPU copy kept for elevation is included
+    auto elevation = cache->getOrDecode(TileID(0, 0, 3), []() { return makeTexture(true); });
+    CHECK(cache->stats().bytes == 3 * 16 * 16 * 4);
+
+    // failed decode is not cached
+    CHECK_FALSE(cache->getOrDecode(TileID(0, 1, 3), []() { return nullptr; }));
+    CHECK(cache->stats().entries == 2);
+
+    // without retained budget, texture is dropped when last reference is released
+    texture.reset();
+    elevation.reset();
+    CHECK_FALSE(cache->get(tileId));
+    CHECK(cache->stats().entries == 0);
+    CHECK(cache->stats().bytes == 0);
+}
+
+TEST_CASE("RasterCache decodes tile once for concurrent requests", "[RasterCache]") {
+    auto cache = std::make_shared<RasterCache>();
+    std::atomic<int> decodes(0);
+
+    std::vector<std::shared_ptr<Texture>> results(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < results.size(); i++) {
+        threads.emplace_back([&, i]() {
+            results[i] = cache->getOrDecode(TileID(5, 5, 4), [&]() {
+                decodes++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                return makeTexture();
+            });
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    CHECK(decodes == 1);
+    for (auto& result : results) { CHECK(result == results[0]); }
+    auto stats = cache->stats();
+    CHECK(stats.decodes == 1);
+    CHECK(stats.decodes + stats.waits + stats.hits == results.size());
+}
+
+TEST_CASE("RasterCache retains recently used textures up to limit", "[RasterCache]") {
+    auto cache = std::make_shared<RasterCache>();
+    size_t bytes = 16 * 16 * 4;
+    cache->setMaxBytes(2 * bytes);
+
+    for (int x = 0; x < 3; x++) {
+        cache->getOrDecode(TileID(x, 0, 2), []() { return makeTexture(); });
+        if (x == 1) { cache->get(TileID(0, 0, 2)); }
+    }
+
+    // tile 1 was least recently used
+    auto stats = cache->stats();
+    CHECK(stats.entries == 2);
+    CHECK(stats.retainedBytes == 2 * bytes);
+    CHECK(stats.evictions == 1);
+    CHECK(cache->get(TileID(0, 0, 2)));
+    CHECK_FALSE(cache->get(TileID(1, 0, 2)));
+    CHECK(cache->get(TileID(2, 0, 2)));
+
+    cache->clear();
+    CHECK(cache->stats().entries == 0);
+    CHECK(cache->stats().retainedBytes == 0);
+}
+
+TEST_CASE("RasterCache peek does not affect retained order or stats", "[RasterCache]") {
+    auto cache = std::make_shared<RasterCache>();
+    size_t bytes = 16 * 16 * 4;
+    cache->setMaxBytes(2 * bytes);
+
+    for (int x = 0; x < 3; x++) {
+        cache->getOrDecode(TileID(x, 0, 2), []() { return makeTexture(); });
+        // unlike get(), peek leaves tile 0 least recently used
+        if (x == 1) { CHECK(cache->peek(TileID(0, 0, 2))); }
+    }
+
+    auto stats = cache->stats();
+    CHECK(stats.hits == 0);
+    CHECK(stats.evictions == 1);
+    CHECK_FALSE(cache->peek(TileID(0, 0, 2)));
+    CHECK(cache->peek(TileID(1, 0, 2)));
+    CHECK(cache->stats().hits == 0);
+
+    // user data (e.g. elevation pyramid) is counted against limit
+    auto texture = makeTexture(true);
+    texture->userDataSize = 1000;
+    auto elevation = cache->getOrDecode(TileID(0, 0, 3), [&]() { return std::move(texture); });
+    CHECK(elevation->memoryUsage() == 2 * bytes + 1000);
+    CHECK(cache->stats().bytes == 2 * bytes + elevation->memoryUsage());
+}
@@ -4,7 +4,12 @@
 #include "scene/importer.h"
 #include "scene/scene.h"
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <iostream>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 using namespace Tangram;
@@ -315,3 +320,55 @@ TEST_CASE("Scenes imported more than once are not mutated", "[import][core]") {
 
     CHECK(root["key"].Scalar() == "value_a");
 }
+
+// responds to each request from its own thread after a delay, like a network platform
+struct ThreadedImportMockPlatform : public ImportMockPlatform {
+    std::vector<std::thread> threads;
+
+    bool startUrlRequestImpl(const Url& _url, const HttpOptions& _options,
+                             const UrlRequestHandle _request, UrlRequestId& _id) override {
+        threads.emplace_back([=]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            UrlRequestId id;
+            ImportMockPlatform::startUrlRequestImpl(_url, _options, _request, id);
+        });
+        return false;
+    }
+
+    ~ThreadedImportMockPlatform() override {
+        for (auto& thread : threads) { thread.join(); }
+    }
+};
+
+// Importer whose parsing of imported scene files (but not the root) waits for a second parse to start
+struct OverlapImporter : public Importer {
+    std::mutex mutex;
+    std::condition_variable cv;
+    int parsing = 0;
+    int maxParsing = 0;
+
+    SceneNode parseSceneYaml(const Url& _url, const char* _yaml, size_t _length) override {
+        if (_url.path() != "/root/c.yaml") {
+            std::unique_lock<std::mutex> lock(mutex);
+            maxParsing = std::max(maxParsing, ++parsing);
+            cv.notify_all();
+            // times out if parsing is serialized, e.g. by m_sceneMutex
+            cv.wait_for(lock, std::chrono::seconds(2), [&]() { return maxParsing >= 2; });
+            parsing--;
+        }
+        return Importer::parseSceneYaml(_url, _yaml, _length);
+    }
+};
+
+TEST_CASE("Imports arriving together are parsed concurrently", "[import][core]") {
+    ThreadedImportMockPlatform platform;
+    OverlapImporter importer;
+    auto root = importer.loadSceneData(platform, Url("/root/c.yaml"));
+
+    CHECK(importer.maxParsing == 2);
+    CHECK(root["value"].Scalar() == "c");
+    CHECK(root["has_a"].Scalar() == "true");
+    CHECK(root["has_b"].Scalar() == "true");
+    CHECK(root["has_c"].Scalar() == "true");
+    CHECK(importer.sceneHashes().size() == 3);
+}
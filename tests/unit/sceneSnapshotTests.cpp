@@ -0,0 +1,146 @@
+#include "catch.hpp"
+
+#include "mockPlatform.h"
+#include "scene/importer.h"
+#include "scene/sceneSnapshot.h"
+#include "sceneOptions.h"
+#include "util/hash.h"
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <utime.h>
+
+using namespace Tangram;
+
+static const char* sceneYaml = R"END(
+global:
+    color: '#f00'
+    width: [[10, 1px], [14, 4px]]
+sources:
+    osm: { type: MVT, url: 'https://host/{z}/{x}/{y}.mvt', max_zoom: 14 }
+layers:
+    roads:
+        data: { source: osm }
+        filter: { kind: [highway, major_road], $zoom: { min: 12 } }
+        draw: { lines: { color: global.color, width: 2.5, visible: true, order: null } }
+)END";
+
+static std::string snapshotPath() { return "compiled_scene_test.bin"; }
+
+TEST_CASE("SceneSnapshot round trips config nodes", "[SceneSnapshot]") {
+    YAML::Node config = YAML::Load(sceneYaml);
+    REQUIRE(config.IsMap());
+
+    std::string data;
+    SceneSnapshot::serialize(config, data);
+
+    YAML::Node result;
+    const char* pos = data.data();
+    REQUIRE(SceneSnapshot::deserialize(pos, data.data() + data.size(), result));
+    CHECK(pos == data.data() + data.size());
+    CHECK(YAML::Dump(result) == YAML::Dump(config));
+    CHECK(result["sources"]["osm"]["max_zoom"].as<double>() == 14);
+    CHECK(result["layers"]["roads"]["draw"]["lines"]["visible"].as<bool>() == true);
+
+    // truncated data is rejected
+    for (size_t len : {size_t(0), size_t(1), data.size() / 2, data.size() - 1}) {
+        YAML::Node partial;
+        pos = data.data();
+        CHECK_FALSE(SceneSnapshot::deserialize(pos, data.data() + len, partial));
+    }
+}
+
+TEST_CASE("SceneSnapshot is only read for matching key", "[SceneSnapshot]") {
+    SceneOptions options(Url("/root/scene.yaml"));
+    uint64_t key = SceneSnapshot::inputKey(options);
+
+    SceneSnapshot::Imports imports = {{Url("/root/scene.yaml"), 42, 0}, {Url("/root/imports/a.yaml"), 7, 99}};
+    YAML::Node config = YAML::Load(sceneYaml);
+    REQUIRE(SceneSnapshot::write(snapshotPath(), key, imports, config));
+
+    SceneSnapshot snapshot;
+    REQUIRE(SceneSnapshot::read(snapshotPath(), key, snapshot));
+    REQUIRE(snapshot.imports.size() == 2);
+    CHECK(snapshot.imports[1].url.string() == "/root/imports/a.yaml");
+    CHECK(snapshot.imports[1].hash == 7);
+    CHECK(snapshot.imports[1].stamp == 99);
+    CHECK(YAML::Dump(snapshot.config) == YAML::Dump(config));
+
+    options.updates.emplace_back("global.color", "'#0f0'");
+    SceneSnapshot other;
+    CHECK_FALSE(SceneSnapshot::read(snapshotPath(), SceneSnapshot::inputKey(options), other));
+
+    // truncate file
+    std::string data;
+    {
+        std::ifstream file(snapshotPath(), std::ios::binary);
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(snapshotPath(), std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size() - 3);
+    }
+    CHECK_FALSE(SceneSnapshot::read(snapshotPath(), key, other));
+
+    std::remove(snapshotPath().c_str());
+    CHECK_FALSE(SceneSnapshot::read(snapshotPath(), key, other));
+}
+
+TEST_CASE("SceneSnapshot stamps local files by size and mtime", "[SceneSnapshot]") {
+    const char* path = "snapshot_stamp_test.yaml";
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << "value: a\n";
+    }
+    char cwd[1024];
+    REQUIRE(getcwd(cwd, sizeof(cwd)));
+    Url url(std::string("file://") + cwd + "/" + path);
+
+    // just written, so mtime can't be trusted yet
+    CHECK(SceneSnapshot::fileStamp(url) == 0);
+
+    struct utimbuf old = {std::time(nullptr) - 60, std::time(nullptr) - 60};
+    REQUIRE(utime(path, &old) == 0);
+    uint64_t stamp = SceneSnapshot::fileStamp(url);
+    CHECK(stamp != 0);
+    CHECK(SceneSnapshot::fileStamp(url) == stamp);
+
+    {
+        std::ofstream file(path, std::ios::app);
+        file << "other: b\n";
+    }
+    REQUIRE(utime(path, &old) == 0);
+    CHECK(SceneSnapshot::fileStamp(url) != stamp);
+
+    std::remove(path);
+    CHECK(SceneSnapshot::fileStamp(url) == 0);
+    CHECK(SceneSnapshot::fileStamp(Url("https://host/scene.yaml")) == 0);
+}
+
+TEST_CASE("Importer records hashes of scene files", "[SceneSnapshot]") {
+    MockPlatform platform;
+    std::string a = "import: b.yaml\nvalue: a\n";
+    std::string b = "value: b\n";
+    platform.putMockUrlContents(Url("/root/a.yaml"), a);
+    platform.putMockUrlContents(Url("/root/b.yaml"), b);
+
+    Importer importer;
+    auto config = importer.loadSceneData(platform, Url("/root/a.yaml"));
+    REQUIRE(config["value"].as<std::string>() == "a");
+
+    auto& hashes = importer.sceneHashes();
+    REQUIRE(hashes.size() == 2);
+    CHECK(hashes.at(Url("/root/a.yaml")) == hash_fnv1a(a.data(), a.size()));
+    CHECK(hashes.at(Url("/root/b.yaml")) == hash_fnv1a(b.data(), b.size()));
+
+    platform.putMockUrlContents(Url("/root/b.yaml"), "value: c\n");
+    Importer checker;
+    auto current = checker.fetchSceneHashes(platform, {Url("/root/a.yaml"), Url("/root/b.yaml"), Url("/root/x.yaml")});
+    REQUIRE(current.size() == 3);
+    CHECK(current[0] == hashes.at(Url("/root/a.yaml")));
+    CHECK(current[1] != hashes.at(Url("/root/b.yaml")));
+    CHECK(current[2] == 0);
+}
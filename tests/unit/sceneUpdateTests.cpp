@@ -229,3 +229,55 @@ TEST_CASE("Scene update statuses") {
         CHECK(SceneLoader::applyUpdates(config, updates).error == Error::scene_update_value_yaml_syntax_error);
     }
 }
+
+TEST_CASE("Find uses of globals in JS functions") {
+    CHECK(Scene::functionUsesGlobal("function() { return global.color; }", "global.color"));
+    CHECK(Scene::functionUsesGlobal("function() { return global.style.color; }", "global.style"));
+    CHECK(Scene::functionUsesGlobal("function() { return global.style; }", "global.style.color"));
+    CHECK(Scene::functionUsesGlobal("function() { return global.list[1]; }", "global.list#1"));
+    CHECK(Scene::functionUsesGlobal("function() { return global.color; }", "global"));
+    CHECK(Scene::functionUsesGlobal("function() { return global[feature.kind]; }", "global.color"));
+
+    CHECK_FALSE(Scene::functionUsesGlobal("function() { return global.colors; }", "global.color"));
+    CHECK_FALSE(Scene::functionUsesGlobal("function() { return global.style.width; }", "global.style.color"));
+    CHECK_FALSE(Scene::functionUsesGlobal("function() { return feature.global; }", "global.color"));
+    CHECK_FALSE(Scene::functionUsesGlobal("function() { return myglobal.color; }", "global.color"));
+    CHECK_FALSE(Scene::functionUsesGlobal("function() { return feature.kind; }", "global.color"));
+}
+
+TEST_CASE("Only sources of layers using updated globals are rebuilt") {
+    Node config = YAML::Load(R"END(
+layers:
+    roads:
+        data: { source: osm }
+        filter: { any: [{ kind: highway }, function() { return global.show_minor; }] }
+        draw: { lines: { color: red, width: 2 } }
+    water:
+        data: { source: water }
+        draw: { polygons: { color: function() { return global.water_color; } } }
+        labels:
+            filter: { name: true }
+            draw: { text: { font: { fill: function() { return global.label_color; } } } }
+    buildings:
+        data: { source: buildings }
+        draw: { polygons: { color: gray } }
+)END");
+    SceneFunctions functions;
+    SceneStops stops;
+    DrawRuleNames names;
+    auto layers = SceneLoader::applyLayers(config["layers"], functions, stops, names);
+    REQUIRE(layers.size() == 3);
+    REQUIRE(functions.size() == 3);
+
+    CHECK(Scene::sourcesUsingGlobals(layers, functions, {"global.show_minor"}) == std::set<std::string>{"osm"});
+    CHECK(Scene::sourcesUsingGlobals(layers, functions, {"global.label_color"}) == std::set<std::string>{"water"});
+    CHECK(Scene::sourcesUsingGlobals(layers, functions, {"global.show_minor", "global.water_color"}) ==
+          std::set<std::string>{"osm", "water"});
+    CHECK(Scene::sourcesUsingGlobals(layers, functions, {"global.unused"}).empty());
+    CHECK(Scene::sourcesUsingGlobals(layers, functions, {"global"}) == std::set<std::string>{"osm", "water"});
+
+    // functions outside of data layers may apply to any tile
+    functions.push_back("function() { return global.unused; }");
+    CHECK(Scene::sourcesUsingGlobals(layers, functions, {"global.unused"}) ==
+          std::set<std::string>{"buildings", "osm", "water"});
+}
@@ -0,0 +1,93 @@
+#include "catch.hpp"
+
+#include "util/terrainDepthRasterizer.h"
+
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <functional>
+#include <vector>
+
+using namespace Tangram;
+
+static TerrainDepthRasterizer::TileGrid makeGrid(const glm::mat4& _view, int _res,
+                                                 std::function<float(float, float)> _height) {
+    TerrainDepthRasterizer::TileGrid grid;
+    grid.modelView = _view;
+    grid.resolution = _res;
+    for (int row = 0; row <= _res; row++) {
+        for (int col = 0; col <= _res; col++) {
+            grid.heights.push_back(_height(col/float(_res), row/float(_res)));
+        }
+    }
+    return grid;
+}
+
+TEST_CASE("TerrainDepthRasterizer keeps nearest terrain", "[TerrainDepthRasterizer]") {
+    // looking straight down on unit tile from 2 units up; 90 deg fov covers 3 units at tile height 0.5
+    glm::mat4 view = glm::lookAt(glm::vec3(0.5f, 0.5f, 2.0f), glm::vec3(0.5f, 0.5f, 0.0f), glm::vec3(0, 1, 0));
+    glm::mat4 proj = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f);
+
+    std::vector<TerrainDepthRasterizer::TileGrid> tiles;
+    tiles.push_back(makeGrid(view, 8, [](float, float) { return 0.5f; }));
+
+    TerrainDepthRasterizer rasterizer;
+    std::vector<float> depth;
+    rasterizer.rasterize(depth, 60, 60, proj, tiles);
+    REQUIRE(depth.size() == 60*60);
+    CHECK(depth[30*60 + 30] == Approx(1.5f));
+    CHECK(depth[0] == 0);
+    CHECK(depth[60*60 - 1] == 0);
+
+    // higher tile drawn later or earlier is in front
+    tiles.push_back(makeGrid(view, 4, [](float, float) { return 1.0f; }));
+    rasterizer.rasterize(depth, 60, 60, proj, tiles);
+    CHECK(depth[30*60 + 30] == Approx(1.0f));
+    std::swap(tiles[0], tiles[1]);
+    rasterizer.rasterize(depth, 60, 60, proj, tiles);
+    CHECK(depth[30*60 + 30] == Approx(1.0f));
+
+    // empty grid is skipped
+    tiles.push_back(TerrainDepthRasterizer::TileGrid());
+    rasterizer.rasterize(depth, 60, 60, proj, tiles);
+    CHECK(depth[30*60 + 30] == Approx(1.0f));
+}
+
+TEST_CASE("TerrainDepthRasterizer matches ray cast depth", "[TerrainDepthRasterizer]") {
+    // low pitched camera above the tile, so some triangles are clipped by near plane
+    glm::vec3 eye(0.5f, 0.1f, 0.2f);
+    glm::mat4 view = glm::lookAt(eye, glm::vec3(0.5f, 1.0f, 0.0f), glm::vec3(0, 0, 1));
+    glm::mat4 proj = glm::perspective(glm::radians(60.0f), 1.5f, 0.05f, 100.0f);
+    auto height = [](float x, float y) { return 0.1f*x - 0.05f*y; };  // planar, so grid is exact
+
+    std::vector<TerrainDepthRasterizer::TileGrid> tiles;
+    tiles.push_back(makeGrid(view, 16, height));
+
+    int w = 90, h = 60;
+    TerrainDepthRasterizer rasterizer;
+    std::vector<float> depth;
+    rasterizer.rasterize(depth, w, h, proj, tiles);
+
+    glm::mat4 invViewProj = glm::inverse(proj * view);
+    int covered = 0;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            glm::vec4 ndc(2*(x + 0.5f)/w - 1, 2*(y + 0.5f)/h - 1, -1, 1);
+            glm::vec4 p0 = invViewProj * ndc;
+            ndc.z = 1;
+            glm::vec4 p1 = invViewProj * ndc;
+            p0 = p0 / p0.w;
+            p1 = p1 / p1.w;
+            // intersect ray with plane z = 0.1x - 0.05y
+            glm::vec4 d = p1 - p0;
+            float t = (0.1f*p0.x - 0.05f*p0.y - p0.z)/(d.z - 0.1f*d.x + 0.05f*d.y);
+            glm::vec4 hit = p0 + t*d;
+            float expected = -(view * glm::vec4(hit.x, hit.y, hit.z, 1)).z;
+            float actual = depth[y*w + x];
+            // skip pixels close to tile edges
+            if (t < 0 || t > 1 || hit.x < 0.02f || hit.x > 0.98f || hit.y < 0.02f || hit.y > 0.98f) { continue; }
+            covered++;
+            CHECK(actual == Approx(expected).epsilon(1e-3));
+        }
+    }
+    CHECK(covered > w*h/4);
+}
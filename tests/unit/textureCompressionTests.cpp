@@ -0,0 +1,173 @@
+#include "catch.hpp"
+
+#include "data/memoryCacheDataSource.h"
+#include "gl/texture.h"
+#include "tile/tileTask.h"
+#include "util/textureCompression.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Tangram;
+
+// shaded relief like test image: smooth gradients with some fine detail
+static std::vector<uint8_t> testImage(int _width, int _height) {
+    std::vector<uint8_t> rgba(_width*_height*4, 255);
+    for (int y = 0; y < _height; y++) {
+        for (int x = 0; x < _width; x++) {
+            float shade = 0.5f + 0.3f*std::sin(0.11f*x)*std::cos(0.07f*y) + 0.1f*std::sin(0.9f*(x + y));
+            uint8_t* p = &rgba[4*(y*_width + x)];
+            p[0] = uint8_t(std::min(255.f, 255*shade));
+            p[1] = uint8_t(std::min(255.f, 230*shade + 20*float(y)/_height));
+            p[2] = uint8_t(std::min(255.f, 200*shade + 40*float(x)/_width));
+        }
+    }
+    return rgba;
+}
+
+static double psnr(const std::vector<uint8_t>& _a, const std::vector<uint8_t>& _b) {
+    double sse = 0;
+    size_t n = 0;
+    for (size_t i = 0; i < _a.size(); i++) {
+        if (i % 4 == 3) { continue; }
+        double d = double(_a[i]) - _b[i];
+        sse += d*d;
+        n++;
+    }
+    return sse > 0 ? 10*std::log10(255.0*255.0*n/sse) : 100;
+}
+
+static std::vector<uint8_t> roundTrip(PixelFormat _format, const std::vector<uint8_t>& _rgba, int _width, int _height) {
+    TextureOptions options;
+    options.pixelFormat = _format;
+    std::vector<uint8_t> blocks(options.imageSize(_width, _height));
+    REQUIRE(TextureCompression::compress(_format, _rgba.data(), _width, _height, blocks.data()));
+    std::vector<uint8_t> result(_rgba.size(), 0);
+    TextureCompression::decompress(_format, blocks.data(), _width, _height, result.data());
+    return result;
+}
+
+TEST_CASE("Compressed texture sizes", "[TextureCompression]") {
+    TextureOptions options;
+    REQUIRE(options.imageSize(512, 512) == 512*512*4);
+    options.pixelFormat = PixelFormat::BC1_RGB;
+    REQUIRE(options.isCompressed());
+    REQUIRE(options.imageSize(512, 512) == 512*512/2);
+    // partial blocks are padded
+    options.pixelFormat = PixelFormat::ETC2_RGB;
+    REQUIRE(options.imageSize(5, 3) == 2*1*8);
+}
+
+TEST_CASE("Block compression round trip quality", "[TextureCompression]") {
+    for (auto format : {PixelFormat::BC1_RGB, PixelFormat::ETC2_RGB}) {
+        // odd size to cover edge blocks
+        int w = 131, h = 70;
+        auto rgba = testImage(w, h);
+        auto result = roundTrip(format, rgba, w, h);
+        REQUIRE(psnr(rgba, result) > 32);
+        for (size_t i = 3; i < result.size(); i += 4) { REQUIRE(result[i] == 255); }
+    }
+}
+
+TEST_CASE("Block compression of solid colors", "[TextureCompression]") {
+    for (auto format : {PixelFormat::BC1_RGB, PixelFormat::ETC2_RGB}) {
+        for (uint32_t color : {0x000000u, 0xFFFFFFu, 0x3C7A1Eu, 0xA0B0C0u}) {
+            std::vector<uint8_t> rgba(8*8*4, 255);
+            for (size_t i = 0; i < rgba.size(); i += 4) {
+                rgba[i] = color >> 16; rgba[i+1] = (color >> 8) & 0xFF; rgba[i+2] = color & 0xFF;
+            }
+            auto result = roundTrip(format, rgba, 8, 8);
+            for (size_t i = 0; i < rgba.size(); i++) {
+                REQUIRE(std::abs(int(rgba[i]) - int(result[i])) <= 8);
+            }
+        }
+    }
+}
+
+TEST_CASE("Images with transparency are not compressed", "[TextureCompression]") {
+    auto rgba = testImage(16, 16);
+    rgba[4*(9*16 + 3) + 3] = 128;
+    std::vector<uint8_t> blocks(16*16/2);
+    REQUIRE(!TextureCompression::compress(PixelFormat::BC1_RGB, rgba.data(), 16, 16, blocks.data()));
+    REQUIRE(TextureCompression::encode(PixelFormat::ETC2_RGB, rgba.data(), 16, 16).empty());
+}
+
+TEST_CASE("Compressed raster cache data and texture", "[TextureCompression]") {
+    int w = 256, h = 256;
+    auto rgba = testImage(w, h);
+    auto data = TextureCompression::encode(PixelFormat::ETC2_RGB, rgba.data(), w, h);
+    REQUIRE(data.size() == sizeof(TextureCompression::Header) + size_t(w*h/2));
+
+    TextureCompression::Header header;
+    const uint8_t* blocks = TextureCompression::parse(data, header);
+    REQUIRE(blocks != nullptr);
+    REQUIRE(header.width == 256);
+    REQUIRE(PixelFormat(header.format) == PixelFormat::ETC2_RGB);
+
+    // truncated data or raw image data is rejected
+    std::vector<char> truncated(data.begin(), data.end() - 1);
+    REQUIRE(TextureCompression::parse(truncated, header) == nullptr);
+    std::vector<char> png = {'\x89', 'P', 'N', 'G', '\r', '\n', 0x1A, '\n', 0, 0, 0, 0, 0, 0, 0, 0};
+    REQUIRE(TextureCompression::parse(png, header) == nullptr);
+
+    TextureOptions options;
+    options.generateMipmaps = true;
+    options.minFilter = TextureMinFilter::LINEAR_MIPMAP_LINEAR;
+    Texture texture(options);
+    REQUIRE(texture.setCompressedData(PixelFormat::ETC2_RGB, w, h, blocks, w*h/2));
+    REQUIRE(texture.bufferSize() == size_t(w*h/2));
+    REQUIRE(texture.pendingUploadSize() == size_t(w*h/2));
+    // 1/8 of RGBA8
+    REQUIRE(texture.memoryUsage() == size_t(w*h*4/8));
+    REQUIRE(!texture.getOptions().generateMipmaps);
+    REQUIRE(texture.getOptions().minFilter == TextureMinFilter::LINEAR);
+
+    REQUIRE(!texture.setCompressedData(PixelFormat::ETC2_RGB, w, h, blocks, w*h/2 - 8));
+    REQUIRE(!texture.setCompressedData(PixelFormat::RGBA, w, h, blocks, w*h/2));
+}
+
+// serves fixed raw data, standing in for network source behind memory cache
+struct FixedDataSource : TileSource::DataSource {
+    std::shared_ptr<std::vector<char>> data;
+    bool loadTileData(std::shared_ptr<TileTask> _task, TileTaskCb _cb) override {
+        static_cast<BinaryTileTask&>(*_task).rawTileData = data;
+        _cb.func(_task);
+        return true;
+    }
+};
+
+TEST_CASE("Compressed raster data is kept beside raw data in memory cache", "[TextureCompression]") {
+    TileID tileId(1, 2, 3);
+    auto raw = std::make_shared<std::vector<char>>(4096, 'r');
+    auto compressed = std::make_shared<std::vector<char>>(512, 'c');
+
+    MemoryCacheDataSource cache;
+    cache.setCacheSize(1 << 20);
+    auto network = std::make_unique<FixedDataSource>();
+    network->data = raw;
+    cache.setNext(std::move(network));
+
+    auto load = [&]() {
+        auto task = std::make_shared<BinaryTileTask>(tileId, nullptr);
+        // goes to next source on cache miss
+        cache.loadTileData(task, {[](std::shared_ptr<TileTask>) {}});
+        return task->rawTileData;
+    };
+
+    REQUIRE(load() == raw);
+    REQUIRE(cache.getProcessedData(tileId, *raw) == nullptr);
+    cache.cacheProcessedData(tileId, *raw, compressed);
+    REQUIRE(cache.getProcessedData(tileId, *raw) == compressed);
+
+    // other consumers of the tile still get the original data
+    REQUIRE(load() == raw);
+
+    // not returned for other data for the tile (e.g. refetched)
+    std::vector<char> other(*raw);
+    REQUIRE(cache.getProcessedData(tileId, other) == nullptr);
+    cache.cacheProcessedData(tileId, other, compressed);
+    REQUIRE(cache.getProcessedData(tileId, *raw) == compressed);
+
+    cache.clear();
+    REQUIRE(cache.getProcessedData(tileId, *raw) == nullptr);
+}
@@ -0,0 +1,111 @@
+#include "catch.hpp"
+
+#include "data/tileData.h"
+#include "tile/tileDataCache.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Tangram;
+
+static std::shared_ptr<TileData> makeTileData(size_t _numPoints) {
+    auto tileData = std::make_shared<TileData>();
+    tileData->layers.emplace_back("layer");
+    Feature feature;
+    feature.geometryType = GeometryType::lines;
+    feature.lines.emplace_back(_numPoints, Point(1, 2));
+    feature.props.set("kind", std::string("highway"));
+    tileData->layers.back().features.push_back(std::move(feature));
+    return tileData;
+}
+
+TEST_CASE("TileDataCache returns data only for same raw data", "[TileDataCache]") {
+    TileDataCache cache(1024*1024);
+
+    std::vector<char> raw = {'a', 'b', 'c'}, other = {'a', 'b', 'd'};
+    uint64_t hash = TileDataCache::dataHash(raw);
+    REQUIRE(hash != TileDataCache::dataHash(other));
+
+    auto tileData = makeTileData(10);
+    cache.put(1, TileID(1, 2, 3), hash, tileData);
+
+    CHECK(cache.get(1, TileID(1, 2, 3), hash) == tileData);
+    CHECK(cache.get(1, TileID(1, 2, 3), TileDataCache::dataHash(other)) == nullptr);
+    CHECK(cache.get(2, TileID(1, 2, 3), hash) == nullptr);
+    CHECK(cache.get(1, TileID(2, 2, 3), hash) == nullptr);
+
+    auto stats = cache.stats();
+    CHECK(stats.entries == 1);
+    CHECK(stats.hits == 1);
+    CHECK(stats.misses == 3);
+    CHECK(stats.bytes == TileDataCache::memoryUsage(*tileData));
+
+    cache.clear();
+    CHECK(cache.get(1, TileID(1, 2, 3), hash) == nullptr);
+    CHECK(cache.stats().bytes == 0);
+}
+
+TEST_CASE("TileDataCache evicts least recently used data", "[TileDataCache]") {
+    auto tileData = makeTileData(1000);
+    size_t bytes = TileDataCache::memoryUsage(*tileData);
+    CHECK(bytes >= 1000 * sizeof(Point));
+
+    TileDataCache cache(3 * bytes);
+    for (int x = 0; x < 3; x++) {
+        cache.put(0, TileID(x, 0, 2), 0, makeTileData(1000));
+    }
+    // touch first entry so second one is evicted
+    CHECK(cache.get(0, TileID(0, 0, 2), 0) != nullptr);
+    cache.put(0, TileID(3, 0, 2), 0, makeTileData(1000));
+
+    CHECK(cache.get(0, TileID(1, 0, 2), 0) == nullptr);
+    CHECK(cache.get(0, TileID(0, 0, 2), 0) != nullptr);
+    CHECK(cache.get(0, TileID(3, 0, 2), 0) != nullptr);
+    CHECK(cache.stats().evictions == 1);
+    CHECK(cache.stats().bytes <= 3 * bytes);
+
+    cache.setMaxBytes(bytes);
+    CHECK(cache.stats().entries == 1);
+    CHECK(cache.get(0, TileID(3, 0, 2), 0) != nullptr);
+}
+
+TEST_CASE("TileDataCache returns latest data for source generation", "[TileDataCache]") {
+    TileDataCache cache(1024*1024);
+    auto tileData = makeTileData(10);
+    cache.put(1, TileID(1, 2, 3), 42, tileData, 5);
+
+    CHECK(cache.getLatest(1, TileID(1, 2, 3), 5) == tileData);
+    CHECK(cache.getLatest(1, TileID(1, 2, 3), 6) == nullptr);
+    CHECK(cache.getLatest(1, TileID(1, 2, 4), 5) == nullptr);
+    CHECK(cache.stats().latestHits == 1);
+    CHECK(cache.stats().misses == 0);
+}
+
+TEST_CASE("TileDataCache parses same data once", "[TileDataCache]") {
+    TileDataCache cache(1024*1024);
+    std::atomic<int> parses(0);
+    auto parse = [&]() {
+        parses++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return makeTileData(10);
+    };
+
+    std::shared_ptr<TileData> results[4];
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&, i]() { results[i] = cache.getOrParse(0, TileID(1, 1, 14), 7, 0, parse); });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    CHECK(parses == 1);
+    for (auto& result : results) { CHECK(result == results[0]); }
+    CHECK(cache.getOrParse(0, TileID(1, 1, 14), 7, 0, parse) == results[0]);
+    CHECK(parses == 1);
+
+    // different raw data is parsed again
+    CHECK(cache.getOrParse(0, TileID(1, 1, 14), 8, 0, parse) != results[0]);
+    CHECK(parses == 2);
+}
@@ -0,0 +1,75 @@
+#include "catch.hpp"
+
+#include "debug/trace.h"
+#include "tile/tileID.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Tangram;
+
+static size_t count(const std::string& _str, const std::string& _sub) {
+    size_t n = 0;
+    for (size_t pos = _str.find(_sub); pos != std::string::npos; pos = _str.find(_sub, pos + 1)) { n++; }
+    return n;
+}
+
+TEST_CASE("Trace records nothing while disabled", "[Trace]") {
+    Trace::setEnabled(true);
+    Trace::setEnabled(false);
+    {
+        TRACE_SCOPE("disabled scope");
+        TRACE_COUNTER("disabled counter", 1);
+    }
+    REQUIRE(Trace::exportJson().find("disabled") == std::string::npos);
+}
+
+TEST_CASE("Trace exports scopes, counters and tile events as Chrome trace JSON", "[Trace]") {
+    Trace::setEnabled(true);
+    Trace::setThreadName("test main");
+    {
+        TRACE_SCOPE_TILE("build", TileID(1, 2, 3));
+        TRACE_COUNTER("queued", 5);
+    }
+    TRACE_ASYNC_BEGIN("fetch", 42, TileID(1, 2, 3));
+    TRACE_ASYNC_END("fetch", 42, TileID(1, 2, 3));
+    Trace::setEnabled(false);
+
+    std::string json = Trace::exportJson();
+    REQUIRE(json.compare(0, 1, "{") == 0);
+    REQUIRE(json.back() == '}');
+    REQUIRE(count(json, "\"name\":\"build\",\"ph\":\"B\"") == 1);
+    REQUIRE(count(json, "\"name\":\"build\",\"ph\":\"E\"") == 1);
+    REQUIRE(count(json, "\"tile\":\"3/1/2/3\"") == 3);
+    REQUIRE(count(json, "\"args\":{\"value\":5}") == 1);
+    REQUIRE(count(json, "\"id\":\"0x2a\"") == 2);
+    REQUIRE(count(json, "\"args\":{\"name\":\"test main\"}") == 1);
+
+    // enabling again discards old events
+    Trace::setEnabled(true);
+    Trace::setEnabled(false);
+    REQUIRE(Trace::exportJson().find("build") == std::string::npos);
+}
+
+TEST_CASE("Trace records events from multiple threads and keeps the newest on overflow", "[Trace]") {
+    const int numThreads = 4, numEvents = 50000;
+    Trace::setEnabled(true);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < numEvents; i++) { TRACE_SCOPE("work"); }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+    Trace::setEnabled(false);
+
+    std::string json = Trace::exportJson();
+    size_t begins = count(json, "\"name\":\"work\",\"ph\":\"B\"");
+    size_t ends = count(json, "\"name\":\"work\",\"ph\":\"E\"");
+    REQUIRE(begins > 0);
+    REQUIRE(begins < size_t(numThreads * numEvents));
+    REQUIRE(begins == ends);
+    Trace::clear();
+}
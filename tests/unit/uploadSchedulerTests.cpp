@@ -0,0 +1,117 @@
+#include "catch.hpp"
+
+#include "gl/mesh.h"
+#include "gl/renderState.h"
+#include "gl/uploadScheduler.h"
+#include "style/polygonStyle.h"
+#include "tile/tile.h"
+
+#include <vector>
+
+namespace Tangram { extern size_t glMockUploadBytes; }
+
+using namespace Tangram;
+
+struct UploadVertex {
+    float x, y, z;
+    uint32_t color;
+};
+
+static std::shared_ptr<VertexLayout> uploadLayout = std::shared_ptr<VertexLayout>(new VertexLayout({
+    {"a_position", 3, GL_FLOAT, false, 0},
+    {"a_color", 4, GL_UNSIGNED_BYTE, true, 0},
+}));
+
+static std::shared_ptr<Tile> newTile(const Style& _style, int _x, size_t _nVertices) {
+    auto tile = std::make_shared<Tile>(TileID(_x, 0, 10));
+    auto mesh = std::make_unique<Mesh<UploadVertex>>(uploadLayout, GL_TRIANGLES);
+    MeshData<UploadVertex> meshData;
+    meshData.vertices.resize(_nVertices);
+    meshData.indices.resize(_nVertices);
+    meshData.offsets.emplace_back(_nVertices, _nVertices);
+    mesh->compile(meshData);
+    tile->setMesh(_style, std::move(mesh));
+    return tile;
+}
+
+TEST_CASE("UploadScheduler limits bytes uploaded per frame", "[Core][UploadScheduler]") {
+    RenderState rs;
+    PolygonStyle style("polygons");
+
+    const size_t tileBytes = 1000 * (sizeof(UploadVertex) + sizeof(GLushort));
+    std::vector<std::shared_ptr<Tile>> tiles;
+    for (int i = 0; i < 10; i++) {
+        tiles.push_back(newTile(style, i, 1000));
+        REQUIRE(tiles.back()->pendingUploadSize() == tileBytes);
+        REQUIRE(!tiles.back()->isUploaded());
+    }
+
+    rs.uploads.setFrameBudget(3*tileBytes + tileBytes/2);
+
+    int frames = 0;
+    size_t uploaded = 0;
+    while (uploaded < tiles.size()) {
+        // TileManager requeues all tiles still waiting every frame
+        rs.uploads.beginFrame();
+        for (auto& tile : tiles) {
+            if (!tile->isUploaded()) { rs.uploads.enqueue(tile, 1.f); }
+        }
+        glMockUploadBytes = 0;
+        uploaded += rs.uploads.process(rs);
+        frames++;
+
+        REQUIRE(glMockUploadBytes == rs.uploads.frameBytes());
+        REQUIRE(glMockUploadBytes <= rs.uploads.frameBudget());
+        REQUIRE(rs.uploads.queuedTiles() == 0);
+    }
+
+    REQUIRE(frames == 4);
+    for (auto& tile : tiles) {
+        REQUIRE(tile->isUploaded());
+        REQUIRE(tile->pendingUploadSize() == 0);
+    }
+}
+
+TEST_CASE("UploadScheduler uploads largest screen area first", "[Core][UploadScheduler]") {
+    RenderState rs;
+    PolygonStyle style("polygons");
+
+    auto small = newTile(style, 0, 100);
+    auto large = newTile(style, 1, 100);
+    auto medium = newTile(style, 2, 100);
+
+    rs.uploads.setFrameBudget(1);
+    rs.uploads.enqueue(small, 10.f);
+    rs.uploads.enqueue(large, 1000.f);
+    rs.uploads.enqueue(medium, 100.f);
+
+    // at least one tile is uploaded each frame, even if larger than the budget
+    rs.uploads.beginFrame();
+    REQUIRE(rs.uploads.process(rs) == 1);
+    REQUIRE(large->isUploaded());
+    REQUIRE(!medium->isUploaded());
+    REQUIRE(!small->isUploaded());
+    REQUIRE(rs.uploads.frameBytes() > rs.uploads.frameBudget());
+
+    rs.uploads.beginFrame();
+    REQUIRE(rs.uploads.maxFrameBytes() == large->getMemoryUsage());
+    rs.uploads.enqueue(small, 10.f);
+    rs.uploads.enqueue(medium, 100.f);
+    REQUIRE(rs.uploads.process(rs) == 1);
+    REQUIRE(medium->isUploaded());
+    REQUIRE(!small->isUploaded());
+}
+
+TEST_CASE("UploadScheduler skips released tiles", "[Core][UploadScheduler]") {
+    RenderState rs;
+    PolygonStyle style("polygons");
+
+    auto tile = newTile(style, 0, 100);
+    rs.uploads.setFrameBudget(1 << 20);
+    rs.uploads.enqueue(newTile(style, 1, 100), 1000.f);
+    rs.uploads.enqueue(tile, 1.f);
+
+    rs.uploads.beginFrame();
+    REQUIRE(rs.uploads.process(rs) == 1);
+    REQUIRE(tile->isUploaded());
+}
@@ -0,0 +1,215 @@
+#include "catch.hpp"
+
+#include "urlClient.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Tangram;
+
+// Local HTTP/1.1 server with injected latency: requests are served one at a time, each taking serviceMs,
+//  like a saturated link or server; so time to first byte grows with the number of concurrent requests
+class LatencyServer {
+public:
+    LatencyServer(int _serviceMs, size_t _bodySize = 1024) : m_serviceMs(_serviceMs), m_body(_bodySize, 'x') {
+        m_listenFd = socket(AF_INET, SOCK_STREAM, 0);
+        int yes = 1;
+        setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(m_listenFd, (sockaddr*)&addr, sizeof(addr));
+        listen(m_listenFd, 64);
+        socklen_t len = sizeof(addr);
+        getsockname(m_listenFd, (sockaddr*)&addr, &len);
+        m_port = ntohs(addr.sin_port);
+        m_acceptThread = std::thread([this]() { acceptLoop(); });
+    }
+
+    ~LatencyServer() {
+        m_running = false;
+        shutdown(m_listenFd, SHUT_RDWR);
+        close(m_listenFd);
+        m_acceptThread.join();
+        std::lock_guard<std::mutex> lock(m_connMutex);
+        for (int fd : m_connFds) { shutdown(fd, SHUT_RDWR); }
+        for (auto& t : m_connThreads) { t.join(); }
+    }
+
+    std::string url(const std::string& _path) const {
+        return "http://127.0.0.1:" + std::to_string(m_port) + "/" + _path;
+    }
+
+    // paths in the order they were served
+    std::vector<std::string> served() {
+        std::lock_guard<std::mutex> lock(m_serviceMutex);
+        return m_served;
+    }
+
+    int received() const { return m_received; }
+
+private:
+    void acceptLoop() {
+        while (m_running) {
+            int fd = accept(m_listenFd, nullptr, nullptr);
+            if (fd < 0) { break; }
+            std::lock_guard<std::mutex> lock(m_connMutex);
+            m_connFds.push_back(fd);
+            m_connThreads.emplace_back([this, fd]() { serve(fd); });
+        }
+    }
+
+    void serve(int _fd) {
+        std::string buffer;
+        char chunk[4096];
+        while (true) {
+            size_t end;
+            while ((end = buffer.find("\r\n\r\n")) == std::string::npos) {
+                ssize_t n = recv(_fd, chunk, sizeof(chunk), 0);
+                if (n <= 0) { close(_fd); return; }
+                buffer.append(chunk, n);
+            }
+            size_t pathStart = buffer.find(' ') + 2;
+            std::string path = buffer.substr(pathStart, buffer.find(' ', pathStart) - pathStart);
+            buffer.erase(0, end + 4);
+            m_received++;
+            {
+                std::lock_guard<std::mutex> lock(m_serviceMutex);
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_serviceMs));
+                m_served.push_back(path);
+            }
+            std::string response = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(m_body.size()) +
+                                   "\r\nConnection: keep-alive\r\n\r\n" + m_body;
+            send(_fd, response.data(), response.size(), MSG_NOSIGNAL);
+        }
+    }
+
+    int m_serviceMs;
+    std::string m_body;
+    int m_listenFd = -1;
+    int m_port = 0;
+    std::atomic<bool> m_running{true};
+    std::thread m_acceptThread;
+    std::mutex m_connMutex;
+    std::vector<int> m_connFds;
+    std::vector<std::thread> m_connThreads;
+    std::atomic<int> m_received{0};
+    std::mutex m_serviceMutex;
+    std::vector<std::string> m_served;
+};
+
+struct Completion {
+    std::mutex mutex;
+    std::condition_variable cv;
+    int done = 0;
+    int failed = 0;
+
+    UrlCallback callback() {
+        return [this](UrlResponse&& response) {
+            std::lock_guard<std::mutex> lock(mutex);
+            done++;
+            if (response.error) { failed++; }
+            cv.notify_all();
+        };
+    }
+
+    bool wait(int _count, int _timeoutSec = 20) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(_timeoutSec), [&]() { return done >= _count; });
+    }
+};
+
+static HttpOptions withPriority(double _priority) {
+    HttpOptions options;
+    options.priority = [_priority]() { return _priority; };
+    return options;
+}
+
+TEST_CASE("Pending requests are dispatched in priority order", "[UrlClient]") {
+    LatencyServer server(50);
+    UrlClient::Options options;
+    options.maxActiveTasks = 1;
+    UrlClient client(options);
+    Completion completion;
+
+    // occupies the only slot while the others are queued
+    client.addRequest(server.url("first"), HttpOptions(), completion.callback());
+    while (server.received() == 0) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+
+    // expired or canceled tasks report infinite priority (see NetworkDataSource) and go last
+    client.addRequest(server.url("canceled"), withPriority(std::numeric_limits<double>::infinity()),
+                      completion.callback());
+    client.addRequest(server.url("none"), HttpOptions(), completion.callback());
+    client.addRequest(server.url("p5"), withPriority(5), completion.callback());
+    client.addRequest(server.url("p1"), withPriority(1), completion.callback());
+    // priority is queried without holding the client's lock, so it may call back into the client
+    HttpOptions reentrant;
+    reentrant.priority = [&client]() { return client.getHostStats().empty() ? 0 : 3.0; };
+    client.addRequest(server.url("p3"), reentrant, completion.callback());
+
+    REQUIRE(completion.wait(6));
+    REQUIRE(completion.failed == 0);
+    // FIFO among equal (infinite) priority
+    REQUIRE(server.served() == std::vector<std::string>{"first", "p1", "p3", "p5", "canceled", "none"});
+}
+
+TEST_CASE("Per-host concurrency limit backs off under injected latency", "[UrlClient]") {
+    const int numRequests = 300;
+    LatencyServer server(4);
+    UrlClient::Options options;
+    options.maxActiveTasks = 32;
+    options.maxHostConnections = 16;
+    options.maxHostTasks = 16;
+    UrlClient client(options);
+    Completion completion;
+
+    for (int i = 0; i < numRequests; i++) {
+        client.addRequest(server.url(std::to_string(i)), HttpOptions(), completion.callback());
+    }
+    REQUIRE(completion.wait(numRequests));
+    REQUIRE(completion.failed == 0);
+
+    auto hostStats = client.getHostStats();
+    REQUIRE(hostStats.size() == 1);
+    auto& stats = hostStats.begin()->second;
+    REQUIRE(stats.completed == uint64_t(numRequests));
+    REQUIRE(stats.pending == 0);
+    REQUIRE(stats.active == 0);
+    REQUIRE(!stats.multiplexed);
+    REQUIRE(stats.minRttMs > 0);
+    REQUIRE(stats.rttMs >= stats.minRttMs);
+    REQUIRE(stats.bytesPerSec > 0);
+    // more concurrency than the server can serve only adds queuing delay, so limit drops from its start at 16
+    REQUIRE(stats.limit < 12);
+    REQUIRE(stats.limit >= float(options.minHostTasks));
+}
+
+TEST_CASE("Fixed per-host concurrency without adaptive limit", "[UrlClient]") {
+    LatencyServer server(4);
+    UrlClient::Options options;
+    options.adaptiveConcurrency = false;
+    options.maxHostTasks = 8;
+    UrlClient client(options);
+    Completion completion;
+
+    for (int i = 0; i < 100; i++) {
+        client.addRequest(server.url(std::to_string(i)), HttpOptions(), completion.callback());
+    }
+    REQUIRE(completion.wait(100));
+
+    auto stats = client.getHostStats().begin()->second;
+    REQUIRE(stats.completed == 100);
+    REQUIRE(stats.limit == 8);
+}